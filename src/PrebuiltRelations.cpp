@@ -0,0 +1,27 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file PrebuiltRelations.cpp
+ *
+ * The souffle-relations library: instantiations of the relation data
+ * structures declared in souffle/PrebuiltRelations.h.
+ *
+ ***********************************************************************/
+
+#include "souffle/PrebuiltRelations.h"
+
+namespace souffle {
+
+#define SOUFFLE_DEFINE_INDEX(kind, arity, ...) SOUFFLE_PREBUILT_INDEX(, kind, arity, __VA_ARGS__)
+SOUFFLE_FOR_EACH_PREBUILT_INDEX(SOUFFLE_DEFINE_INDEX)
+SOUFFLE_PREBUILT_STRUCTURES()
+#undef SOUFFLE_DEFINE_INDEX
+
+}  // namespace souffle
@@ -18,9 +18,12 @@
 
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
+#include "reports/TransformerProfile.h"
 #include "souffle/utility/DynamicCasting.h"
 #include "souffle/utility/Types.h"
 #include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -72,6 +75,20 @@ struct TranslationUnitBase {
         virtual void run(Impl const&) = 0;
     };
 
+    /** Number of analyses computed and preserved, and the time spent computing them */
+    struct AnalysisStatistics {
+        /** Number of computations of an analysis, and their time including the analyses they requested */
+        struct Computations {
+            std::size_t count = 0;
+            std::chrono::duration<double> time{0};
+        };
+
+        std::size_t computed = 0;
+        std::size_t preserved = 0;
+        std::chrono::duration<double> time{0};
+        std::map<std::string, Computations> byAnalysis;
+    };
+
     TranslationUnitBase(Own<Program> prog, ErrorReport& e, DebugReport& d)
             : program(std::move(prog)), errorReport(e), debugReport(d) {
         assert(program != nullptr && "program is a null-pointer");
@@ -88,7 +105,19 @@ struct TranslationUnitBase {
 
             auto& analysis = *it->second;
             assert(analysis.getName() == A::name && "must be same pointer");
+            // analyses request the analyses they depend on, only time the outermost one
+            auto start = std::chrono::high_resolution_clock::now();
+            ++analysisDepth;
             analysis.run(static_cast<Impl const&>(*this));
+            --analysisDepth;
+            ++statistics.computed;
+            const std::chrono::duration<double> time = std::chrono::high_resolution_clock::now() - start;
+            if (analysisDepth == 0) {
+                statistics.time += time;
+            }
+            auto& computations = statistics.byAnalysis[A::name];
+            ++computations.count;
+            computations.time += time;
             logAnalysis(analysis);
         }
 
@@ -109,6 +138,37 @@ struct TranslationUnitBase {
         analyses.clear();
     }
 
+    /**
+     * @brief Invalidate the alive analyses of the translation unit, except the given ones
+     *
+     * A preserved analysis must only refer to analyses that are preserved as well.
+     */
+    void invalidateAnalyses(const std::set<std::string>& preserved) {
+        for (auto it = analyses.begin(); it != analyses.end();) {
+            if (preserved.count(it->first) > 0) {
+                ++statistics.preserved;
+                ++it;
+            } else {
+                it = analyses.erase(it);
+            }
+        }
+    }
+
+    /** @brief Get the statistics of the analyses over the lifetime of the translation unit */
+    const AnalysisStatistics& getAnalysisStatistics() const {
+        return statistics;
+    }
+
+    /** @brief Get the profile of the transformers, or nullptr if they are not profiled */
+    TransformerProfile* getTransformerProfile() const {
+        return transformerProfile;
+    }
+
+    /** @brief Record the transformers applied to the translation unit in the profile */
+    void setTransformerProfile(TransformerProfile* profile) {
+        transformerProfile = profile;
+    }
+
     /** @brief Get the RAM Program of the translation unit  */
     Program& getProgram() const {
         return *program;
@@ -133,6 +193,12 @@ protected:
     //       Using `std::string` appears to suppress the issue (bug?).
     mutable std::map<std::string, Own<Analysis>> analyses;
 
+    mutable AnalysisStatistics statistics;
+    mutable std::size_t analysisDepth = 0;
+
+    /* Profile of the transformers, if they are profiled */
+    TransformerProfile* transformerProfile = nullptr;
+
     /* RAM program */
     Own<Program> program;
 
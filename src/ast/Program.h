@@ -30,6 +30,8 @@
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/Visitor.h"
 #include "souffle/utility/span.h"
+#include <atomic>
+#include <cstdint>
 #include <iosfwd>
 #include <vector>
 
@@ -257,7 +259,8 @@ private:
 #ifndef NDEBUG
     // SANCHECK - used to assert that the set of clauses isn't mutated mid visit
     // (easy extra check b/c `visit` is specialised for `Program` and `Clause`s)
-    mutable uint32_t clause_visit_in_progress = 0;
+    // (atomic as the front end may visit the program from several threads)
+    mutable std::atomic<uint32_t> clause_visit_in_progress{0};
 #endif
 
     template <typename F, typename>
@@ -37,11 +37,34 @@
 #include "souffle/utility/StringUtil.h"
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <functional>
+#include <map>
 #include <memory>
 #include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace souffle::ast::analysis {
 
+namespace {
+
+std::size_t combineHash(std::size_t seed, std::size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+/** Combine a multiset of hashes, independently of their order */
+std::size_t combineHashes(std::size_t seed, std::vector<std::size_t> values) {
+    std::sort(values.begin(), values.end());
+    for (std::size_t value : values) {
+        seed = combineHash(seed, value);
+    }
+    return seed;
+}
+
+}  // namespace
+
 NormalisedClause::NormalisedClause(const Clause* clause) {
     // head
     QualifiedName name("@min:head");
@@ -55,6 +78,8 @@ NormalisedClause::NormalisedClause(const Clause* clause) {
     for (const auto* lit : clause->getBodyLiterals()) {
         addClauseBodyLiteral("@min:scope:0", lit);
     }
+
+    computeFingerprint();
 }
 
 void NormalisedClause::addClauseAtom(
@@ -157,6 +182,56 @@ std::string NormalisedClause::normaliseArgument(const Argument* arg) {
     }
 }
 
+void NormalisedClause::computeFingerprint() {
+    std::hash<std::string> hashString;
+
+    // Constants are identified by their value, and all other parameters (variables and
+    // aggregator scopes) start off indistinguishable
+    std::map<std::string, std::size_t> colours;
+    for (const auto& element : clauseElements) {
+        for (const auto& param : element.params) {
+            colours[param] = contains(constants, param) ? hashString(param) : 0;
+        }
+    }
+
+    auto colourElements = [&]() {
+        std::vector<std::size_t> elementColours;
+        for (const auto& element : clauseElements) {
+            std::size_t colour = hashString(element.name.toString());
+            for (const auto& param : element.params) {
+                colour = combineHash(colour, colours[param]);
+            }
+            elementColours.push_back(colour);
+        }
+        return elementColours;
+    };
+
+    // Refine the colour of each variable by the elements and positions it occurs at, so that
+    // variables are told apart by their neighbourhoods rather than their names
+    for (std::size_t round = 0; round < 2; round++) {
+        const auto elementColours = colourElements();
+        std::map<std::string, std::vector<std::size_t>> occurrences;
+        for (std::size_t i = 0; i < clauseElements.size(); i++) {
+            const auto& params = clauseElements[i].params;
+            for (std::size_t j = 0; j < params.size(); j++) {
+                if (!contains(constants, params[j])) {
+                    occurrences[params[j]].push_back(combineHash(elementColours[i], j));
+                }
+            }
+        }
+        for (auto& [param, positions] : occurrences) {
+            colours[param] = combineHashes(0, std::move(positions));
+        }
+    }
+
+    std::vector<std::size_t> constantHashes;
+    for (const auto& cst : constants) {
+        constantHashes.push_back(hashString(cst));
+    }
+    fingerprint = combineHashes(combineHash(variables.size(), constants.size()), colourElements());
+    fingerprint = combineHashes(fingerprint, std::move(constantHashes));
+}
+
 void ClauseNormalisationAnalysis::run(const TranslationUnit& translationUnit) {
     const auto& program = translationUnit.getProgram();
     for (const auto* clause : program.getClauses()) {
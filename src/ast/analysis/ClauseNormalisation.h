@@ -63,9 +63,18 @@ public:
         return clauseElements;
     }
 
+    /**
+     * Hash of the clause that is invariant under renaming its variables and reordering its
+     * elements, so that bijectively equivalent clauses have the same fingerprint.
+     */
+    std::size_t getFingerprint() const {
+        return fingerprint;
+    }
+
 private:
     bool fullyNormalised{true};
     std::size_t aggrScopeCount{0};
+    std::size_t fingerprint{0};
     std::set<std::string> variables{};
     std::set<std::string> constants{};
     std::vector<NormalisedClauseElement> clauseElements{};
@@ -84,6 +93,11 @@ private:
      * Return a normalised string repr of an argument.
      */
     std::string normaliseArgument(const Argument* arg);
+
+    /**
+     * Compute the fingerprint from the normalised elements.
+     */
+    void computeFingerprint();
 };
 
 class ClauseNormalisationAnalysis : public Analysis {
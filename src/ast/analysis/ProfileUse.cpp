@@ -21,6 +21,9 @@
 #include "souffle/profile/ProgramRun.h"
 #include "souffle/profile/Reader.h"
 #include "souffle/profile/Relation.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <algorithm>
 #include <limits>
 #include <string>
 
@@ -59,4 +62,47 @@ std::size_t ProfileUseAnalysis::getRelationSize(const QualifiedName& rel) const
     }
 }
 
+/**
+ * Check whether distinct values of relation columns are defined in profile
+ */
+bool ProfileUseAnalysis::hasDistinctValues(const QualifiedName& rel) const {
+    const auto* profRel = programRun->getRelation(rel.toString());
+    return profRel != nullptr && !profRel->getDistinctValues().empty();
+}
+
+bool ProfileUseAnalysis::hasDistinctValues(
+        const QualifiedName& rel, const std::set<std::size_t>& columns) const {
+    const auto* profRel = programRun->getRelation(rel.toString());
+    if (profRel == nullptr) {
+        return false;
+    }
+    return std::any_of(profRel->getDistinctValues().begin(), profRel->getDistinctValues().end(),
+            [&](const auto& statistics) {
+                std::set<std::size_t> keyColumns;
+                for (const auto& column : splitString(statistics.first, ',')) {
+                    keyColumns.insert(std::stoul(column));
+                }
+                return keyColumns == columns;
+            });
+}
+
+/**
+ * Get the distinct values of relation columns from profile
+ */
+std::size_t ProfileUseAnalysis::getDistinctValues(
+        const QualifiedName& rel, const std::set<std::size_t>& columns) const {
+    std::size_t distinctValues = 1;
+    if (const auto* profRel = programRun->getRelation(rel.toString())) {
+        for (const auto& [key, count] : profRel->getDistinctValues()) {
+            const auto& keyColumns = splitString(key, ',');
+            bool isSubset = std::all_of(keyColumns.begin(), keyColumns.end(),
+                    [&](const std::string& column) { return contains(columns, std::stoul(column)); });
+            if (isSubset) {
+                distinctValues = std::max(distinctValues, count);
+            }
+        }
+    }
+    return distinctValues;
+}
+
 }  // namespace souffle::ast::analysis
@@ -23,6 +23,7 @@
 #include <cstddef>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 
 namespace souffle::ast {
@@ -53,6 +54,20 @@ public:
     /** Return size of relation in the profile */
     std::size_t getRelationSize(const QualifiedName& rel) const;
 
+    /** Check whether the profile has distinct-value statistics of the relation */
+    bool hasDistinctValues(const QualifiedName& rel) const;
+
+    /** Check whether the profile has distinct-value statistics of exactly the given columns */
+    bool hasDistinctValues(const QualifiedName& rel, const std::set<std::size_t>& columns) const;
+
+    /**
+     * Return the number of distinct values of the given columns of a relation in the profile.
+     *
+     * The largest count of a subset of the columns with statistics is returned, which bounds the count
+     * of the columns from below; the count of no columns is 1.
+     */
+    std::size_t getDistinctValues(const QualifiedName& rel, const std::set<std::size_t>& columns) const;
+
 private:
     /** performance model of profile run */
     std::shared_ptr<profile::ProgramRun> programRun;
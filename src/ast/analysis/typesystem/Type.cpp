@@ -44,6 +44,7 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include <algorithm>
 #include <cassert>
@@ -56,6 +57,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace souffle::ast::analysis {
 
@@ -482,6 +484,10 @@ void TypeAnalysis::run(const TranslationUnit& translationUnit) {
     // Analyse user-defined functor types
     const Program& program = translationUnit.getProgram();
 
+    // The constraints of clauses are solved in parallel, so the analyses they request must be computed
+    translationUnit.getAnalysis<SumTypeBranchesAnalysis>();
+    const std::vector<Clause*> clauses = program.getClauses();
+
     // Rest of the analysis done until fixpoint reached
     bool changed = true;
     while (changed) {
@@ -489,13 +495,23 @@ void TypeAnalysis::run(const TranslationUnit& translationUnit) {
         argumentTypes.clear();
 
         // Analyse general argument types, clause by clause.
-        for (const Clause* clause : program.getClauses()) {
-            auto clauseArgumentTypes = analyseTypes(translationUnit, *clause, debugStream);
-            argumentTypes.insert(clauseArgumentTypes.begin(), clauseArgumentTypes.end());
+        std::vector<std::map<const Argument*, TypeSet>> clauseArgumentTypes(clauses.size());
+        std::vector<std::stringstream> clauseLogs(debugStream != nullptr ? clauses.size() : 0);
+        PARALLEL_START
+        pfor(std::size_t i = 0; i < clauses.size(); i++) {
+            clauseArgumentTypes[i] = analyseTypes(
+                    translationUnit, *clauses[i], debugStream != nullptr ? &clauseLogs[i] : nullptr);
+        }
+        PARALLEL_END
+
+        // Merge the results in the order of the clauses, to keep the logs deterministic
+        for (std::size_t i = 0; i < clauses.size(); i++) {
+            argumentTypes.insert(clauseArgumentTypes[i].begin(), clauseArgumentTypes[i].end());
 
             if (debugStream != nullptr) {
+                *debugStream << clauseLogs[i].str();
                 // Store an annotated clause for printing purposes
-                annotatedClauses.emplace_back(createAnnotatedClause(clause, clauseArgumentTypes));
+                annotatedClauses.emplace_back(createAnnotatedClause(clauses[i], clauseArgumentTypes[i]));
             }
         }
 
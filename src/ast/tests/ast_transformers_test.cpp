@@ -16,24 +16,51 @@
 
 #include "tests/test.h"
 
+#include "Global.h"
+#include "RelationTag.h"
+#include "ast/Atom.h"
 #include "ast/Clause.h"
+#include "ast/ExecutionOrder.h"
 #include "ast/Node.h"
 #include "ast/Program.h"
 #include "ast/QualifiedName.h"
 #include "ast/Relation.h"
 #include "ast/TranslationUnit.h"
 #include "ast/analysis/ClauseNormalisation.h"
+#include "ast/analysis/IOType.h"
+#include "ast/analysis/PrecedenceGraph.h"
+#include "ast/analysis/RecursiveClauses.h"
+#include "ast/analysis/RedundantRelations.h"
+#include "ast/analysis/RelationSchedule.h"
+#include "ast/analysis/SCCGraph.h"
+#include "ast/analysis/TopologicallySortedSCCGraph.h"
+#include "ast/analysis/typesystem/SumTypeBranches.h"
+#include "ast/analysis/typesystem/TypeEnvironment.h"
+#include "ast/transform/ExecutionPlanFile.h"
+#include "ast/transform/InlineRelations.h"
 #include "ast/transform/MagicSet.h"
 #include "ast/transform/MinimiseProgram.h"
+#include "ast/transform/NameUnnamedVariables.h"
+#include "ast/transform/NormaliseGenerators.h"
 #include "ast/transform/RemoveRedundantRelations.h"
+#include "ast/transform/RemoveRedundantSums.h"
 #include "ast/transform/RemoveRelationCopies.h"
+#include "ast/transform/RemoveUnusedColumns.h"
+#include "ast/transform/ReorderLiterals.h"
+#include "ast/transform/ReplaceSingletonVariables.h"
 #include "ast/transform/ResolveAliases.h"
+#include "ast/transform/SimplifyAggregateTargetExpression.h"
+#include "ast/transform/UniqueAggregationVariables.h"
 #include "ast/utility/Utils.h"
+#include "ast/utility/Visitor.h"
 #include "parser/ParserDriver.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
 #include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FileUtil.h"
 #include "souffle/utility/StringUtil.h"
+#include <cstdio>
+#include <fstream>
 #include <map>
 #include <memory>
 #include <set>
@@ -307,6 +334,12 @@ TEST(Transformers, CheckClausalEquivalence) {
     EXPECT_FALSE(MinimiseProgramTransformer::areBijectivelyEquivalent(normC0, normC1));
     EXPECT_FALSE(MinimiseProgramTransformer::areBijectivelyEquivalent(normC2, normC1));
 
+    // Equivalent clauses must have the same fingerprint
+    EXPECT_EQ(normA0.getFingerprint(), normA1.getFingerprint());
+    EXPECT_NE(normA1.getFingerprint(), normA2.getFingerprint());
+    EXPECT_EQ(normC0.getFingerprint(), normC2.getFingerprint());
+    EXPECT_NE(normC0.getFingerprint(), normC1.getFingerprint());
+
     // Make sure equivalent (and only equivalent) clauses are removed by the minimiser
     mk<MinimiseProgramTransformer>()->apply(*tu);
     auto&& aMinClauses = program.getClauses("A");
@@ -783,4 +816,484 @@ TEST(Transformers, MagicSetComprehensive) {
     });
     checkRelMapEq(finalProgram, mappifyRelations(program));
 }
+
+TEST(Transformers, MagicSetAuto) {
+    const std::string source = R"(
+        .decl edge(x:number, y:number)
+        .input edge
+
+        .decl path(x:number, y:number)
+        path(x, y) :- edge(x, y).
+        path(x, z) :- path(x, y), edge(y, z).
+
+        .decl fromOne(y:number)
+        .output fromOne
+        fromOne(z) :- path(y, z), path(1, y).
+
+        .decl twoHop(x:number, y:number)
+        twoHop(x, z) :- edge(x, y), edge(y, z).
+
+        .decl back(x:number, y:number)
+        .output back
+        back(x, y) :- twoHop(x, y), edge(y, x).
+    )";
+
+    auto getMagicRelations = [](const Program& program) {
+        std::set<std::string> names;
+        for (const auto* rel : program.getRelations()) {
+            const auto& qualifiers = rel->getQualifiedName().getQualifiers();
+            if (qualifiers.front() == "@magic") {
+                names.insert(toString(rel->getQualifiedName()));
+            }
+        }
+        return names;
+    };
+
+    // only path is bound by a constant, and the bindings of fromOne are passed on in the SIPS order
+    {
+        ErrorReport errorReport;
+        DebugReport debugReport;
+        Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(source, errorReport, debugReport);
+        Global::config().set("magic-transform-auto");
+        mk<MagicSetTransformer>()->apply(*tu);
+        Global::config().unset("magic-transform-auto");
+        EXPECT_EQ(std::set<std::string>({"@magic.path.{bf}"}), getMagicRelations(tu->getProgram()));
+    }
+
+    // a listed relation is transformed wherever it is used, with its atoms adorned from left to right
+    {
+        ErrorReport errorReport;
+        DebugReport debugReport;
+        Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(source, errorReport, debugReport);
+        Global::config().set("magic-transform", "path,twoHop");
+        mk<MagicSetTransformer>()->apply(*tu);
+        Global::config().unset("magic-transform");
+        const auto magicRelations = getMagicRelations(tu->getProgram());
+        EXPECT_TRUE(contains(magicRelations, "@magic.path.{ff}"));
+        EXPECT_TRUE(contains(magicRelations, "@magic.twoHop.{ff}"));
+    }
+}
+
+TEST(Transformers, ExecutionPlanFileKeys) {
+    ErrorReport errorReport;
+    DebugReport debugReport;
+    Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(
+            R"(
+                .decl edge(x:number, y:number)
+                .decl path(x:number, y:number)
+
+                path(x,y) :- edge(x,y).
+                path(x,z) :- path(x,y), edge(y,z), path(z,z). .plan 1:(3,2,1)
+            )",
+            errorReport, debugReport);
+
+    const Program& program = tu->getProgram();
+    const auto* base = program.getClauses("path")[0];
+    const auto* recursive = program.getClauses("path")[1];
+
+    // the key is the clause on a single line, without its plan
+    EXPECT_EQ("path(x,y) :- edge(x,y).", ExecutionPlanFileTransformer::getClauseKey(*base));
+    EXPECT_EQ("path(x,z) :- path(x,y), edge(y,z), path(z,z).",
+            ExecutionPlanFileTransformer::getClauseKey(*recursive));
+
+    // each version of the recursive clause scans the delta of one of its recursive atoms
+    EXPECT_EQ(std::vector<std::size_t>(), ExecutionPlanFileTransformer::getDeltaAtoms(*tu, *base));
+    EXPECT_EQ(std::vector<std::size_t>({0, 2}), ExecutionPlanFileTransformer::getDeltaAtoms(*tu, *recursive));
+}
+
+TEST(Transformers, ExecutionPlanFileOrders) {
+    using Orders = std::map<int, ExecutionOrder::ExecOrder>;
+
+    // the orders of the versions of a clause, separated by commas
+    EXPECT_EQ(Orders({{0, {2, 1}}}), ExecutionPlanFileTransformer::parseOrders("0:(2,1)"));
+    EXPECT_EQ(Orders({{0, {2, 1}}, {1, {1, 2}}}),
+            ExecutionPlanFileTransformer::parseOrders("0:(2,1), 1:(1,2)"));
+
+    // malformed orders, a repeated or negative version, and text after the orders are rejected
+    for (const std::string text :
+            {"", "0:(2,1", "0:2,1", "0:()", "0:(a)", "0:(2,1) x", "0:(2,1), 0:(1,2)", "-1:(1)"}) {
+        EXPECT_FALSE(ExecutionPlanFileTransformer::parseOrders(text).has_value());
+    }
+
+    // each order is a permutation of the atoms, given for an existing version
+    EXPECT_TRUE(ExecutionPlanFileTransformer::fitsClause({{0, {2, 1}}}, 2, 1));
+    EXPECT_TRUE(ExecutionPlanFileTransformer::fitsClause({{0, {1, 2}}, {1, {2, 1}}}, 2, 2));
+    EXPECT_FALSE(ExecutionPlanFileTransformer::fitsClause({{0, {2, 1}}}, 3, 1));
+    EXPECT_FALSE(ExecutionPlanFileTransformer::fitsClause({{1, {1, 2}}}, 2, 1));
+    EXPECT_FALSE(ExecutionPlanFileTransformer::fitsClause({{0, {1, 1}}}, 2, 1));
+    EXPECT_FALSE(ExecutionPlanFileTransformer::fitsClause({{0, {2, 3}}}, 2, 1));
+}
+
+TEST(Transformers, ExecutionPlanFileApply) {
+    ErrorReport errorReport;
+    DebugReport debugReport;
+    Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(
+            R"(
+                .decl edge(x:number, y:number)
+                .decl path(x:number, y:number)
+                path(x,y) :- edge(x,y).
+                path(x,z) :- path(x,y), edge(y,z).
+
+                .decl triangle(x:number, y:number, z:number)
+                triangle(x,y,z) :- edge(x,y), edge(y,z), edge(z,x).
+
+                .decl cycle(x:number)
+                cycle(x) :- edge(x,y), edge(y,x). .plan 0:(1,2)
+            )",
+            errorReport, debugReport);
+
+    const std::string planFile = tempFile();
+    std::ofstream(planFile) << R"(// plans
+path(x,z) :- path(x,y), edge(y,z). .plan 0:(2,1)
+triangle(x,y,z) :- edge(x,y), edge(y,z), edge(z,x). .plan 0:(3,1,2), 1:(1,2,3)
+path(x,y) :- edge(x,y).
+reach(x) :- path(1,x). .plan 0:(1)
+cycle(x) :- edge(x,y), edge(y,x). .plan 0:(2,1)
+)";
+    Global::config().set("plan-file", planFile);
+    mk<ExecutionPlanFileTransformer>()->apply(*tu);
+    Global::config().unset("plan-file");
+    remove(planFile.c_str());
+
+    // only the plan of the recursive clause of path fits a clause without a plan of its own
+    const Program& program = tu->getProgram();
+    EXPECT_EQ(nullptr, program.getClauses("path")[0]->getExecutionPlan());
+    EXPECT_EQ(" .plan 0:(2,1)", toString(*program.getClauses("path")[1]->getExecutionPlan()));
+    EXPECT_EQ(nullptr, program.getClauses("triangle")[0]->getExecutionPlan());
+    EXPECT_EQ(" .plan 0:(1,2)", toString(*program.getClauses("cycle")[0]->getExecutionPlan()));
+
+    // the other lines are reported
+    const std::string warnings = toString(errorReport);
+    EXPECT_EQ(3, errorReport.getNumWarnings());
+    EXPECT_TRUE(warnings.find("Ignoring the plan on line 3 of plan file " + planFile +
+                              ", which does not fit its clause") != std::string::npos);
+    EXPECT_TRUE(warnings.find("Ignoring line 4 of plan file " + planFile + " without a plan") !=
+                std::string::npos);
+    EXPECT_TRUE(warnings.find("Ignoring the plan on line 5 of plan file " + planFile +
+                              ", whose clause no longer exists") != std::string::npos);
+}
+
+TEST(Transformers, InlineAuto) {
+    ErrorReport errorReport;
+    DebugReport debugReport;
+    Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(
+            R"(
+                .decl edge(x:number, y:number)
+                .input edge
+
+                .decl step(x:number, y:number)
+                step(x, y) :- edge(x, y), x < y.
+                .decl hop(x:number, y:number, z:number)
+                hop(x, y, z) :- edge(x, y), edge(y, z).
+                .decl path(x:number, y:number)
+                path(x, y) :- step(x, y).
+                path(x, z) :- path(x, y), edge(y, z).
+                path(x, z) :- path(x, w), hop(w, _, z).
+
+                .decl twoHop(x:number, y:number, z:number)
+                twoHop(x, y, z) :- edge(x, y), edge(y, z).
+                .decl triangle(x:number)
+                triangle(x) :- twoHop(x, _, z), edge(z, x).
+
+                .decl reach(x:number)
+                reach(y) :- path(1, y).
+
+                .decl source(x:number)
+                source(x) :- edge(x, _).
+                .decl unreached(x:number)
+                unreached(x) :- source(x), !reach(x).
+
+                .output path, triangle, unreached
+            )",
+            errorReport, debugReport);
+
+    Global::config().set("inline-auto");
+    mk<InlineRelationsTransformer>()->apply(*tu);
+    Global::config().unset("inline-auto");
+
+    // the relations inlined automatically, and the reasons others are not
+    const Program& program = tu->getProgram();
+    auto isInlined = [&](const std::string& name) {
+        return program.getRelation(QualifiedName(name))->hasQualifier(RelationQualifier::INLINE);
+    };
+    // computed by a single atom, so also inlined into a recursive clause
+    EXPECT_TRUE(isInlined("step"));
+    // does not project away variables
+    EXPECT_TRUE(isInlined("twoHop"));
+    // a join used by a recursive clause would be evaluated in every iteration
+    EXPECT_FALSE(isInlined("hop"));
+    // projects away variables, and there is no profile
+    EXPECT_FALSE(isInlined("source"));
+    // negated, recursive, or output relations
+    EXPECT_FALSE(isInlined("reach"));
+    EXPECT_FALSE(isInlined("path"));
+    EXPECT_FALSE(isInlined("unreached"));
+    EXPECT_EQ(0, errorReport.getNumIssues());
+
+    // the uses of the inlined relations are replaced by their bodies
+    const auto triangle = program.getClauses("triangle");
+    EXPECT_EQ(1, triangle.size());
+    EXPECT_EQ(3, getBodyLiterals<Atom>(*triangle[0]).size());
+    for (const auto* atom : getBodyLiterals<Atom>(*triangle[0])) {
+        EXPECT_EQ("edge", toString(atom->getQualifiedName()));
+    }
+}
+
+TEST(Transformers, InlineLimit) {
+    const std::string source = R"(
+        .decl edge(x:number, y:number)
+        .input edge
+
+        .decl a(x:number, y:number) inline
+        a(x, y) :- edge(x, y).
+        a(x, y) :- edge(y, x).
+        a(x, y) :- edge(x, z), edge(z, y).
+
+        .decl b(x:number, y:number) inline
+        b(x, y) :- a(x, y).
+        b(x, y) :- edge(x, y), x < y.
+
+        .decl r(x:number, y:number)
+        .output r
+        r(x, z) :- a(x, y), a(y, z), b(z, x).
+    )";
+
+    // without `inline-auto` or `inline-limit`, the relations declared inline are always inlined
+    {
+        ErrorReport errorReport;
+        DebugReport debugReport;
+        Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(source, errorReport, debugReport);
+        mk<InlineRelationsTransformer>()->apply(*tu);
+        EXPECT_EQ(36, tu->getProgram().getClauses("r").size());
+        EXPECT_EQ(0, errorReport.getNumWarnings());
+    }
+
+    // the relation with the most versions is materialised until the clauses of r are within the limit
+    {
+        ErrorReport errorReport;
+        DebugReport debugReport;
+        Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(source, errorReport, debugReport);
+        Global::config().set("inline-limit", "20");
+        mk<InlineRelationsTransformer>()->apply(*tu);
+        Global::config().unset("inline-limit");
+
+        const Program& program = tu->getProgram();
+        EXPECT_FALSE(program.getRelation(QualifiedName("b"))->hasQualifier(RelationQualifier::INLINE));
+        EXPECT_TRUE(program.getRelation(QualifiedName("a"))->hasQualifier(RelationQualifier::INLINE));
+        EXPECT_EQ(9, program.getClauses("r").size());
+        EXPECT_EQ(4, program.getClauses("b").size());
+        EXPECT_EQ(1, errorReport.getNumWarnings());
+        EXPECT_TRUE(toString(errorReport).find("Relation b is not inlined, as inlining would produce more "
+                                                "than 20 clauses for a clause of r") != std::string::npos);
+    }
+}
+
+TEST(Transformers, RemoveUnusedColumns) {
+    ErrorReport errorReport;
+    DebugReport debugReport;
+    Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(
+            R"(
+                .decl edge(x:number, y:number, w:number)
+                .input edge
+
+                .decl reach(x:number, y:number, w:number)
+                reach(x,y,w) :- edge(x,y,w).
+                reach(x,z,w) :- reach(x,y,_), edge(y,z,w).
+
+                .decl target(y:number)
+                .output target
+                target(y) :- reach(_,y,_).
+
+                .decl unreached(x:number)
+                .output unreached
+                unreached(x) :- edge(x,_,_), !reach(_,x,_).
+
+                .decl checked(x:number, w:number)
+                .output checked
+                checked(x,w) :- edge(x,_,w), reach(x,_,_).
+
+                .decl pairs(x:number, y:number)
+                .output pairs
+                pairs(x,y) :- reach(x,_,_), reach(y,_,_), x < y.
+            )",
+            errorReport, debugReport);
+    mk<RemoveUnusedColumnsTransformer>()->apply(*tu);
+    const Program& program = tu->getProgram();
+
+    auto getAtomNames = [&](const std::string& relation) {
+        std::vector<std::string> names;
+        visit(*program.getClauses(relation)[0], [&](const Atom& atom) {
+            names.push_back(toString(atom.getQualifiedName()));
+        });
+        return names;
+    };
+
+    // no reader uses the weights of reach
+    EXPECT_EQ(2, program.getRelation(QualifiedName("reach"))->getArity());
+
+    // the atoms joined over the first column of reach read a projection, shared by both
+    const Relation* projection = program.getRelation(QualifiedName("+?projection_reach{0}"));
+    EXPECT_NE(nullptr, projection);
+    EXPECT_EQ(1, projection->getArity());
+    EXPECT_EQ(1, program.getClauses(*projection).size());
+    EXPECT_EQ(std::vector<std::string>({"pairs", "+?projection_reach{0}", "+?projection_reach{0}"}),
+            getAtomNames("pairs"));
+
+    // a single reader alone in its clause, a negation and an existence check read reach itself
+    EXPECT_EQ(std::vector<std::string>({"target", "reach"}), getAtomNames("target"));
+    EXPECT_EQ(std::vector<std::string>({"unreached", "edge", "reach"}), getAtomNames("unreached"));
+    EXPECT_EQ(std::vector<std::string>({"checked", "edge", "reach"}), getAtomNames("checked"));
+    EXPECT_EQ(nullptr, program.getRelation(QualifiedName("+?projection_reach{1}")));
+}
+
+TEST(Transformers, RemoveUnusedColumnsNames) {
+    ErrorReport errorReport;
+    DebugReport debugReport;
+    Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(
+            R"(
+                .decl edge(x:number, y:number, w:number)
+                .input edge
+
+                .decl foo(x:number, y:number, w:number)
+                foo(x,y,w) :- edge(x,y,w), w < 40.
+
+                .decl foo_1(x:number, y:number, w:number)
+                foo_1(x,y,w) :- edge(x,y,w), w > 10.
+
+                .decl both(x:number, y:number, w:number)
+                .output both
+                both(x,y,w) :- foo(x,y,w), foo_1(x,y,w).
+
+                .decl heavy(y:number, w:number)
+                .output heavy
+                heavy(y,w) :- foo(_,y,w), edge(y,_,_).
+
+                .decl ordered(w:number, v:number)
+                .output ordered
+                ordered(w,v) :- foo_1(_,_,w), foo_1(_,_,v), w < v.
+            )",
+            errorReport, debugReport);
+    mk<RemoveUnusedColumnsTransformer>()->apply(*tu);
+    const Program& program = tu->getProgram();
+
+    // the projections of foo on {1,2} and of foo_1 on {2} have different names
+    const Relation* fooProjection = program.getRelation(QualifiedName("+?projection_foo{1,2}"));
+    const Relation* foo1Projection = program.getRelation(QualifiedName("+?projection_foo_1{2}"));
+    EXPECT_NE(nullptr, fooProjection);
+    EXPECT_NE(nullptr, foo1Projection);
+    EXPECT_EQ(2, fooProjection->getArity());
+    EXPECT_EQ(1, foo1Projection->getArity());
+}
+
+/** The analyses still cached after applying a transformer, and the number of analyses it preserved */
+struct CachedAnalyses {
+    bool changed = false;
+    std::map<std::string, bool> cached;
+    std::size_t numPreserved = 0;
+};
+
+/**
+ * Compute analyses the transformer preserves and analyses it invalidates, apply the transformer to the
+ * program, and record for each analysis whether getAnalysis still returns the analysis computed before.  A
+ * recomputed analysis may be allocated at the address of its invalidated predecessor, so an analysis only
+ * counts as cached if it is alive right after the transformer was applied.
+ */
+CachedAnalyses applyWithAnalyses(Transformer& transformer, const std::string& code) {
+    ErrorReport errorReport;
+    DebugReport debugReport;
+    Own<TranslationUnit> tu = ParserDriver::parseTranslationUnit(code, errorReport, debugReport);
+
+    auto getAnalyses = [&]() -> std::map<std::string, const souffle::detail::AnalysisBase*> {
+        return {{IOTypeAnalysis::name, &tu->getAnalysis<IOTypeAnalysis>()},
+                {PrecedenceGraphAnalysis::name, &tu->getAnalysis<PrecedenceGraphAnalysis>()},
+                {RedundantRelationsAnalysis::name, &tu->getAnalysis<RedundantRelationsAnalysis>()},
+                {RelationScheduleAnalysis::name, &tu->getAnalysis<RelationScheduleAnalysis>()},
+                {SCCGraphAnalysis::name, &tu->getAnalysis<SCCGraphAnalysis>()},
+                {TopologicallySortedSCCGraphAnalysis::name,
+                        &tu->getAnalysis<TopologicallySortedSCCGraphAnalysis>()},
+                {SumTypeBranchesAnalysis::name, &tu->getAnalysis<SumTypeBranchesAnalysis>()},
+                {TypeEnvironmentAnalysis::name, &tu->getAnalysis<TypeEnvironmentAnalysis>()},
+                {RecursiveClausesAnalysis::name, &tu->getAnalysis<RecursiveClausesAnalysis>()},
+                {ClauseNormalisationAnalysis::name, &tu->getAnalysis<ClauseNormalisationAnalysis>()}};
+    };
+    const auto before = getAnalyses();
+    const std::size_t preservedBefore = tu->getAnalysisStatistics().preserved;
+
+    CachedAnalyses result;
+    result.changed = transformer.apply(*tu);
+    const auto alive = tu->getAliveAnalyses();
+    result.numPreserved = tu->getAnalysisStatistics().preserved - preservedBefore;
+
+    const auto after = getAnalyses();
+    for (const auto& [name, analysis] : before) {
+        result.cached[name] = contains(alive, analysis) && after.at(name) == analysis;
+    }
+    return result;
+}
+
+/** Check that the transformer changes the program, and keeps exactly the analyses it declares as preserved */
+#define EXPECT_PRESERVED(TRANSFORMER, CODE)                                                     \
+    {                                                                                           \
+        TRANSFORMER transformer;                                                                \
+        const auto& [changed, cached, numPreserved] = applyWithAnalyses(transformer, CODE);     \
+        EXPECT_TRUE(changed);                                                                   \
+        const std::set<std::string> preserved = transformer.getPreservedAnalyses();             \
+        std::size_t numCached = 0;                                                              \
+        for (const auto& [name, isCached] : cached) {                                           \
+            EXPECT_EQ(contains(preserved, name), isCached) << " for analysis " << name;         \
+            numCached += isCached ? 1 : 0;                                                      \
+        }                                                                                       \
+        EXPECT_EQ(numCached, numPreserved);                                                     \
+        EXPECT_TRUE(cached.at(PrecedenceGraphAnalysis::name));                                  \
+        EXPECT_FALSE(cached.at(ClauseNormalisationAnalysis::name));                             \
+    }
+
+/** The declarations of the programs checking the preserved analyses */
+const std::string preservationDecls = R"(
+    .decl a(x:number)
+    .decl b(x:number, y:number)
+    .decl s(n:number)
+)";
+
+TEST(Transformers, PreservedAnalysesReplaceSingletonVariables) {
+    EXPECT_PRESERVED(ReplaceSingletonVariablesTransformer, preservationDecls + "a(x) :- b(x, y).");
+}
+
+TEST(Transformers, PreservedAnalysesNameUnnamedVariables) {
+    EXPECT_PRESERVED(NameUnnamedVariablesTransformer, preservationDecls + "a(x) :- b(x, _).");
+}
+
+TEST(Transformers, PreservedAnalysesRemoveRedundantSums) {
+    EXPECT_PRESERVED(RemoveRedundantSumsTransformer, preservationDecls + "s(n) :- n = sum 2 : { b(_, _) }.");
+}
+
+TEST(Transformers, PreservedAnalysesNormaliseGenerators) {
+    EXPECT_PRESERVED(NormaliseGeneratorsTransformer, preservationDecls + "s(n) :- n = count : { b(_, _) }.");
+}
+
+TEST(Transformers, PreservedAnalysesUniqueAggregationVariables) {
+    // the local variable y of each aggregate occurs outside of it in the other aggregate
+    EXPECT_PRESERVED(UniqueAggregationVariablesTransformer,
+            preservationDecls + "s(n) :- n = sum y : { b(y, _) }, n = max y : { b(_, y) }.");
+}
+
+TEST(Transformers, PreservedAnalysesSimplifyAggregateTargetExpression) {
+    EXPECT_PRESERVED(SimplifyAggregateTargetExpressionTransformer,
+            preservationDecls + "s(n) :- n = sum y + 1 : { b(y, _) }.");
+}
+
+TEST(Transformers, PreservedAnalysesReorderLiterals) {
+    // the all-bound SIPS evaluates the ground atom first, and the recursive clauses are invalidated
+    EXPECT_PRESERVED(ReorderLiteralsTransformer, preservationDecls + "a(x) :- b(x, _), a(1).");
+}
+
+TEST(Transformers, PreservedAnalysesExecutionPlanFile) {
+    const std::string planFile = tempFile();
+    std::ofstream(planFile) << "a(x) :- b(x,y), b(y,x). .plan 0:(2,1)\n";
+    Global::config().set("plan-file", planFile);
+    EXPECT_PRESERVED(ExecutionPlanFileTransformer, preservationDecls + "a(x) :- b(x, y), b(y, x).");
+    Global::config().unset("plan-file");
+    remove(planFile.c_str());
+}
+
 }  // namespace souffle::ast::transform::test
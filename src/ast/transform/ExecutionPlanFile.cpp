@@ -0,0 +1,207 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ExecutionPlanFile.cpp
+ *
+ * Implementation of the transformation pass applying the execution plans
+ * of a plan file.
+ *
+ ***********************************************************************/
+
+#include "ast/transform/ExecutionPlanFile.h"
+#include "Global.h"
+#include "ast/Atom.h"
+#include "ast/Clause.h"
+#include "ast/ExecutionOrder.h"
+#include "ast/ExecutionPlan.h"
+#include "ast/Program.h"
+#include "ast/SubsumptiveClause.h"
+#include "ast/TranslationUnit.h"
+#include "ast/analysis/RecursiveClauses.h"
+#include "ast/analysis/SCCGraph.h"
+#include "ast/utility/Utils.h"
+#include "reports/ErrorReport.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include "souffle/utility/tinyformat.h"
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ast::transform {
+
+using ExecOrder = ExecutionOrder::ExecOrder;
+
+std::optional<std::map<int, ExecOrder>> ExecutionPlanFileTransformer::parseOrders(const std::string& text) {
+    std::map<int, ExecOrder> orders;
+    std::istringstream in(text);
+    char c;
+    do {
+        int version;
+        if (!(in >> version >> c) || c != ':' || !(in >> c) || c != '(' || version < 0 ||
+                contains(orders, version)) {
+            return std::nullopt;
+        }
+        auto& order = orders[version];
+        do {
+            unsigned int atom;
+            if (!(in >> atom >> c) || (c != ',' && c != ')')) {
+                return std::nullopt;
+            }
+            order.push_back(atom);
+        } while (c == ',');
+    } while (in >> c && c == ',');
+
+    // the orders have to end the line
+    if (in) {
+        return std::nullopt;
+    }
+    return orders;
+}
+
+bool ExecutionPlanFileTransformer::fitsClause(
+        const std::map<int, ExecOrder>& orders, std::size_t numAtoms, std::size_t numVersions) {
+    for (const auto& [version, order] : orders) {
+        if (static_cast<std::size_t>(version) >= numVersions || order.size() != numAtoms) {
+            return false;
+        }
+        std::set<unsigned int> atoms(order.begin(), order.end());
+        if (atoms.size() != numAtoms || *atoms.begin() != 1 || *atoms.rbegin() != numAtoms) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string ExecutionPlanFileTransformer::getClauseKey(const Clause& clause) {
+    auto unplanned = clone(clause);
+    unplanned->clearExecutionPlan();
+
+    // replace the line breaks between the body literals, and their indentation, by a single space
+    std::string text = toString(*unplanned);
+    std::string key;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\n') {
+            key += text[i];
+            continue;
+        }
+        while (i + 1 < text.size() && text[i + 1] == ' ') {
+            ++i;
+        }
+        if (!key.empty() && key.back() != ' ') {
+            key += ' ';
+        }
+    }
+    return key;
+}
+
+std::vector<std::size_t> ExecutionPlanFileTransformer::getDeltaAtoms(
+        const TranslationUnit& translationUnit, const Clause& clause) {
+    std::vector<std::size_t> deltaAtoms;
+    if (!translationUnit.getAnalysis<analysis::RecursiveClausesAnalysis>().recursive(&clause)) {
+        return deltaAtoms;
+    }
+    const auto& sccGraph = translationUnit.getAnalysis<analysis::SCCGraphAnalysis>();
+    const Program& program = translationUnit.getProgram();
+    const std::size_t scc = sccGraph.getSCC(program.getRelation(clause));
+    const auto& atoms = getBodyLiterals<Atom>(clause);
+    for (std::size_t i = 0; i < atoms.size(); ++i) {
+        if (sccGraph.getSCC(program.getRelation(*atoms[i])) == scc) {
+            deltaAtoms.push_back(i);
+        }
+    }
+    return deltaAtoms;
+}
+
+bool ExecutionPlanFileTransformer::transform(TranslationUnit& translationUnit) {
+    // the plan file is the output of a plan search
+    if (!Global::config().has("plan-file") || Global::config().has("plan-search")) {
+        return false;
+    }
+    const std::string& filename = Global::config().get("plan-file");
+    auto& report = translationUnit.getErrorReport();
+
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        report.addWarning("Cannot open plan file " + filename + ", no plans are applied", {});
+        return false;
+    }
+
+    // plans by the clause they are given for, with their line in the plan file
+    std::map<std::string, std::pair<std::string, std::size_t>> plans;
+    std::string line;
+    for (std::size_t lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        if (line.empty() || isPrefix("//", line)) {
+            continue;
+        }
+        const std::size_t split = line.rfind(" .plan ");
+        if (split == std::string::npos) {
+            report.addWarning(tfm::format("Ignoring line %d of plan file %s without a plan", lineNumber,
+                                      filename),
+                    {});
+            continue;
+        }
+        plans[line.substr(0, split)] = {line.substr(split + 7), lineNumber};
+    }
+
+    bool changed = false;
+    std::set<std::string> matched;
+    for (Clause* clause : translationUnit.getProgram().getClauses()) {
+        const auto& plan = plans.find(getClauseKey(*clause));
+        if (plan == plans.end()) {
+            continue;
+        }
+        matched.insert(plan->first);
+
+        // plans given in the program take precedence
+        if (clause->getExecutionPlan() != nullptr || isA<SubsumptiveClause>(clause)) {
+            continue;
+        }
+
+        const auto& [text, lineNumber] = plan->second;
+        const auto& orders = parseOrders(text);
+        const std::size_t numVersions =
+                std::max<std::size_t>(1, getDeltaAtoms(translationUnit, *clause).size());
+        if (!orders.has_value() ||
+                !fitsClause(*orders, getBodyLiterals<Atom>(*clause).size(), numVersions)) {
+            report.addWarning(tfm::format("Ignoring the plan on line %d of plan file %s, which does not fit "
+                                          "its clause",
+                                      lineNumber, filename),
+                    clause->getSrcLoc());
+            continue;
+        }
+
+        auto executionPlan = mk<ExecutionPlan>();
+        for (const auto& [version, order] : *orders) {
+            executionPlan->setOrderFor(version, mk<ExecutionOrder>(order));
+        }
+        clause->setExecutionPlan(std::move(executionPlan));
+        changed = true;
+    }
+
+    for (const auto& [key, plan] : plans) {
+        if (!contains(matched, key)) {
+            report.addWarning(tfm::format("Ignoring the plan on line %d of plan file %s, whose clause no "
+                                          "longer exists",
+                                      plan.second, filename),
+                    {});
+        }
+    }
+    return changed;
+}
+
+}  // namespace souffle::ast::transform
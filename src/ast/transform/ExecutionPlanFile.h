@@ -0,0 +1,86 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ExecutionPlanFile.h
+ *
+ * Defines the transformation pass applying the execution plans of a plan
+ * file.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ast/Clause.h"
+#include "ast/ExecutionOrder.h"
+#include "ast/TranslationUnit.h"
+#include "ast/transform/Transformer.h"
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace souffle::ast::transform {
+
+/**
+ * Transformation pass applying the execution plans of the plan file given with `plan-file`, e.g. as
+ * written by `plan-search`, to the clauses without a plan of their own.
+ *
+ * Each line of a plan file holds a clause on a single line, followed by its plan, e.g.
+ *
+ *   path(x,z) :- path(x,y), edge(y,z). .plan 0:(2,1)
+ *
+ * The pass runs before the literals of the clauses are reordered, which skips the clauses with a plan.
+ * Clauses are thus identified by their text before the literal reordering, and the atoms of their plans
+ * are numbered in this text, so that a plan does not depend on the SIPS or profile that reorders the
+ * other clauses.  The text does depend on the transformations before, e.g. inlining and the magic set
+ * transformation, so a plan file only fits the options it was written with.  The plans of clauses that
+ * no longer exist, or that do not fit their clause, are ignored with a warning.
+ */
+class ExecutionPlanFileTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "ExecutionPlanFileTransformer";
+    }
+
+    /** The plans only change the order in which clauses are evaluated */
+    std::set<std::string> getPreservedAnalyses() const override {
+        std::set<std::string> preserved = getRelationAnalyses();
+        preserved.merge(getTypeDeclarationAnalyses());
+        return preserved;
+    }
+
+    /** The text identifying a clause in a plan file, i.e. the clause without its plan on a single line */
+    static std::string getClauseKey(const Clause& clause);
+
+    /** Parse the orders of a plan, e.g. `0:(2,1), 1:(1,2)`, or return nothing if they are malformed */
+    static std::optional<std::map<int, ExecutionOrder::ExecOrder>> parseOrders(const std::string& text);
+
+    /** Check that each order is a permutation of the atoms of a clause, given for one of its versions */
+    static bool fitsClause(const std::map<int, ExecutionOrder::ExecOrder>& orders, std::size_t numAtoms,
+            std::size_t numVersions);
+
+    /**
+     * The positions of the atoms of a recursive clause whose relations are computed with its head, i.e.
+     * the atom scanning a delta relation in each version of the clause; none if it is not recursive.
+     */
+    static std::vector<std::size_t> getDeltaAtoms(
+            const TranslationUnit& translationUnit, const Clause& clause);
+
+private:
+    ExecutionPlanFileTransformer* cloning() const override {
+        return new ExecutionPlanFileTransformer();
+    }
+
+    bool transform(TranslationUnit& translationUnit) override;
+};
+
+}  // namespace souffle::ast::transform
@@ -0,0 +1,348 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ExecutionPlanSearch.cpp
+ *
+ * Implementation of the search of the execution plans written to a plan
+ * file.
+ *
+ ***********************************************************************/
+
+#include "ast/transform/ExecutionPlanSearch.h"
+#include "Global.h"
+#include "ast/Atom.h"
+#include "ast/Clause.h"
+#include "ast/ExecutionOrder.h"
+#include "ast/ExecutionPlan.h"
+#include "ast/Program.h"
+#include "ast/SubsumptiveClause.h"
+#include "ast/TranslationUnit.h"
+#include "ast/transform/ExecutionPlanFile.h"
+#include "ast/utility/SipsMetric.h"
+#include "ast/utility/Utils.h"
+#include "souffle/profile/ProgramRun.h"
+#include "souffle/profile/Reader.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FileUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include "souffle/utility/SubProcess.h"
+#include "souffle/utility/tinyformat.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace souffle::ast::transform {
+
+namespace {
+
+using ExecOrder = ExecutionOrder::ExecOrder;
+using microseconds = std::chrono::microseconds;
+
+/** A candidate replaces the current order only if it is faster by at least this fraction */
+constexpr double MIN_SPEEDUP = 0.1;
+
+/** The maximal number of candidate orders of a version of a clause */
+constexpr std::size_t MAX_CANDIDATES = 6;
+
+/** The runtimes of the versions of the clauses in a profile, by relation, source location and version */
+using ClauseVersion = std::tuple<std::string, std::string, int>;
+std::map<ClauseVersion, microseconds> readRuntimes(const std::string& filename) {
+    std::map<ClauseVersion, microseconds> runtimes;
+    auto run = std::make_shared<profile::ProgramRun>();
+    profile::Reader(filename, run).processFile();
+    for (const auto& [name, relation] : run->getRelationMap()) {
+        for (const auto& [locator, rule] : relation->getRuleMap()) {
+            runtimes[{name, locator, 0}] += rule->getRuntime();
+        }
+        for (const auto& iteration : relation->getIterations()) {
+            for (const auto& [_, rule] : iteration->getRules()) {
+                runtimes[{name, rule->getLocator(), rule->getVersion()}] += rule->getRuntime();
+            }
+        }
+    }
+    return runtimes;
+}
+
+/** The order in which the literal reordering would evaluate the atoms of a clause, applying the given SIPS */
+ExecOrder getReorderedOrder(const std::vector<Own<SipsMetric>>& reorderings, const Clause& clause) {
+    ExecOrder order(getBodyLiterals<Atom>(clause).size());
+    std::iota(order.begin(), order.end(), 1);
+    Own<Clause> reordered = clone(clause);
+    for (const auto& sips : reorderings) {
+        const std::vector<unsigned int> ordering = sips->getReordering(reordered.get());
+        ExecOrder next;
+        for (unsigned int atom : ordering) {
+            next.push_back(order[atom]);
+        }
+        order = std::move(next);
+        reordered = Own<Clause>(reorderAtoms(reordered.get(), ordering));
+    }
+    return order;
+}
+
+/** The key of the clause whose plan a line of a plan file gives, or an empty string if it gives none */
+std::string getPlanKey(const std::string& line) {
+    const std::size_t split = line.rfind(" .plan ");
+    if (line.empty() || isPrefix("//", line) || split == std::string::npos) {
+        return "";
+    }
+    return line.substr(0, split);
+}
+
+/** Create a temporary directory for the output relations of the evaluations timing candidates */
+std::string tempDirectory() {
+    char templ[40] = "./souffleXXXXXX";
+    if (mkdtemp(templ) == nullptr) {
+        throw std::runtime_error("cannot create a temporary output directory for the plan search");
+    }
+    return std::string(templ);
+}
+
+/** Remove a temporary directory with the files written to it */
+void removeDirectory(const std::string& path) {
+    if (DIR* dir = opendir(path.c_str())) {
+        while (const dirent* entry = readdir(dir)) {
+            const std::string name = entry->d_name;
+            if (name != "." && name != "..") {
+                remove((path + "/" + name).c_str());
+            }
+        }
+        closedir(dir);
+    }
+    rmdir(path.c_str());
+}
+
+}  // namespace
+
+void searchExecutionPlans(const TranslationUnit& translationUnit, const std::string& souffleExecutable,
+        const std::vector<std::string>& arguments) {
+    struct Version {
+        std::vector<ExecOrder> candidates;
+        std::vector<microseconds> runtimes;
+    };
+    struct Target {
+        const Clause* clause;
+        std::string relation;
+        std::string locator;
+        microseconds runtime{0};
+        std::vector<Version> versions;
+    };
+
+    // select the most expensive clauses whose atoms can be reordered
+    const auto& profiled = readRuntimes(Global::config().get("profile-use"));
+    std::vector<Target> targets;
+    for (const Clause* clause : translationUnit.getProgram().getClauses()) {
+        if (clause->getExecutionPlan() != nullptr || isA<SubsumptiveClause>(clause) ||
+                getBodyLiterals<Atom>(*clause).size() < 2) {
+            continue;
+        }
+        Target target{clause, toString(clause->getHead()->getQualifiedName()), toString(clause->getSrcLoc()),
+                microseconds(0), {}};
+        const auto& deltaAtoms = ExecutionPlanFileTransformer::getDeltaAtoms(translationUnit, *clause);
+        target.versions.resize(std::max<std::size_t>(1, deltaAtoms.size()));
+        for (std::size_t version = 0; version < target.versions.size(); ++version) {
+            auto runtime = profiled.find({target.relation, target.locator, static_cast<int>(version)});
+            if (runtime != profiled.end()) {
+                target.runtime += runtime->second;
+            }
+        }
+        if (target.runtime.count() > 0) {
+            targets.push_back(std::move(target));
+        }
+    }
+    std::stable_sort(targets.begin(), targets.end(),
+            [](const Target& a, const Target& b) { return a.runtime > b.runtime; });
+    targets.resize(std::min<std::size_t>(targets.size(), std::stoul(Global::config().get("plan-search"))));
+    std::set<std::string> targetKeys;
+    for (const auto& target : targets) {
+        targetKeys.insert(ExecutionPlanFileTransformer::getClauseKey(*target.clause));
+    }
+
+    // the lines of an existing plan file, whose plans are kept unless the search replaces them
+    const std::string& filename = Global::config().get("plan-file");
+    std::vector<std::string> existing;
+    {
+        std::ifstream file(filename);
+        for (std::string line; std::getline(file, line);) {
+            existing.push_back(line);
+        }
+    }
+
+    // the SIPS applied by the literal reordering, which the clauses of a plan file skip
+    std::vector<Own<SipsMetric>> reorderings;
+    reorderings.push_back(SipsMetric::create(
+            Global::config().has("SIPS") ? Global::config().get("SIPS") : "all-bound", translationUnit));
+    reorderings.push_back(SipsMetric::create("profile-use", translationUnit));
+
+    // collect the distinct candidate orders of each version, starting with the current order
+    std::vector<Own<SipsMetric>> metrics;
+    for (const std::string heuristic :
+            {"profile-use", "max-bound", "max-ratio", "least-free", "least-free-vars"}) {
+        metrics.push_back(SipsMetric::create(heuristic, translationUnit));
+    }
+    std::size_t numRounds = 0;
+    for (auto& target : targets) {
+        const ExecOrder current = getReorderedOrder(reorderings, *target.clause);
+        const auto& deltaAtoms = ExecutionPlanFileTransformer::getDeltaAtoms(translationUnit, *target.clause);
+        for (std::size_t version = 0; version < target.versions.size(); ++version) {
+            auto& candidates = target.versions[version].candidates;
+            auto addCandidate = [&](const ExecOrder& order) {
+                if (candidates.size() < MAX_CANDIDATES && !contains(candidates, order)) {
+                    candidates.push_back(order);
+                }
+            };
+            addCandidate(current);
+            if (!deltaAtoms.empty()) {
+                ExecOrder deltaFirst = current;
+                auto delta = std::find(deltaFirst.begin(), deltaFirst.end(), deltaAtoms[version] + 1);
+                std::rotate(deltaFirst.begin(), delta, delta + 1);
+                addCandidate(deltaFirst);
+            }
+            for (const auto& metric : metrics) {
+                ExecOrder order;
+                for (unsigned int atom : metric->getReordering(target.clause)) {
+                    order.push_back(atom + 1);
+                }
+                addCandidate(order);
+            }
+            numRounds = std::max(numRounds, candidates.size());
+        }
+    }
+
+    // time the candidates of each round on the facts of the fact directory, writing the output relations to
+    // a temporary directory rather than over those of the user
+    const std::string outputDir = tempDirectory();
+    for (std::size_t round = 0; round < numRounds; ++round) {
+        if (Global::config().has("verbose")) {
+            std::cout << "Timing candidate plans " << round + 1 << " of " << numRounds << "\n";
+        }
+        const std::string planFile = tempFile();
+        const std::string profileFile = tempFile();
+        {
+            // the existing plans of the other clauses apply to the evaluation as they will once the plan
+            // file is written
+            std::ofstream plans(planFile);
+            for (const std::string& line : existing) {
+                const std::string key = getPlanKey(line);
+                if (!key.empty() && !contains(targetKeys, key)) {
+                    plans << line << "\n";
+                }
+            }
+            for (const auto& target : targets) {
+                auto plan = mk<ExecutionPlan>();
+                for (std::size_t version = 0; version < target.versions.size(); ++version) {
+                    const auto& candidates = target.versions[version].candidates;
+                    if (round < candidates.size()) {
+                        plan->setOrderFor(version, mk<ExecutionOrder>(candidates[round]));
+                    }
+                }
+                if (!plan->getOrders().empty()) {
+                    plans << ExecutionPlanFileTransformer::getClauseKey(*target.clause) << *plan << "\n";
+                }
+            }
+        }
+
+        std::vector<std::string> argv = arguments;
+        argv.push_back("--output-dir=" + outputDir);
+        argv.push_back("--plan-file=" + planFile);
+        argv.push_back("--profile=" + profileFile);
+        auto exit = execute(souffleExecutable, argv);
+        remove(planFile.c_str());
+        if (exit != 0) {
+            remove(profileFile.c_str());
+            removeDirectory(outputDir);
+            throw std::runtime_error(tfm::format("failed to evaluate candidate plans %d of the plan search",
+                    round + 1));
+        }
+
+        // a candidate that was not measured, e.g. as its version was never evaluated, cannot be chosen
+        const auto& measured = readRuntimes(profileFile);
+        remove(profileFile.c_str());
+        for (auto& target : targets) {
+            for (std::size_t version = 0; version < target.versions.size(); ++version) {
+                auto& [candidates, runtimes] = target.versions[version];
+                if (round < candidates.size()) {
+                    auto runtime =
+                            measured.find({target.relation, target.locator, static_cast<int>(version)});
+                    runtimes.push_back(runtime != measured.end() ? runtime->second : microseconds::max());
+                }
+            }
+        }
+    }
+    removeDirectory(outputDir);
+
+    // choose the candidates that are clearly faster than the current orders, which absorbs the noise of
+    // timing each candidate once
+    std::map<std::string, std::string> found;
+    std::vector<std::string> chosen;
+    for (const auto& target : targets) {
+        auto plan = mk<ExecutionPlan>();
+        std::stringstream speedups;
+        for (std::size_t version = 0; version < target.versions.size(); ++version) {
+            const auto& [candidates, runtimes] = target.versions[version];
+            auto fastest = std::min_element(runtimes.begin(), runtimes.end()) - runtimes.begin();
+            if (fastest != 0 && runtimes[0] != microseconds::max() &&
+                    runtimes[fastest].count() < (1 - MIN_SPEEDUP) * runtimes[0].count()) {
+                plan->setOrderFor(version, mk<ExecutionOrder>(candidates[fastest]));
+                speedups << ", version " << version << ": " << runtimes[0].count() << "us -> "
+                         << runtimes[fastest].count() << "us";
+            }
+        }
+        if (!plan->getOrders().empty()) {
+            const std::string key = ExecutionPlanFileTransformer::getClauseKey(*target.clause);
+            found[key] = target.relation;
+            chosen.push_back("// " + target.relation + " in " + target.locator + speedups.str());
+            chosen.push_back(key + toString(*plan));
+        }
+    }
+
+    // merge them into the plan file, replacing the plans of their clauses together with the comments the
+    // search wrote above them
+    std::ofstream plans(filename);
+    if (!plans.is_open()) {
+        throw std::runtime_error("cannot write plan file " + filename);
+    }
+    for (std::size_t i = 0; i < existing.size(); ++i) {
+        if (contains(found, getPlanKey(existing[i]))) {
+            continue;
+        }
+        if (i + 1 < existing.size()) {
+            const auto& replaced = found.find(getPlanKey(existing[i + 1]));
+            if (replaced != found.end() && isPrefix("// " + replaced->second + " in ", existing[i])) {
+                continue;
+            }
+        }
+        plans << existing[i] << "\n";
+    }
+    if (!chosen.empty() || existing.empty()) {
+        plans << "// execution plans chosen for the profile " << Global::config().get("profile-use") << "\n";
+    }
+    for (const std::string& line : chosen) {
+        plans << line << "\n";
+    }
+}
+
+}  // namespace souffle::ast::transform
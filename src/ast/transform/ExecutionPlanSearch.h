@@ -0,0 +1,42 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ExecutionPlanSearch.h
+ *
+ * Defines the search of the execution plans written to a plan file.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ast/TranslationUnit.h"
+#include <string>
+#include <vector>
+
+namespace souffle::ast::transform {
+
+/**
+ * Searches the join orders of the most expensive clauses of the profile given with `profile-use`, and writes
+ * those clearly faster than the current orders to the plan file given with `plan-file`.
+ *
+ * The clauses of the translation unit have to be in the form in which the plan file is applied, i.e. their
+ * literals must not have been reordered yet (see ExecutionPlanFileTransformer).  The candidate orders of
+ * each version of a clause are the order the literal reordering would choose, the order scanning its delta
+ * relation first if the version is recursive, and the orders chosen by several SIPS metrics.  Each round
+ * evaluates the program in a separate process, invoked with the given arguments, with the next candidate
+ * order of each version, and the profile of this evaluation times the candidates.
+ *
+ * An existing plan file keeps the plans of the clauses whose plans the search does not replace, and these
+ * plans apply to the evaluations timing the candidates.
+ */
+void searchExecutionPlans(const TranslationUnit& translationUnit, const std::string& souffleExecutable,
+        const std::vector<std::string>& arguments);
+
+}  // namespace souffle::ast::transform
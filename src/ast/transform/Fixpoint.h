@@ -22,6 +22,7 @@
 #include "ast/transform/Null.h"
 #include "ast/transform/Transformer.h"
 #include "souffle/utility/MiscUtil.h"
+#include <cstddef>
 #include <memory>
 #include <set>
 #include <string>
@@ -75,8 +76,13 @@ private:
 
     bool transform(TranslationUnit& translationUnit) override {
         bool changed = false;
+        std::size_t iterations = 1;
         while (applySubtransformer(translationUnit, transformer.get())) {
             changed = true;
+            ++iterations;
+        }
+        if (auto* profile = translationUnit.getTransformerProfile()) {
+            profile->setIterations(iterations);
         }
         return changed;
     }
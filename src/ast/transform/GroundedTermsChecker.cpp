@@ -25,8 +25,11 @@
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
 #include "reports/ErrorReport.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <cstddef>
 #include <map>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -34,12 +37,18 @@ namespace souffle::ast::transform {
 
 void GroundedTermsChecker::verify(TranslationUnit& translationUnit) {
     auto&& program = translationUnit.getProgram();
-    auto&& report = translationUnit.getErrorReport();
+    const std::vector<Clause*> clauses = program.getClauses();
 
     // -- check grounded variables and records --
-    visit(program, [&](const Clause& clause) {
-        if (isFact(clause)) return;  // only interested in rules
+    // Clauses are checked in parallel, each reporting to its own report; as diagnostics are ordered by
+    // their locations, the merged report does not depend on the order of the checks.
+    std::vector<ErrorReport> reports(clauses.size());
+    PARALLEL_START
+    pfor(std::size_t i = 0; i < clauses.size(); i++) {
+        const Clause& clause = *clauses[i];
+        if (isFact(clause)) continue;  // only interested in rules
 
+        auto& report = reports[i];
         auto isGrounded = analysis::getGroundedTerms(translationUnit, clause);
 
         std::set<std::string> reportedVars;
@@ -63,7 +72,12 @@ void GroundedTermsChecker::verify(TranslationUnit& translationUnit) {
                 report.addError("Ungrounded ADT branch", adt.getSrcLoc());
             }
         });
-    });
+    }
+    PARALLEL_END
+
+    for (const auto& report : reports) {
+        translationUnit.getErrorReport().addDiagnostics(report);
+    }
 }
 
 }  // namespace souffle::ast::transform
@@ -26,6 +26,7 @@
 #include "ast/Clause.h"
 #include "ast/Constant.h"
 #include "ast/Constraint.h"
+#include "ast/Counter.h"
 #include "ast/Functor.h"
 #include "ast/IntrinsicFunctor.h"
 #include "ast/Literal.h"
@@ -36,20 +37,29 @@
 #include "ast/QualifiedName.h"
 #include "ast/RecordInit.h"
 #include "ast/Relation.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/TypeCast.h"
 #include "ast/UnnamedVariable.h"
 #include "ast/UserDefinedFunctor.h"
 #include "ast/Variable.h"
+#include "ast/analysis/Ground.h"
+#include "ast/analysis/IOType.h"
+#include "ast/analysis/ProfileUse.h"
+#include "ast/analysis/SCCGraph.h"
 #include "ast/analysis/typesystem/PolymorphicObjects.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
+#include "reports/ErrorReport.h"
 #include "souffle/BinaryConstraintOps.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StringUtil.h"
+#include "souffle/utility/tinyformat.h"
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <iostream>
+#include <map>
 #include <memory>
 #include <optional>
 #include <ostream>
@@ -1008,6 +1018,249 @@ std::vector<Clause*> getInlinedClause(Program& program, const Clause& clause) {
     }
 }
 
+/** Relations with more clauses are not inlined automatically, as their using clause is copied per clause */
+constexpr std::size_t MAX_AUTO_INLINED_CLAUSES = 4;
+
+/** Clauses that inlining may produce from one clause with `inline-auto`, unless `inline-limit` is given */
+constexpr std::size_t DEFAULT_INLINE_LIMIT = 10000;
+
+/**
+ * Estimate the number of clauses that inlining produces from the given clause: the product of the
+ * numbers of versions of its inlined atoms, where negated atoms are counted like positive ones.
+ * The estimate saturates at `limit + 1`.
+ */
+std::size_t countInlinedVersions(const Program& program, const std::vector<Literal*>& body, std::size_t limit,
+        std::map<const Relation*, std::size_t>& relationVersions) {
+    auto multiply = [&](std::size_t a, std::size_t b) {
+        return (b != 0 && a > (limit + 1) / b) ? limit + 1 : std::min(a * b, limit + 1);
+    };
+
+    std::size_t versions = 1;
+    visit(body, [&](const Atom& atom) {
+        const Relation* rel = program.getRelation(atom);
+        if (rel == nullptr || !rel->hasQualifier(RelationQualifier::INLINE)) {
+            return;
+        }
+        auto it = relationVersions.find(rel);
+        if (it == relationVersions.end()) {
+            // inlined relations are not recursive, the entry only guards against malformed programs
+            it = relationVersions.insert({rel, 1}).first;
+            std::size_t sum = 0;
+            for (auto&& clause : program.getClauses(*rel)) {
+                const auto& body = clause->getBodyLiterals();
+                sum = std::min(sum + countInlinedVersions(program, body, limit, relationVersions), limit + 1);
+            }
+            it->second = sum;
+        }
+        versions = multiply(versions, it->second);
+    });
+    return versions;
+}
+
+/** Check whether all variables of a clause are grounded, so that its relation can be materialised */
+bool isGroundedClause(const TranslationUnit& translationUnit, const Clause& clause) {
+    auto isGrounded = analysis::getGroundedTerms(translationUnit, clause);
+    bool grounded = true;
+    visit(clause, [&](const Variable& var) { grounded &= isGrounded[&var]; });
+    return grounded;
+}
+
+/**
+ * Mark cheap intermediate relations as inlined, if requested by `inline-auto`.
+ *
+ * A relation is inlined if it is used once, by a positive atom outside of aggregates, is not
+ * recursive, IO, nullary, or otherwise special, and has few clauses without counters or aggregates.
+ * Materialising such a relation only adds the maintenance of its tuples and indexes, unless its
+ * clauses project away variables, in which case the materialised relation may be much smaller
+ * than the join computing it; these are only inlined if the profile shows that it is not. If the
+ * use is in a recursive clause, the inlined body is evaluated in every iteration, so only
+ * relations computed by a single atom are inlined.
+ */
+bool inlineCheapRelations(TranslationUnit& translationUnit) {
+    Program& program = translationUnit.getProgram();
+    const auto& ioTypes = translationUnit.getAnalysis<analysis::IOTypeAnalysis>();
+    const auto& sccGraph = translationUnit.getAnalysis<analysis::SCCGraphAnalysis>();
+    const auto& profileUse = translationUnit.getAnalysis<analysis::ProfileUseAnalysis>();
+    const auto excluded = InlineRelationsTransformer::excluded();
+    const bool verbose = Global::config().has("verbose");
+
+    auto isRecursive = [&](const Relation* rel) { return sccGraph.isRecursive(sccGraph.getSCC(rel)); };
+
+    // Find the clauses using each relation, and the relations used elsewhere
+    std::map<const Relation*, std::vector<const Clause*>> uses;
+    std::set<const Relation*> otherUses;
+    for (const Clause* clause : program.getClauses()) {
+        for (const Literal* literal : clause->getBodyLiterals()) {
+            if (const auto* atom = as<Atom>(literal)) {
+                uses[program.getRelation(*atom)].push_back(clause);
+            }
+        }
+    }
+    visit(program,
+            [&](const Negation& negation) { otherUses.insert(program.getRelation(*negation.getAtom())); });
+    visit(program, [&](const Aggregator& aggregator) {
+        visit(aggregator, [&](const Atom& atom) { otherUses.insert(program.getRelation(atom)); });
+    });
+
+    auto isCandidate = [&](const Relation* rel) {
+        const auto& qualifiers = rel->getQualifiers();
+        if (std::any_of(qualifiers.begin(), qualifiers.end(),
+                    [](RelationQualifier q) { return q != RelationQualifier::SUPPRESSED; })) {
+            return false;
+        }
+        if (rel->getRepresentation() != RelationRepresentation::DEFAULT &&
+                rel->getRepresentation() != RelationRepresentation::BTREE) {
+            return false;
+        }
+        if (ioTypes.isIO(rel) || ioTypes.isLimitSize(rel) || contains(excluded, rel->getQualifiedName()) ||
+                rel->getArity() == 0 || !rel->getFunctionalDependencies().empty() || isRecursive(rel) ||
+                contains(otherUses, rel)) {
+            return false;
+        }
+        auto it = uses.find(rel);
+        if (it == uses.end() || it->second.size() != 1) {
+            return false;
+        }
+        // inlining changes the atoms an execution plan refers to
+        const Clause* use = it->second.front();
+        if (use->getExecutionPlan() != nullptr || isA<SubsumptiveClause>(use)) {
+            return false;
+        }
+        bool hasCounter = false;
+        visit(*use, [&](const Atom& atom) {
+            if (program.getRelation(atom) == rel) {
+                visit(atom, [&](const Counter&) { hasCounter = true; });
+            }
+        });
+
+        const auto clauses = program.getClauses(*rel);
+        if (hasCounter || clauses.empty() || clauses.size() > MAX_AUTO_INLINED_CLAUSES) {
+            return false;
+        }
+        const bool recursiveUse = isRecursive(program.getRelation(*use));
+        for (const Clause* clause : clauses) {
+            if (isA<SubsumptiveClause>(clause)) {
+                return false;
+            }
+            bool unsupported = false;
+            visit(*clause, [&](const Counter&) { unsupported = true; });
+            visit(*clause, [&](const Aggregator&) { unsupported = true; });
+            if (unsupported) {
+                return false;
+            }
+
+            std::size_t atoms = 0;
+            std::size_t largestAtom = 0;
+            bool knownSizes = profileUse.hasRelationSize(rel->getQualifiedName());
+            for (const Literal* literal : clause->getBodyLiterals()) {
+                if (const auto* atom = as<Atom>(literal)) {
+                    ++atoms;
+                    knownSizes &= profileUse.hasRelationSize(atom->getQualifiedName());
+                    largestAtom = std::max(largestAtom, profileUse.getRelationSize(atom->getQualifiedName()));
+                }
+            }
+            if (recursiveUse && atoms > 1) {
+                return false;
+            }
+
+            // a projection deduplicates the tuples of the join computing them
+            std::set<std::string> headVariables;
+            visit(*clause->getHead(), [&](const Variable& var) { headVariables.insert(var.getName()); });
+            bool projects = false;
+            visit(clause->getBodyLiterals(),
+                    [&](const Variable& var) { projects |= !contains(headVariables, var.getName()); });
+            if (projects && (!knownSizes || 2 * profileUse.getRelationSize(rel->getQualifiedName()) <
+                                                    largestAtom)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    bool changed = false;
+    for (Relation* rel : program.getRelations()) {
+        if (isCandidate(rel)) {
+            rel->addQualifier(RelationQualifier::INLINE);
+            changed = true;
+            if (verbose) {
+                std::cout << "Inlining relation " << rel->getQualifiedName() << " ("
+                          << program.getClauses(*rel).size() << " clauses, used once)" << std::endl;
+            }
+        }
+    }
+    return changed;
+}
+
+/**
+ * Materialise inlined relations whose inlining would produce more than `inline-limit` clauses from
+ * a single clause.
+ *
+ * The cap only applies with `inline-auto` or an explicit `inline-limit`, so that the relations
+ * declared inline are otherwise always inlined. The relation with the most versions is
+ * materialised first, as long as its clauses are grounded on their own; each decision is reported
+ * as a warning.
+ */
+bool capInlining(TranslationUnit& translationUnit) {
+    if (!Global::config().has("inline-auto") && !Global::config().has("inline-limit")) {
+        return false;
+    }
+    Program& program = translationUnit.getProgram();
+    const std::size_t limit = Global::config().has("inline-limit")
+                                      ? std::stoul(Global::config().get("inline-limit"))
+                                      : DEFAULT_INLINE_LIMIT;
+
+    bool changed = false;
+    std::set<const Relation*> required;
+    while (true) {
+        std::map<const Relation*, std::size_t> relationVersions;
+
+        // Find the inlined relation with the most versions used by a clause producing too many clauses
+        const Relation* largest = nullptr;
+        const Clause* largestUse = nullptr;
+        std::size_t largestVersions = 0;
+        for (const Clause* clause : program.getClauses()) {
+            const Relation* head = program.getRelation(*clause);
+            if (head == nullptr || head->hasQualifier(RelationQualifier::INLINE) ||
+                    countInlinedVersions(program, clause->getBodyLiterals(), limit, relationVersions) <=
+                            limit) {
+                continue;
+            }
+            visit(clause->getBodyLiterals(), [&](const Atom& atom) {
+                const Relation* rel = program.getRelation(atom);
+                if (rel == nullptr || !contains(relationVersions, rel) || contains(required, rel)) {
+                    return;
+                }
+                if (largest == nullptr || relationVersions[rel] > largestVersions) {
+                    largest = rel;
+                    largestUse = clause;
+                    largestVersions = relationVersions[rel];
+                }
+            });
+        }
+        if (largest == nullptr) {
+            break;
+        }
+
+        // An inlined relation may be ungrounded on its own, and then has to stay inlined
+        auto clauses = program.getClauses(*largest);
+        if (!std::all_of(clauses.begin(), clauses.end(),
+                    [&](const Clause* clause) { return isGroundedClause(translationUnit, *clause); })) {
+            required.insert(largest);
+            continue;
+        }
+
+        Relation* rel = program.getRelation(largest->getQualifiedName());
+        rel->removeQualifier(RelationQualifier::INLINE);
+        translationUnit.getErrorReport().addWarning(
+                tfm::format("Relation %s is not inlined, as inlining would produce more than %d clauses for "
+                            "a clause of %s",
+                        rel->getQualifiedName(), limit, largestUse->getHead()->getQualifiedName()),
+                rel->getSrcLoc());
+        changed = true;
+    }
+    return changed;
+}
+
 ExcludedRelations InlineRelationsTransformer::excluded() {
     ExcludedRelations xs;
     auto addAll = [&](const std::string& name) {
@@ -1024,6 +1277,13 @@ bool InlineRelationsTransformer::transform(TranslationUnit& translationUnit) {
     bool changed = false;
     Program& program = translationUnit.getProgram();
 
+    // Decide which relations to inline: add cheap intermediate relations, then materialise relations
+    // whose inlining would explode
+    if (Global::config().has("inline-auto") && !Global::config().has("provenance")) {
+        changed |= inlineCheapRelations(translationUnit);
+    }
+    changed |= capInlining(translationUnit);
+
     // Replace constants in the head of inlined clauses with (constrained) variables.
     // This is done to simplify atom unification, particularly when negations are involved.
     changed |= normaliseInlinedHeads(program);
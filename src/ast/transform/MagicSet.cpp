@@ -29,13 +29,16 @@
 #include "ast/RecordInit.h"
 #include "ast/Relation.h"
 #include "ast/StringConstant.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/UnnamedVariable.h"
 #include "ast/analysis/IOType.h"
 #include "ast/analysis/PrecedenceGraph.h"
+#include "ast/analysis/ProfileUse.h"
 #include "ast/analysis/SCCGraph.h"
 #include "ast/analysis/typesystem/PolymorphicObjects.h"
 #include "ast/utility/BindingStore.h"
+#include "ast/utility/SipsMetric.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
 #include "parser/SrcLocation.h"
@@ -86,6 +89,67 @@ std::set<QualifiedName> MagicSetTransformer::getTriviallyIgnoredRelations(const
     return triviallyIgnoredRelations;
 }
 
+std::set<QualifiedName> MagicSetTransformer::getProfitableRelations(const TranslationUnit& tu) {
+    const auto& program = tu.getProgram();
+    const auto& profileUse = tu.getAnalysis<analysis::ProfileUseAnalysis>();
+    const auto& triviallyIgnoredRelations = getTriviallyIgnoredRelations(tu);
+    auto sips = SipsMetric::create(
+            Global::config().has("SIPS") ? Global::config().get("SIPS") : "all-bound", tu);
+
+    // Bindings from a preceding atom are selective if it is this many times smaller than the bound atom
+    constexpr std::size_t selectivityRatio = 10;
+
+    // - Relations bound by constants or by much smaller relations in bottom-up evaluation
+    std::set<QualifiedName> profitableRelations;
+    for (const auto* clause : program.getClauses()) {
+        const BindingStore constantBindings(clause);
+        BindingStore atomBindings(clause);
+        const auto& atoms = getBodyLiterals<Atom>(*clause);
+
+        std::optional<std::size_t> smallestBinder;
+        for (unsigned int i : sips->getReordering(clause)) {
+            const auto* atom = atoms[i];
+            const auto& name = atom->getQualifiedName();
+            if (!contains(triviallyIgnoredRelations, name)) {
+                bool boundByConstant = false;
+                bool boundByAtom = false;
+                for (const auto* arg : atom->getArguments()) {
+                    boundByConstant |= constantBindings.isBound(arg);
+                    boundByAtom |= atomBindings.isBound(arg);
+                }
+                bool selectiveBinder = smallestBinder.has_value() && profileUse.hasRelationSize(name) &&
+                                       *smallestBinder * selectivityRatio <= profileUse.getRelationSize(name);
+                if (boundByConstant || (boundByAtom && selectiveBinder)) {
+                    profitableRelations.insert(name);
+                }
+            }
+
+            if (profileUse.hasRelationSize(name)) {
+                std::size_t size = profileUse.getRelationSize(name);
+                smallestBinder = std::min(smallestBinder.value_or(size), size);
+            } else {
+                smallestBinder = std::nullopt;
+            }
+            visit(*atom, [&](const ast::Variable& var) { atomBindings.bindVariableStrongly(var.getName()); });
+        }
+    }
+
+    // - Relations the profitable relations depend on, as the bindings are passed on to them
+    std::vector<QualifiedName> toVisit(profitableRelations.begin(), profitableRelations.end());
+    while (!toVisit.empty()) {
+        auto relName = toVisit.back();
+        toVisit.pop_back();
+        visit(program.getClauses(relName), [&](const Atom& atom) {
+            const auto& name = atom.getQualifiedName();
+            if (!contains(triviallyIgnoredRelations, name) && profitableRelations.insert(name).second) {
+                toVisit.push_back(name);
+            }
+        });
+    }
+
+    return profitableRelations;
+}
+
 std::set<QualifiedName> MagicSetTransformer::getWeaklyIgnoredRelations(const TranslationUnit& tu) {
     const auto& program = tu.getProgram();
     const auto& precedenceGraph = tu.getAnalysis<analysis::PrecedenceGraphAnalysis>().graph();
@@ -105,6 +169,13 @@ std::set<QualifiedName> MagicSetTransformer::getWeaklyIgnoredRelations(const Tra
         specifiedRelations.insert(QualifiedName(qualifiers));
     }
 
+    // Pick up relations for which the MST is expected to pay off
+    if (Global::config().has("magic-transform-auto")) {
+        for (const auto& relName : getProfitableRelations(tu)) {
+            specifiedRelations.insert(relName);
+        }
+    }
+
     // Pick up specified relations and ignored relations from relation tags
     for (const auto* rel : program.getRelations()) {
         if (rel->hasQualifier(RelationQualifier::MAGIC)) {
@@ -280,7 +351,7 @@ std::set<QualifiedName> MagicSetTransformer::getRelationsToNotLabel(const Transl
 
 bool MagicSetTransformer::shouldRun(const TranslationUnit& tu) {
     const Program& program = tu.getProgram();
-    if (Global::config().has("magic-transform")) return true;
+    if (Global::config().has("magic-transform") || Global::config().has("magic-transform-auto")) return true;
     for (const auto* rel : program.getRelations()) {
         if (rel->hasQualifier(RelationQualifier::MAGIC)) return true;
     }
@@ -291,20 +362,28 @@ bool NormaliseDatabaseTransformer::transform(TranslationUnit& translationUnit) {
     bool changed = false;
 
     /** (1) Partition input and output relations */
-    changed |= partitionIO(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (partitionIO(translationUnit)) {
+        translationUnit.invalidateAnalyses();
+        changed = true;
+    }
 
     /** (2) Separate the IDB from the EDB */
-    changed |= extractIDB(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (extractIDB(translationUnit)) {
+        translationUnit.invalidateAnalyses();
+        changed = true;
+    }
 
     /** (3) Normalise arguments within each clause */
-    changed |= normaliseArguments(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (normaliseArguments(translationUnit)) {
+        translationUnit.invalidateAnalyses();
+        changed = true;
+    }
 
     /** (4) Querify output relations */
-    changed |= querifyOutputRelations(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    if (querifyOutputRelations(translationUnit)) {
+        translationUnit.invalidateAnalyses();
+        changed = true;
+    }
 
     return changed;
 }
@@ -617,9 +696,28 @@ QualifiedName AdornDatabaseTransformer::getAdornmentID(
     return adornmentID;
 }
 
-Own<Clause> AdornDatabaseTransformer::adornClause(const Clause* clause, const std::string& adornmentMarker) {
-    const auto& relName = clause->getHead()->getQualifiedName();
-    const auto& headArgs = clause->getHead()->getArguments();
+Own<Clause> AdornDatabaseTransformer::adornClause(
+        const Clause* originalClause, const std::string& adornmentMarker) {
+    const auto& relName = originalClause->getHead()->getQualifiedName();
+    const auto& headArgs = originalClause->getHead()->getArguments();
+
+    // With `magic-transform-auto`, pass the bindings through the atoms in the order chosen by the SIPS,
+    // given the bound head arguments; clauses with plans or atoms whose position the ignored relations
+    // depend on are kept
+    const Clause* clause = originalClause;
+    Own<Clause> reorderedClause;
+    if (sips != nullptr && clause->getExecutionPlan() == nullptr && !isA<SubsumptiveClause>(clause) &&
+            !visitExists(clause->getBodyLiterals(),
+                    [&](const Atom& atom) { return contains(orderedRelations, atom.getQualifiedName()); })) {
+        BindingStore headBindings(clause);
+        for (std::size_t i = 0; i < adornmentMarker.length(); i++) {
+            if (adornmentMarker[i] == 'b') {
+                headBindings.bindVariableWeakly(as<ast::Variable>(headArgs[i])->getName());
+            }
+        }
+        reorderedClause = Own<Clause>(reorderAtoms(clause, sips->getReordering(clause, headBindings)));
+        clause = reorderedClause.get();
+    }
     BindingStore variableBindings(clause);
 
     /* Note that variables can be bound through:
@@ -722,6 +820,17 @@ bool AdornDatabaseTransformer::transform(TranslationUnit& translationUnit) {
     Program& program = translationUnit.getProgram();
     const auto& ioTypes = translationUnit.getAnalysis<analysis::IOTypeAnalysis>();
     weaklyIgnoredRelations = getWeaklyIgnoredRelations(translationUnit);
+    const std::string sipsName = Global::config().has("SIPS") ? Global::config().get("SIPS") : "all-bound";
+    sips = Global::config().has("magic-transform-auto") ? SipsMetric::create(sipsName, translationUnit)
+                                                        : nullptr;
+
+    // Weakly ignoring relations after those depending on strongly ignored relations relies on the order
+    const auto& precedenceGraph = translationUnit.getAnalysis<analysis::PrecedenceGraphAnalysis>().graph();
+    orderedRelations = getStronglyIgnoredRelations(translationUnit);
+    for (const auto& relName : getStronglyIgnoredRelations(translationUnit)) {
+        precedenceGraph.visit(program.getRelation(relName),
+                [&](const auto* dependentRel) { orderedRelations.insert(dependentRel->getQualifiedName()); });
+    }
 
     // Output relations trigger the adornment process
     for (const auto* rel : program.getRelations()) {
@@ -23,6 +23,7 @@
 #include "ast/transform/Pipeline.h"
 #include "ast/transform/RemoveRedundantRelations.h"
 #include "ast/transform/Transformer.h"
+#include "ast/utility/SipsMetric.h"
 #include "souffle/utility/ContainerUtil.h"
 #include <algorithm>
 #include <cassert>
@@ -82,6 +83,14 @@ private:
      */
     static std::set<QualifiedName> getTriviallyIgnoredRelations(const TranslationUnit& tu);
 
+    /**
+     * Gets the set of relations for which the MST is expected to pay off, if `magic-transform-auto` is
+     * set: relations used in a clause where one of their arguments is bound by a constant before the
+     * atom is evaluated, or by a preceding atom that the profile shows to be much smaller, together with
+     * the relations they depend on, which receive the bindings.
+     */
+    static std::set<QualifiedName> getProfitableRelations(const TranslationUnit& tu);
+
     /**
      * Gets the set of relations to weakly ignore during the MST process.
      * Weakly-ignored relations cannot be adorned/magic'd.
@@ -244,6 +253,12 @@ private:
     std::set<QualifiedName> headAdornmentsSeen;
     std::set<QualifiedName> weaklyIgnoredRelations;
 
+    /** SIPS choosing the order in which the atoms of an adorned clause bind their variables, if any */
+    Own<SipsMetric> sips;
+
+    /** Relations whose atoms keep their position, as the ignored relations depend on it */
+    std::set<QualifiedName> orderedRelations;
+
     bool transform(TranslationUnit& translationUnit) override;
 
     /** Get the unique identifier corresponding to an adorned predicate. */
@@ -17,19 +17,27 @@
 #include "ast/transform/Meta.h"
 #include "souffle/utility/MiscUtil.h"
 #include <chrono>
+#include <cstddef>
 #include <iostream>
 
 namespace souffle::ast::transform {
 
 bool MetaTransformer::applySubtransformer(TranslationUnit& translationUnit, Transformer* transformer) {
+    const auto& statistics = translationUnit.getAnalysisStatistics();
+    const std::size_t computedBefore = statistics.computed;
+    const std::size_t preservedBefore = statistics.preserved;
+    const auto timeBefore = statistics.time;
     auto start = std::chrono::high_resolution_clock::now();
     bool changed = transformer->apply(translationUnit);
     auto end = std::chrono::high_resolution_clock::now();
 
     if (verbose && (!isA<MetaTransformer>(transformer))) {
+        // the time spent computing analyses, and the number of analyses spared by the transformer
         std::string changedString = changed ? "changed" : "unchanged";
         std::cout << transformer->getName() << " time: " << std::chrono::duration<double>(end - start).count()
-                  << "sec [" << changedString << "]" << std::endl;
+                  << "sec [" << changedString << "] analyses: " << (statistics.time - timeBefore).count()
+                  << "sec [" << statistics.computed - computedBefore << " computed, "
+                  << statistics.preserved - preservedBefore << " preserved]" << std::endl;
     }
 
     return changed;
@@ -262,15 +262,17 @@ bool MinimiseProgramTransformer::reduceLocallyEquivalentClauses(TranslationUnit&
     // split up each relation's rules into equivalence classes
     // TODO (azreika): consider turning this into an ast analysis instead
     for (Relation* rel : program.getRelations()) {
-        std::vector<std::vector<Clause*>> equivalenceClasses;
+        // only clauses with the same fingerprint can be equivalent
+        std::map<std::size_t, std::vector<std::vector<Clause*>>> equivalenceClassesByFingerprint;
 
         for (auto&& cl : program.getClauses(*rel)) {
             auto* clause = &*cl;
+            const auto& normedClause = normalisations.getNormalisation(clause);
+            auto& equivalenceClasses = equivalenceClassesByFingerprint[normedClause.getFingerprint()];
             bool added = false;
 
             for (std::vector<Clause*>& eqClass : equivalenceClasses) {
                 const auto& normedRep = normalisations.getNormalisation(eqClass[0]);
-                const auto& normedClause = normalisations.getNormalisation(clause);
                 if (areBijectivelyEquivalent(normedRep, normedClause)) {
                     // clause belongs to an existing equivalence class, so delete it
                     eqClass.push_back(clause);
@@ -302,35 +304,40 @@ bool MinimiseProgramTransformer::reduceSingletonRelations(TranslationUnit& trans
     const auto& ioTypes = translationUnit.getAnalysis<analysis::IOTypeAnalysis>();
     const auto& normalisations = translationUnit.getAnalysis<analysis::ClauseNormalisationAnalysis>();
 
-    // Find all singleton relations to consider
-    std::vector<Clause*> singletonRelationClauses;
+    // Find all singleton relations to consider, grouped by the fingerprints of their clauses
+    // Note: only clauses with the same fingerprint can be equivalent
+    std::map<std::size_t, std::vector<Clause*>> singletonRelationClauses;
     for (Relation* rel : program.getRelations()) {
         if (ioTypes.isIO(rel)) continue;
 
         auto clauses = program.getClauses(*rel);
         if (clauses.size() == 1) {
-            singletonRelationClauses.push_back(&*clauses[0]);
+            const auto& normedClause = normalisations.getNormalisation(&*clauses[0]);
+            singletonRelationClauses[normedClause.getFingerprint()].push_back(&*clauses[0]);
         }
     }
 
     // Keep track of canonical relation name for each redundant clause
     std::map<QualifiedName, QualifiedName> canonicalName;
 
-    // Check pairwise equivalence of each singleton relation
-    for (std::size_t i = 0; i < singletonRelationClauses.size(); i++) {
-        const auto* first = singletonRelationClauses[i];
-        // an earlier clause may have been found to be bijective with this one. no need to reprocess it.
-        if (contains(canonicalName, ast::getName(*first))) continue;
-
-        for (std::size_t j = i + 1; j < singletonRelationClauses.size(); j++) {
-            const auto* second = singletonRelationClauses[j];
-
-            // Note: Bijective-equivalence check does not care about the head relation name
-            const auto& normedFirst = normalisations.getNormalisation(first);
-            const auto& normedSecond = normalisations.getNormalisation(second);
-            if (areBijectivelyEquivalent(normedFirst, normedSecond) &&
-                    areEquivalentRelations(program.getRelation(*first), program.getRelation(*second))) {
-                canonicalName.insert({ast::getName(*second), ast::getName(*first)});
+    // Check pairwise equivalence of the singleton relations with the same fingerprint
+    for (const auto& [_, clauses] : singletonRelationClauses) {
+        for (std::size_t i = 0; i < clauses.size(); i++) {
+            const auto* first = clauses[i];
+            // an earlier clause may have been found to be bijective with this one. no need to reprocess it.
+            if (contains(canonicalName, ast::getName(*first))) continue;
+
+            for (std::size_t j = i + 1; j < clauses.size(); j++) {
+                const auto* second = clauses[j];
+
+                // Note: Bijective-equivalence check does not care about the head relation name
+                const auto& normedFirst = normalisations.getNormalisation(first);
+                const auto& normedSecond = normalisations.getNormalisation(second);
+                if (areBijectivelyEquivalent(normedFirst, normedSecond) &&
+                        areEquivalentRelations(
+                                program.getRelation(*first), program.getRelation(*second))) {
+                    canonicalName.insert({ast::getName(*second), ast::getName(*first)});
+                }
             }
         }
     }
@@ -407,12 +414,13 @@ bool MinimiseProgramTransformer::reduceClauseBodies(TranslationUnit& translation
 
 bool MinimiseProgramTransformer::transform(TranslationUnit& translationUnit) {
     bool changed = false;
-    changed |= reduceClauseBodies(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
-    changed |= removeRedundantClauses(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
-    changed |= reduceLocallyEquivalentClauses(translationUnit);
-    if (changed) translationUnit.invalidateAnalyses();
+    // analyses are only stale after a step that changed the program
+    for (auto step : {reduceClauseBodies, removeRedundantClauses, reduceLocallyEquivalentClauses}) {
+        if (step(translationUnit)) {
+            translationUnit.invalidateAnalyses();
+            changed = true;
+        }
+    }
     changed |= reduceSingletonRelations(translationUnit);
     return changed;
 }
@@ -20,6 +20,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -35,6 +36,10 @@ public:
         return "NameUnnamedVariablesTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return getClauseRewriteAnalyses();
+    }
+
 private:
     NameUnnamedVariablesTransformer* cloning() const override {
         return new NameUnnamedVariablesTransformer();
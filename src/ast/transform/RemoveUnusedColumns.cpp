@@ -0,0 +1,311 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file RemoveUnusedColumns.cpp
+ *
+ * Implementation of the transformation pass removing the columns of
+ * relations that no clause reads.
+ *
+ ***********************************************************************/
+
+#include "ast/transform/RemoveUnusedColumns.h"
+#include "Global.h"
+#include "RelationTag.h"
+#include "ast/Aggregator.h"
+#include "ast/Argument.h"
+#include "ast/Atom.h"
+#include "ast/Attribute.h"
+#include "ast/Clause.h"
+#include "ast/Node.h"
+#include "ast/Program.h"
+#include "ast/QualifiedName.h"
+#include "ast/Relation.h"
+#include "ast/SubsumptiveClause.h"
+#include "ast/TranslationUnit.h"
+#include "ast/UnnamedVariable.h"
+#include "ast/Variable.h"
+#include "ast/analysis/IOType.h"
+#include "ast/analysis/ProfileUse.h"
+#include "ast/analysis/SCCGraph.h"
+#include "ast/utility/NodeMapper.h"
+#include "ast/utility/Utils.h"
+#include "ast/utility/Visitor.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include "souffle/utility/tinyformat.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ast::transform {
+
+namespace {
+
+/** Projections of atoms onto some of their columns, given by the relation of the projected atom */
+using AtomProjections = std::map<const Atom*, std::pair<QualifiedName, std::set<std::size_t>>>;
+
+/** Node mapper replacing atoms by their projections */
+struct projectAtoms : public NodeMapper {
+    const AtomProjections& projections;
+
+    projectAtoms(const AtomProjections& projections) : projections(projections) {}
+
+    Own<Node> operator()(Own<Node> node) const override {
+        node->apply(*this);
+        if (auto* atom = as<Atom>(node)) {
+            auto projection = projections.find(atom);
+            if (projection != projections.end()) {
+                const auto& [name, columns] = projection->second;
+                const auto& arguments = atom->getArguments();
+                VecOwn<Argument> projected;
+                for (std::size_t column : columns) {
+                    projected.push_back(clone(arguments[column]));
+                }
+                return mk<Atom>(name, std::move(projected), atom->getSrcLoc());
+            }
+        }
+        return node;
+    }
+};
+
+/**
+ * Visit the atoms read by a clause, with the columns they use; the atoms in aggregates use all of them.
+ */
+void visitReaders(
+        const Clause& clause, const std::function<void(const Atom&, std::set<std::size_t>)>& visitor) {
+    std::map<std::string, std::size_t> occurrences;
+    visit(clause, [&](const Variable& var) { ++occurrences[var.getName()]; });
+
+    std::set<const Atom*> aggregated;
+    visit(clause, [&](const Aggregator& aggr) {
+        visit(aggr, [&](const Atom& atom) { aggregated.insert(&atom); });
+    });
+
+    visit(clause, [&](const Atom& atom) {
+        if (&atom == clause.getHead()) {
+            return;
+        }
+        const auto& arguments = atom.getArguments();
+        std::set<std::size_t> columns;
+        for (std::size_t i = 0; i < arguments.size(); ++i) {
+            const auto* var = as<Variable>(arguments[i]);
+            bool unconstrained = isA<UnnamedVariable>(arguments[i]) ||
+                                 (var != nullptr && occurrences[var->getName()] == 1);
+            if (!unconstrained || contains(aggregated, &atom)) {
+                columns.insert(i);
+            }
+        }
+        visitor(atom, std::move(columns));
+    });
+}
+
+/** The relations whose columns may be removed */
+std::set<const Relation*> getNarrowableRelations(const TranslationUnit& translationUnit) {
+    const Program& program = translationUnit.getProgram();
+    const auto& ioType = translationUnit.getAnalysis<analysis::IOTypeAnalysis>();
+
+    std::set<const Relation*> relations;
+    for (const Relation* rel : program.getRelations()) {
+        if (ioType.isIO(rel) || ioType.isLimitSize(rel) || !rel->getFunctionalDependencies().empty() ||
+                rel->getRepresentation() == RelationRepresentation::EQREL ||
+                rel->getRepresentation() == RelationRepresentation::BTREE_DELETE ||
+                rel->getRepresentation() == RelationRepresentation::INFO) {
+            continue;
+        }
+        const auto& clauses = program.getClauses(*rel);
+        if (std::any_of(clauses.begin(), clauses.end(),
+                    [](const Clause* clause) { return isA<SubsumptiveClause>(clause); })) {
+            continue;
+        }
+        relations.insert(rel);
+    }
+    return relations;
+}
+
+/** Prefix of the names of projected copies of relations */
+const std::string PROJECTION_PREFIX = "+?projection_";
+
+}  // namespace
+
+bool RemoveUnusedColumnsTransformer::removeUnusedColumns(TranslationUnit& translationUnit) {
+    Program& program = translationUnit.getProgram();
+    const auto& narrowable = getNarrowableRelations(translationUnit);
+
+    bool changed = false;
+    while (true) {
+        std::map<QualifiedName, std::set<std::size_t>> usedColumns;
+        for (const Clause* clause : program.getClauses()) {
+            visitReaders(*clause, [&](const Atom& atom, std::set<std::size_t> columns) {
+                usedColumns[atom.getQualifiedName()].merge(columns);
+            });
+        }
+
+        // the columns kept by each relation with unused columns
+        std::map<QualifiedName, std::set<std::size_t>> keptColumns;
+        for (const Relation* rel : narrowable) {
+            const auto& used = usedColumns[rel->getQualifiedName()];
+            if (used.size() < rel->getArity()) {
+                keptColumns[rel->getQualifiedName()] = used;
+            }
+        }
+        if (keptColumns.empty()) {
+            return changed;
+        }
+
+        for (const auto& [name, columns] : keptColumns) {
+            Relation* rel = program.getRelation(name);
+            const auto& attributes = rel->getAttributes();
+            VecOwn<Attribute> kept;
+            for (std::size_t column : columns) {
+                kept.push_back(clone(attributes[column]));
+            }
+            rel->setAttributes(std::move(kept));
+        }
+
+        AtomProjections projections;
+        visit(program, [&](const Atom& atom) {
+            auto columns = keptColumns.find(atom.getQualifiedName());
+            if (columns != keptColumns.end()) {
+                projections[&atom] = {atom.getQualifiedName(), columns->second};
+            }
+        });
+        program.apply(projectAtoms(projections));
+        changed = true;
+    }
+}
+
+bool RemoveUnusedColumnsTransformer::projectReaders(TranslationUnit& translationUnit) {
+    Program& program = translationUnit.getProgram();
+    const auto& sccGraph = translationUnit.getAnalysis<analysis::SCCGraphAnalysis>();
+    const auto& profileUse = translationUnit.getAnalysis<analysis::ProfileUseAnalysis>();
+    const auto& narrowable = getNarrowableRelations(translationUnit);
+
+    // the readers of relations in later strata using some but not all of their columns, which are scanned,
+    // i.e. positive atoms binding a variable that no other atom of their clause binds; the others are
+    // negations or existence checks, which do not iterate over the duplicates of the columns they use
+    struct Reader {
+        const Atom* atom;
+        std::set<std::size_t> columns;
+        bool joined;
+    };
+    std::vector<Reader> readers;
+    std::map<std::pair<QualifiedName, std::set<std::size_t>>, std::size_t> numReaders;
+    for (const Clause* clause : program.getClauses()) {
+        const Relation* head = program.getRelation(*clause);
+        if (isA<SubsumptiveClause>(clause) ||
+                isPrefix(PROJECTION_PREFIX, toString(head->getQualifiedName()))) {
+            continue;
+        }
+        const auto& atoms = getBodyLiterals<Atom>(*clause);
+        visitReaders(*clause, [&](const Atom& atom, std::set<std::size_t> columns) {
+            const Relation* rel = program.getRelation(atom);
+            if (std::find(atoms.begin(), atoms.end(), &atom) == atoms.end() || !contains(narrowable, rel) ||
+                    sccGraph.getSCC(rel) == sccGraph.getSCC(head) || columns.empty() ||
+                    columns.size() == rel->getArity()) {
+                return;
+            }
+
+            std::set<std::string> bound;
+            for (const Atom* other : atoms) {
+                if (other != &atom) {
+                    visit(*other, [&](const Variable& var) { bound.insert(var.getName()); });
+                }
+            }
+            const auto& arguments = atom.getArguments();
+            if (std::none_of(columns.begin(), columns.end(), [&](std::size_t column) {
+                    const auto* var = as<Variable>(arguments[column]);
+                    return var != nullptr && !contains(bound, var->getName());
+                })) {
+                return;
+            }
+
+            ++numReaders[{rel->getQualifiedName(), columns}];
+            readers.push_back({&atom, std::move(columns), atoms.size() > 1});
+        });
+    }
+
+    // the projection has to be joined with further atoms, or be shared by several readers, to pay off
+    AtomProjections projections;
+    for (auto& [atom, columns, joined] : readers) {
+        const QualifiedName& name = atom->getQualifiedName();
+        if (!joined && numReaders[{name, columns}] < 2) {
+            continue;
+        }
+
+        // the projection has to drop duplicates to pay off, which the profile may tell
+        if (profileUse.hasDistinctValues(name) &&
+                2 * profileUse.getDistinctValues(name, columns) > profileUse.getRelationSize(name)) {
+            continue;
+        }
+
+        // the columns are enclosed in braces, which do not occur in the names of the relations of a program
+        // and only before the columns in the names of projections, so projections never share a name
+        const QualifiedName projection(
+                tfm::format("%s%s{%s}", PROJECTION_PREFIX, name, join(columns, ",")));
+        projections[atom] = {projection, std::move(columns)};
+    }
+    if (projections.empty()) {
+        return false;
+    }
+
+    // add each projected copy of a relation
+    std::set<QualifiedName> added;
+    for (const auto& [atom, projection] : projections) {
+        const auto& [name, columns] = projection;
+        if (!added.insert(name).second) {
+            continue;
+        }
+        const Relation* rel = program.getRelation(*atom);
+        const auto& attributes = rel->getAttributes();
+        auto copy = mk<Relation>(name, rel->getSrcLoc());
+        auto head = mk<Atom>(name, VecOwn<Argument>(), rel->getSrcLoc());
+        auto body = mk<Atom>(rel->getQualifiedName(), VecOwn<Argument>(), rel->getSrcLoc());
+        for (std::size_t i = 0; i < rel->getArity(); ++i) {
+            if (contains(columns, i)) {
+                const std::string var = "@column_" + std::to_string(i);
+                copy->addAttribute(clone(attributes[i]));
+                head->addArgument(mk<Variable>(var));
+                body->addArgument(mk<Variable>(var));
+            } else {
+                body->addArgument(mk<UnnamedVariable>());
+            }
+        }
+        if (rel->getRepresentation() != RelationRepresentation::DEFAULT) {
+            copy->setRepresentation(rel->getRepresentation());
+        }
+        auto clause = mk<Clause>(std::move(head), rel->getSrcLoc());
+        clause->addToBody(std::move(body));
+        program.addRelation(std::move(copy));
+        program.addClause(std::move(clause));
+    }
+
+    program.apply(projectAtoms(projections));
+    return true;
+}
+
+bool RemoveUnusedColumnsTransformer::transform(TranslationUnit& translationUnit) {
+    // provenance explains the full tuples of relations
+    if (Global::config().has("provenance")) {
+        return false;
+    }
+    bool changed = removeUnusedColumns(translationUnit);
+    changed |= projectReaders(translationUnit);
+    return changed;
+}
+
+}  // namespace souffle::ast::transform
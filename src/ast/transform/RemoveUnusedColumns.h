@@ -0,0 +1,72 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file RemoveUnusedColumns.h
+ *
+ * Defines the transformation pass removing the columns of relations that
+ * no clause reads.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ast/TranslationUnit.h"
+#include "ast/transform/Transformer.h"
+#include <string>
+
+namespace souffle::ast::transform {
+
+/**
+ * Transformation pass narrowing the tuples of intermediate relations to the columns their readers use.
+ *
+ * A column of a relation is unused if every atom reading the relation leaves it unconstrained, i.e.
+ * holds an unnamed variable or a variable occurring nowhere else in its clause there.  Unused columns
+ * are removed from the relation and from all its atoms, until no more columns become unused, e.g.
+ *
+ *   .decl a(x:number, y:number)             .decl a(x:number)
+ *   a(x,y) :- b(x,y).                  =>   a(x) :- b(x,y).
+ *   c(x) :- a(x,_).                         c(x) :- a(x).
+ *
+ * Readers in later strata that use a proper subset of the columns of a relation then read a projected
+ * copy of the relation instead, so that they do not join the duplicates of the columns they ignore, e.g.
+ *
+ *   r(x,y) :- a(x,_), b(y), x < y.     =>   r(x,y) :- +?projection_a{0}(x), b(y), x < y.
+ *
+ * The copy only pays off for readers that are scanned, i.e. bind a variable no other atom of their clause
+ * binds, rather than negated or used as existence checks, and that are joined with further atoms or share
+ * the copy with other readers.  It is not made either if the profile given with `profile-use` shows that
+ * the columns they use hardly repeat.
+ *
+ * Atoms in aggregates read all columns, as aggregates range over tuples rather than distinct values.
+ * Relations whose tuples are observable or constrained are not narrowed, i.e. I/O relations and
+ * relations with a size limit, functional dependencies, subsumptive clauses or an equivalence relation
+ * representation.
+ */
+class RemoveUnusedColumnsTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "RemoveUnusedColumnsTransformer";
+    }
+
+private:
+    RemoveUnusedColumnsTransformer* cloning() const override {
+        return new RemoveUnusedColumnsTransformer();
+    }
+
+    bool transform(TranslationUnit& translationUnit) override;
+
+    /** Remove the columns of relations that no clause reads */
+    static bool removeUnusedColumns(TranslationUnit& translationUnit);
+
+    /** Replace the atoms reading a proper subset of the columns of a relation in a later stratum */
+    static bool projectReaders(TranslationUnit& translationUnit);
+};
+
+}  // namespace souffle::ast::transform
@@ -90,7 +90,7 @@ bool ReorderLiteralsTransformer::transform(TranslationUnit& translationUnit) {
     // --- profile-guided reordering ---
     if (Global::config().has("profile-use")) {
         // parse supplied profile information
-        auto profilerSips = SipsMetric::create("profiler", translationUnit);
+        auto profilerSips = SipsMetric::create("profile-use", translationUnit);
 
         // change the ordering of literals within clauses
         std::vector<Clause*> clausesToRemove;
@@ -19,6 +19,7 @@
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
 #include <functional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -37,6 +38,13 @@ public:
         return "ReorderLiteralsTransformer";
     }
 
+    /** The reordered clauses replace the original ones, but use the same relations */
+    std::set<std::string> getPreservedAnalyses() const override {
+        std::set<std::string> preserved = getRelationAnalyses();
+        preserved.merge(getTypeDeclarationAnalyses());
+        return preserved;
+    }
+
     /**
      * Reorder the clause based on a given SIPS function.
      * @param sipsFunction SIPS metric to use
@@ -75,6 +75,7 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/tinyformat.h"
@@ -109,14 +110,15 @@ private:
     const Program& program = tu.getProgram();
     ErrorReport& report = tu.getErrorReport();
 
-    void checkAtom(const Atom& atom);
-    void checkLiteral(const Literal& literal);
-    void checkAggregator(const Aggregator& aggregator);
-    bool isDependent(const Clause& agg1, const Clause& agg2);
-    void checkArgument(const Argument& arg);
+    // Clauses are checked in parallel, so their checks add diagnostics to the given report
+    void checkAtom(const Atom& atom, ErrorReport& report) const;
+    void checkLiteral(const Literal& literal, ErrorReport& report) const;
+    void checkAggregator(const Aggregator& aggregator, ErrorReport& report) const;
+    bool isDependent(const Clause& agg1, const Clause& agg2) const;
+    void checkArgument(const Argument& arg, ErrorReport& report) const;
     void checkConstant(const Argument& argument);
-    void checkFact(const Clause& fact);
-    void checkClause(const Clause& clause);
+    void checkFact(const Clause& fact, ErrorReport& report) const;
+    void checkClause(const Clause& clause, ErrorReport& report) const;
     void checkComplexRule(std::set<const Clause*> multiRule);
     void checkRelationDeclaration(const Relation& relation);
     void checkRelationFunctionalDependencies(const Relation& relation);
@@ -128,6 +130,8 @@ private:
     void checkIO();
     void checkWitnessProblem();
     void checkInlining();
+    void checkIncremental();
+    void checkProvenanceRelations();
 };
 
 bool SemanticChecker::transform(TranslationUnit& translationUnit) {
@@ -171,8 +175,17 @@ SemanticCheckerImpl::SemanticCheckerImpl(TranslationUnit& tu) : tu(tu) {
     for (auto* rel : program.getRelations()) {
         checkRelation(*rel);
     }
-    for (auto* clause : program.getClauses()) {
-        checkClause(*clause);
+    // Clauses are checked in parallel, each reporting to its own report; as diagnostics are ordered by
+    // their locations, the merged report does not depend on the order of the checks.
+    const std::vector<Clause*> clauses = program.getClauses();
+    std::vector<ErrorReport> clauseReports(clauses.size());
+    PARALLEL_START
+    pfor(std::size_t i = 0; i < clauses.size(); i++) {
+        checkClause(*clauses[i], clauseReports[i]);
+    }
+    PARALLEL_END
+    for (const auto& clauseReport : clauseReports) {
+        report.addDiagnostics(clauseReport);
     }
     for (auto* decl : program.getFunctorDeclarations()) {
         checkFunctorDeclaration(*decl);
@@ -196,6 +209,8 @@ SemanticCheckerImpl::SemanticCheckerImpl(TranslationUnit& tu) : tu(tu) {
     checkIO();
     checkWitnessProblem();
     checkInlining();
+    checkIncremental();
+    checkProvenanceRelations();
 
     // Run grounded terms checker
     GroundedTermsChecker().verify(tu);
@@ -235,7 +250,7 @@ SemanticCheckerImpl::SemanticCheckerImpl(TranslationUnit& tu) : tu(tu) {
     }
 }
 
-void SemanticCheckerImpl::checkAtom(const Atom& atom) {
+void SemanticCheckerImpl::checkAtom(const Atom& atom, ErrorReport& report) const {
     // check existence of relation
     auto* r = program.getRelation(atom);
     if (r == nullptr) {
@@ -250,7 +265,7 @@ void SemanticCheckerImpl::checkAtom(const Atom& atom) {
     }
 
     for (const Argument* arg : atom.getArguments()) {
-        checkArgument(*arg);
+        checkArgument(*arg, report);
     }
 }
 
@@ -277,19 +292,19 @@ std::set<const UnnamedVariable*> getUnnamedVariables(const Node& node) {
 
 }  // namespace
 
-void SemanticCheckerImpl::checkLiteral(const Literal& literal) {
+void SemanticCheckerImpl::checkLiteral(const Literal& literal, ErrorReport& report) const {
     // check potential nested atom
     if (const auto* atom = as<Atom>(literal)) {
-        checkAtom(*atom);
+        checkAtom(*atom, report);
     }
 
     if (const auto* neg = as<Negation>(literal)) {
-        checkAtom(*neg->getAtom());
+        checkAtom(*neg->getAtom(), report);
     }
 
     if (const auto* constraint = as<BinaryConstraint>(literal)) {
-        checkArgument(*constraint->getLHS());
-        checkArgument(*constraint->getRHS());
+        checkArgument(*constraint->getLHS(), report);
+        checkArgument(*constraint->getRHS(), report);
 
         std::set<const UnnamedVariable*> unnamedInRecord;
         visit(*constraint, [&](const RecordInit& record) {
@@ -318,7 +333,7 @@ void SemanticCheckerImpl::checkLiteral(const Literal& literal) {
  * that contains an aggregate.
  * agg1 is dependent on agg2 if agg1 contains a variable which is grounded by agg2, and not by agg1.
  */
-bool SemanticCheckerImpl::isDependent(const Clause& agg1, const Clause& agg2) {
+bool SemanticCheckerImpl::isDependent(const Clause& agg1, const Clause& agg2) const {
     auto groundedInAgg1 = getGroundedTerms(tu, agg1);
     auto groundedInAgg2 = getGroundedTerms(tu, agg2);
     // For each variable X in the first aggregate
@@ -339,9 +354,7 @@ bool SemanticCheckerImpl::isDependent(const Clause& agg1, const Clause& agg2) {
     return dependent;
 }
 
-void SemanticCheckerImpl::checkAggregator(const Aggregator& aggregator) {
-    auto& report = tu.getErrorReport();
-    const Program& program = tu.getProgram();
+void SemanticCheckerImpl::checkAggregator(const Aggregator& aggregator, ErrorReport& report) const {
     Clause dummyClauseAggregator("dummy");
 
     visit(program, [&](const Literal& parentLiteral) {
@@ -369,16 +382,16 @@ void SemanticCheckerImpl::checkAggregator(const Aggregator& aggregator) {
     });
 
     for (Literal* literal : aggregator.getBodyLiterals()) {
-        checkLiteral(*literal);
+        checkLiteral(*literal, report);
     }
 }
 
-void SemanticCheckerImpl::checkArgument(const Argument& arg) {
+void SemanticCheckerImpl::checkArgument(const Argument& arg, ErrorReport& report) const {
     if (const auto* agg = as<Aggregator>(arg)) {
-        checkAggregator(*agg);
+        checkAggregator(*agg, report);
     } else if (const auto* func = as<Functor>(arg)) {
         for (auto arg : func->getArguments()) {
-            checkArgument(*arg);
+            checkArgument(*arg, report);
         }
 
         if (auto const* udFunc = as<UserDefinedFunctor const>(func)) {
@@ -422,7 +435,7 @@ bool isConstantArgument(const Argument* arg) {
 }  // namespace
 
 /* Check if facts contain only constants */
-void SemanticCheckerImpl::checkFact(const Clause& fact) {
+void SemanticCheckerImpl::checkFact(const Clause& fact, ErrorReport& report) const {
     assert(isFact(fact));
 
     Atom* head = fact.getHead();
@@ -443,9 +456,9 @@ void SemanticCheckerImpl::checkFact(const Clause& fact) {
     }
 }
 
-void SemanticCheckerImpl::checkClause(const Clause& clause) {
+void SemanticCheckerImpl::checkClause(const Clause& clause, ErrorReport& report) const {
     // check head atom
-    checkAtom(*clause.getHead());
+    checkAtom(*clause.getHead(), report);
 
     // Check for absence of underscores in head
     for (auto* unnamed : getUnnamedVariables(*clause.getHead())) {
@@ -454,12 +467,12 @@ void SemanticCheckerImpl::checkClause(const Clause& clause) {
 
     // check body literals
     for (Literal* lit : clause.getBodyLiterals()) {
-        checkLiteral(*lit);
+        checkLiteral(*lit, report);
     }
 
     // check facts
     if (isFact(clause)) {
-        checkFact(clause);
+        checkFact(clause, report);
     }
 
     // check dominated/dominating head of a subsumptive clause
@@ -820,6 +833,103 @@ std::vector<QualifiedName> findInlineCycle(const PrecedenceGraphAnalysis& preced
     return result;
 }
 
+/** Check that the relations whose provenance is kept exist */
+void SemanticCheckerImpl::checkProvenanceRelations() {
+    if (!Global::config().has("provenance-relations")) {
+        return;
+    }
+    for (const auto& item : splitString(Global::config().get("provenance-relations"), ',')) {
+        const std::string name = trim(item);
+        if (program.getRelation(QualifiedName(splitString(name, '.'))) == nullptr) {
+            report.addDiagnostic(Diagnostic(Diagnostic::Type::ERROR,
+                    DiagnosticMessage("Relation " + name + " of provenance-relations does not exist")));
+        }
+    }
+}
+
+/**
+ * Incremental evaluation only derives the consequences of added and removed
+ * tuples, so relations changing with the input relations must not be used
+ * non-monotonically, and must support the erasure of tuples.  Equivalence
+ * relations are rejected altogether, since the tuples implied by an insertion
+ * are not recorded as added.  Input relations must not be derived as well,
+ * since the over-deletion of a derived tuple cannot tell whether it was also
+ * inserted.
+ */
+void SemanticCheckerImpl::checkIncremental() {
+    if (!Global::config().has("incremental")) {
+        return;
+    }
+
+    RelationSet inputs;
+    for (const auto* relation : program.getRelations()) {
+        if (ioTypes.isInput(relation)) {
+            inputs.insert(relation);
+        }
+    }
+    const auto changing = precedenceGraph.graph().reachableFromSucc(inputs);
+    auto isChanging = [&](const Atom& atom) {
+        const auto* relation = program.getRelation(atom);
+        return relation != nullptr && contains(changing, relation);
+    };
+
+    for (const auto* relation : program.getRelations()) {
+        const std::string name = toString(relation->getQualifiedName());
+        if (relation->getRepresentation() == RelationRepresentation::EQREL) {
+            report.addError("Equivalence relation " + name + " is not supported by incremental evaluation",
+                    relation->getSrcLoc());
+        }
+        if (!contains(changing, relation)) {
+            continue;
+        }
+        const auto& clauses = program.getClauses(*relation);
+        if (any_of(clauses, [](const Clause* clause) { return isA<SubsumptiveClause>(clause); })) {
+            report.addError("Subsumptive relation " + name + " is not supported by incremental evaluation",
+                    relation->getSrcLoc());
+        }
+        if (relation->getRepresentation() == RelationRepresentation::BRIE) {
+            report.addError("Brie relation " + name + " is not supported by incremental evaluation",
+                    relation->getSrcLoc());
+        }
+        if (ioTypes.isInput(relation) && any_of(clauses, [](const Clause* clause) {
+                return !getBodyLiterals<Atom>(*clause).empty();
+            })) {
+            report.addError(
+                    "Input relation " + name + " with rules is not supported by incremental evaluation",
+                    relation->getSrcLoc());
+        }
+        if (!relation->getFunctionalDependencies().empty()) {
+            report.addError(
+                    "Choice domain of relation " + name + " is not supported by incremental evaluation",
+                    relation->getSrcLoc());
+        }
+        if (ioTypes.isLimitSize(relation)) {
+            report.addError("Size limit of relation " + name + " is not supported by incremental evaluation",
+                    relation->getSrcLoc());
+        }
+    }
+
+    visit(program, [&](const Negation& negation) {
+        if (isChanging(*negation.getAtom())) {
+            report.addError("Negation of relation " + toString(negation.getAtom()->getQualifiedName()) +
+                                    ", which changes with the input relations, is not supported by "
+                                    "incremental evaluation",
+                    negation.getSrcLoc());
+        }
+    });
+    visit(program, [&](const Aggregator& aggregator) {
+        for (const auto* literal : aggregator.getBodyLiterals()) {
+            const auto* atom = as<Atom>(literal);
+            if (atom != nullptr && isChanging(*atom)) {
+                report.addError("Aggregation over relation " + toString(atom->getQualifiedName()) +
+                                        ", which changes with the input relations, is not supported by "
+                                        "incremental evaluation",
+                        aggregator.getSrcLoc());
+            }
+        }
+    });
+}
+
 void SemanticCheckerImpl::checkInlining() {
     auto isInline = [&](const Relation* rel) { return rel->hasQualifier(RelationQualifier::INLINE); };
 
@@ -16,6 +16,7 @@
 #include "ast/Aggregator.h"
 #include "ast/TranslationUnit.h"
 #include "ast/transform/Transformer.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast {
@@ -32,6 +33,10 @@ public:
         return "SimplifyAggregateTargetExpressionTransformer";
     }
 
+    std::set<std::string> getPreservedAnalyses() const override {
+        return getClauseRewriteAnalyses();
+    }
+
 private:
     SimplifyAggregateTargetExpressionTransformer* cloning() const override {
         return new SimplifyAggregateTargetExpressionTransformer();
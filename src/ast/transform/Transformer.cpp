@@ -15,17 +15,55 @@
  ***********************************************************************/
 
 #include "ast/transform/Transformer.h"
+#include "ast/Node.h"
+#include "ast/Program.h"
 #include "ast/TranslationUnit.h"
+#include "ast/analysis/IOType.h"
+#include "ast/analysis/PrecedenceGraph.h"
+#include "ast/analysis/RecursiveClauses.h"
+#include "ast/analysis/RedundantRelations.h"
+#include "ast/analysis/RelationSchedule.h"
+#include "ast/analysis/SCCGraph.h"
+#include "ast/analysis/TopologicallySortedSCCGraph.h"
+#include "ast/analysis/typesystem/SumTypeBranches.h"
+#include "ast/analysis/typesystem/TypeEnvironment.h"
+#include "ast/transform/Meta.h"
+#include "ast/utility/Visitor.h"
 #include "reports/ErrorReport.h"
+#include "souffle/utility/MiscUtil.h"
+#include <chrono>
+#include <cstddef>
 
 namespace souffle::ast::transform {
 
+namespace {
+
+std::size_t countNodes(const TranslationUnit& translationUnit) {
+    std::size_t nodes = 0;
+    visit(translationUnit.getProgram(), [&](const Node&) { ++nodes; });
+    return nodes;
+}
+
+}  // namespace
+
 bool Transformer::apply(TranslationUnit& translationUnit) {
+    TransformerProfile* profile = translationUnit.getTransformerProfile();
+    if (profile != nullptr) {
+        profile->beginTransformer("AST", getName(), isA<MetaTransformer>(this), countNodes(translationUnit));
+    }
+
     // invoke the transformation
+    auto start = std::chrono::high_resolution_clock::now();
     bool changed = transform(translationUnit);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // meta-transformers leave the invalidation to their sub-transformers
+    if (changed && !isA<MetaTransformer>(this)) {
+        translationUnit.invalidateAnalyses(getPreservedAnalyses());
+    }
 
-    if (changed) {
-        translationUnit.invalidateAnalyses();
+    if (profile != nullptr) {
+        profile->endTransformer(changed, end - start, countNodes(translationUnit));
     }
 
     /* Abort evaluation of the program if errors were encountered */
@@ -34,4 +72,21 @@ bool Transformer::apply(TranslationUnit& translationUnit) {
     return changed;
 }
 
+std::set<std::string> Transformer::getRelationAnalyses() {
+    return {analysis::IOTypeAnalysis::name, analysis::PrecedenceGraphAnalysis::name,
+            analysis::RedundantRelationsAnalysis::name, analysis::RelationScheduleAnalysis::name,
+            analysis::SCCGraphAnalysis::name, analysis::TopologicallySortedSCCGraphAnalysis::name};
+}
+
+std::set<std::string> Transformer::getTypeDeclarationAnalyses() {
+    return {analysis::SumTypeBranchesAnalysis::name, analysis::TypeEnvironmentAnalysis::name};
+}
+
+std::set<std::string> Transformer::getClauseRewriteAnalyses() {
+    std::set<std::string> preserved = getRelationAnalyses();
+    preserved.merge(getTypeDeclarationAnalyses());
+    preserved.insert(analysis::RecursiveClausesAnalysis::name);
+    return preserved;
+}
+
 }  // namespace souffle::ast::transform
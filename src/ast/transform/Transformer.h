@@ -18,6 +18,7 @@
 
 #include "ast/TranslationUnit.h"
 #include "souffle/utility/Types.h"
+#include <set>
 #include <string>
 
 namespace souffle::ast::transform {
@@ -33,6 +34,14 @@ public:
 
     virtual std::string getName() const = 0;
 
+    /**
+     * Names of the analyses that remain valid when the transformer changes the program; all
+     * other analyses are invalidated. A preserved analysis may only depend on preserved analyses.
+     */
+    virtual std::set<std::string> getPreservedAnalyses() const {
+        return {};
+    }
+
     /**
      * Transformers can be disabled by command line
      * with --disable-transformer. Default behaviour
@@ -46,6 +55,19 @@ public:
         return Own<Transformer>(cloning());
     }
 
+protected:
+    /** Analyses of the relations, their IO and dependencies; valid while clauses use the same relations */
+    static std::set<std::string> getRelationAnalyses();
+
+    /** Analyses of the type declarations; valid while no type is declared or removed */
+    static std::set<std::string> getTypeDeclarationAnalyses();
+
+    /**
+     * Analyses that remain valid when the terms of clauses are rewritten in place: those of the
+     * relations and type declarations, and the recursive clauses
+     */
+    static std::set<std::string> getClauseRewriteAnalyses();
+
 private:
     virtual Transformer* cloning() const = 0;
 };
@@ -23,14 +23,22 @@
 #include "ast/utility/BindingStore.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <limits>
+#include <set>
 #include <vector>
 
 namespace souffle::ast {
 
 std::vector<unsigned int> SipsMetric::getReordering(const Clause* clause) const {
-    BindingStore bindingStore(clause);
+    return getReordering(clause, BindingStore(clause));
+}
+
+std::vector<unsigned int> SipsMetric::getReordering(
+        const Clause* clause, const BindingStore& initialBindings) const {
+    BindingStore bindingStore(initialBindings);
     auto atoms = getBodyLiterals<Atom>(*clause);
     std::vector<unsigned int> newOrder(atoms.size());
 
@@ -271,8 +279,11 @@ std::vector<double> LeastFreeVarsSips::evaluateCosts(
 std::vector<double> ProfileUseSips::evaluateCosts(
         const std::vector<Atom*> atoms, const BindingStore& bindingStore) const {
     // Goal: reorder based on the given profiling information
-    // Metric: cost(atom_R) = log(|atom_R|) * #free/#args
-    //         - exception: propositions are prioritised
+    // Metric: cost(atom_R) = log(|R| / #distinct(R[bound])), the number of tuples matching a binding
+    //         - #distinct(R[bound]) is taken from the statistics of the bound columns in the profile;
+    //           without them, it is estimated as |R|^(#bound/#args), assuming independent columns, but
+    //           at least the count of any subset of the columns with statistics
+    //         - exception: propositions and all-bound atoms are prioritised
     std::vector<double> cost;
     for (const auto* atom : atoms) {
         if (atom == nullptr) {
@@ -280,19 +291,31 @@ std::vector<double> ProfileUseSips::evaluateCosts(
             continue;
         }
 
-        // prioritise propositions
+        // prioritise propositions and existence checks
         int arity = atom->getArity();
-        if (arity == 0) {
+        int numBound = bindingStore.numBoundArguments(atom);
+        int numFree = arity - numBound;
+        if (numFree == 0) {
             cost.push_back(0);
             continue;
         }
 
-        // calculate log(|R|) * #free/#args
-        int numBound = bindingStore.numBoundArguments(atom);
-        int numFree = arity - numBound;
-        double value = log(profileUse.getRelationSize(atom->getQualifiedName()));
-        value *= (numFree * 1.0) / arity;
+        const auto& name = atom->getQualifiedName();
+        double size = std::max<double>(profileUse.getRelationSize(name), 1);
+        std::set<std::size_t> boundColumns;
+        const auto& args = atom->getArguments();
+        for (std::size_t i = 0; i < args.size(); i++) {
+            if (bindingStore.isBound(args[i])) {
+                boundColumns.insert(i);
+            }
+        }
+        double distinctValues = profileUse.getDistinctValues(name, boundColumns);
+        if (!profileUse.hasDistinctValues(name, boundColumns)) {
+            distinctValues = std::max(distinctValues, std::pow(size, static_cast<double>(numBound) / arity));
+        }
+        cost.push_back(std::log(std::max(size / distinctValues, 1.0)));
     }
+    assert(atoms.size() == cost.size() && "each atom should have exactly one cost");
     return cost;
 }
 
@@ -47,6 +47,15 @@ public:
      */
     std::vector<unsigned int> getReordering(const Clause* clause) const;
 
+    /**
+     * Determines the new ordering of a clause after the SIPS is applied, given variables that are
+     * bound before the clause is evaluated, e.g. by an adornment of its head.
+     * @param clause clause to reorder
+     * @param initialBindings the variables bound initially
+     * @return the vector of new positions; v[i] = j iff atom j moves to pos i
+     */
+    std::vector<unsigned int> getReordering(const Clause* clause, const BindingStore& initialBindings) const;
+
     /** Create a SIPS metric based on a given heuristic. */
     static std::unique_ptr<SipsMetric> create(const std::string& heuristic, const TranslationUnit& tu);
 
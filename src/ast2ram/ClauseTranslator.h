@@ -59,7 +59,31 @@ enum TranslationMode {
     SubsumeDeleteCurrentDelta,
 
     // delete delete-R(x0) :- R(x0), R(x1), x0!=x1, body. (outside fix-point)
-    SubsumeDeleteCurrentCurrent
+    SubsumeDeleteCurrentCurrent,
+
+    // In incremental evaluation, the versions of a clause are taken over the
+    // atoms of the relations of lower strata, which read the tuples added to
+    // these relations by the current evaluation:
+    //
+    //   new-R(x) :- added-A(x), !added-B(x), B(x), C(x), !R(x).
+    IncrementalInsert,
+
+    // The tuples removed from relations are retracted by deleting and rederiving
+    // (DRed) their consequences.  The versions over-deleting the consequences
+    // read the removed tuples of lower strata, and the previous tuples otherwise:
+    //
+    //   new-R(x) :- removed-A(x), !removed-B(x), B(x), C(x), R(x), !removed-R(x).
+    IncrementalOverdelete,
+
+    // Over-deletion inside the fix-point, on the tuples removed by the last iteration:
+    //
+    //   new-R(x) :- delta-R(y), !delta-S(x), S(x), A(x, y), R(x), !removed-R(x).
+    IncrementalOverdeleteDelta,
+
+    // Rederivation of the removed tuples that have remaining derivations:
+    //
+    //   new-R(x) :- removed-R(x), A(x), B(x), C(x), !R(x).
+    IncrementalRederive
 };
 
 /* Abstract Clause Translator */
@@ -18,6 +18,9 @@
 #include "ast/BinaryConstraint.h"
 #include "ast/Clause.h"
 #include "ast/Constraint.h"
+#include "ast/Relation.h"
+#include "ast/TranslationUnit.h"
+#include "ast/analysis/PrecedenceGraph.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
 #include "ast2ram/provenance/SubproofGenerator.h"
@@ -50,6 +53,8 @@
 namespace souffle::ast2ram::provenance {
 
 Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& translationUnit) {
+    computeExplainedRelations(translationUnit);
+
     // Do the regular translation
     auto ramProgram = seminaive::UnitTranslator::generateProgram(translationUnit);
 
@@ -65,6 +70,30 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
     return ramProgram;
 }
 
+void UnitTranslator::computeExplainedRelations(const ast::TranslationUnit& translationUnit) {
+    const auto& program = translationUnit.getProgram();
+    explainedRelations.clear();
+    if (!Global::config().has("provenance-relations")) {
+        for (const auto* rel : program.getRelations()) {
+            explainedRelations.insert(rel->getQualifiedName());
+        }
+        return;
+    }
+
+    // the proofs of the given relations only contain tuples of the relations they depend on
+    std::set<const ast::Relation*> sources;
+    for (const auto& relStr : splitString(Global::config().get("provenance-relations"), ',')) {
+        if (const auto* rel = program.getRelation(ast::QualifiedName(splitString(trim(relStr), '.')))) {
+            sources.insert(rel);
+        }
+    }
+    const auto& precedenceGraph =
+            translationUnit.getAnalysis<ast::analysis::PrecedenceGraphAnalysis>().graph();
+    for (const auto* rel : precedenceGraph.reachableFromPred(sources)) {
+        explainedRelations.insert(rel->getQualifiedName());
+    }
+}
+
 Own<ram::Relation> UnitTranslator::createRamRelation(
         const ast::Relation* baseRelation, std::string ramRelationName) const {
     auto arity = baseRelation->getArity();
@@ -103,7 +132,7 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
 
     // Info relations
     for (const auto* clause : context->getProgram()->getClauses()) {
-        if (isFact(*clause)) {
+        if (isFact(*clause) || !isExplained(clause->getHead()->getQualifiedName())) {
             continue;
         }
 
@@ -146,15 +175,21 @@ void UnitTranslator::addAuxiliaryArity(
 }
 
 Own<ram::Statement> UnitTranslator::generateClearExpiredRelations(
-        const std::set<const ast::Relation*>& /* expiredRelations */) const {
-    // Relations should be preserved if provenance is enabled
-    return mk<ram::Sequence>();
+        const std::set<const ast::Relation*>& expiredRelations) const {
+    // Relations should be preserved if their provenance is kept
+    std::set<const ast::Relation*> clearedRelations;
+    for (const auto* relation : expiredRelations) {
+        if (!isExplained(relation->getQualifiedName())) {
+            clearedRelations.insert(relation);
+        }
+    }
+    return seminaive::UnitTranslator::generateClearExpiredRelations(clearedRelations);
 }
 
 void UnitTranslator::addProvenanceClauseSubroutines(const ast::Program* program) {
     visit(*program, [&](const ast::Clause& clause) {
-        // Skip facts
-        if (isFact(clause)) {
+        // Skip facts, and the clauses of relations whose provenance is not kept
+        if (isFact(clause) || !isExplained(clause.getHead()->getQualifiedName())) {
             return;
         }
 
@@ -194,7 +229,7 @@ Own<ram::Sequence> UnitTranslator::generateInfoClauses(const ast::Program* progr
 
     std::size_t stratumCount = context->getNumberOfSCCs();
     for (const auto* clause : program->getClauses()) {
-        if (isFact(*clause)) {
+        if (isFact(*clause) || !isExplained(clause->getHead()->getQualifiedName())) {
             continue;
         }
         std::size_t clauseID = context->getClauseNum(clause);
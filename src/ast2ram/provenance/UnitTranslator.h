@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include "ast/QualifiedName.h"
 #include "ast2ram/seminaive/UnitTranslator.h"
+#include <set>
 
 namespace souffle::ast {
 class Atom;
@@ -55,6 +57,14 @@ protected:
             const std::string& srcRelation) const override;
 
 private:
+    /** Relations whose provenance is kept: the relations to explain and their dependencies */
+    std::set<ast::QualifiedName> explainedRelations;
+
+    void computeExplainedRelations(const ast::TranslationUnit& translationUnit);
+    bool isExplained(const ast::QualifiedName& relation) const {
+        return explainedRelations.count(relation) > 0;
+    }
+
     /** Translate RAM code for subroutine to get subproofs */
     Own<ram::Statement> makeSubproofSubroutine(const ast::Clause& clause);
 
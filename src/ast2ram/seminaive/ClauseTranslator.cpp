@@ -29,6 +29,7 @@
 #include "ast/StringConstant.h"
 #include "ast/SubsumptiveClause.h"
 #include "ast/UnnamedVariable.h"
+#include "ast/Variable.h"
 #include "ast/analysis/Functor.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
@@ -38,6 +39,8 @@
 #include "ast2ram/utility/ValueIndex.h"
 #include "ram/Aggregate.h"
 #include "ram/Break.h"
+#include "ram/Clear.h"
+#include "ram/Conjunction.h"
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
 #include "ram/EmptinessCheck.h"
@@ -50,6 +53,7 @@
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/Query.h"
+#include "ram/RelationSize.h"
 #include "ram/Scan.h"
 #include "ram/Sequence.h"
 #include "ram/SignedConstant.h"
@@ -59,7 +63,11 @@
 #include "ram/UnsignedConstant.h"
 #include "ram/utility/Utils.h"
 #include "souffle/utility/StringUtil.h"
+#include <algorithm>
+#include <cstddef>
 #include <map>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace souffle::ast2ram::seminaive {
@@ -73,6 +81,10 @@ bool ClauseTranslator::isRecursive() const {
     return !sccAtoms.empty();
 }
 
+bool ClauseTranslator::isOverdeletion() const {
+    return mode == IncrementalOverdelete || mode == IncrementalOverdeleteDelta;
+}
+
 std::string ClauseTranslator::getClauseString(const ast::Clause& clause) const {
     auto renamedClone = clone(clause);
 
@@ -101,8 +113,10 @@ Own<ram::Statement> ClauseTranslator::translateRecursiveClause(
             [&](auto* atom) { return contains(scc, context.getProgram()->getRelation(*atom)); });
     this->version = version;
 
-    // Translate the resultant clause as would be done normally
-    Own<ram::Statement> rule = translateNonRecursiveClause(clause);
+    // Translate the resultant clause as would be done normally, or into plans chosen at runtime
+    const auto& leadingAtoms = getLeadingAtoms(clause);
+    Own<ram::Statement> rule = leadingAtoms.empty() ? translateNonRecursiveClause(clause)
+                                                    : translateAdaptiveJoins(clause, leadingAtoms);
 
     // Add logging
     if (Global::config().has("profile")) {
@@ -127,6 +141,88 @@ Own<ram::Statement> ClauseTranslator::translateRecursiveClause(
     return mk<ram::Sequence>(std::move(rule));
 }
 
+std::vector<const ast::Atom*> ClauseTranslator::getLeadingAtoms(const ast::Clause& clause) const {
+    // the order of the atoms is fixed by plans, and relied upon by provenance and subsumption
+    const auto* plan = clause.getExecutionPlan();
+    if (!Global::config().has("adaptive-joins") || Global::config().has("provenance") || mode != DEFAULT ||
+            isA<ast::SubsumptiveClause>(clause) ||
+            (plan != nullptr && contains(plan->getOrders(), version))) {
+        return {};
+    }
+
+    // lead with the atom of the static plan, the delta atom, then any other scanned atom
+    std::vector<const ast::Atom*> leadingAtoms;
+    std::set<std::string> leadingRelations;
+    auto addLeadingAtom = [&](const ast::Atom* atom) {
+        bool isScanned = atom->getArity() != 0 && !all_of(atom->getArguments(), [](const ast::Argument* arg) {
+            return isA<ast::UnnamedVariable>(arg);
+        });
+        if (isScanned && leadingAtoms.size() < MAX_ADAPTIVE_PLANS &&
+                leadingRelations.insert(getClauseAtomName(clause, atom)).second) {
+            leadingAtoms.push_back(atom);
+        }
+    };
+    const auto& atoms = ast::getBodyLiterals<ast::Atom>(clause);
+    addLeadingAtom(atoms.front());
+    addLeadingAtom(sccAtoms.at(version));
+    for (const auto* atom : atoms) {
+        addLeadingAtom(atom);
+    }
+    return leadingAtoms.size() > 1 ? leadingAtoms : std::vector<const ast::Atom*>();
+}
+
+Own<ram::Statement> ClauseTranslator::translateAdaptiveJoins(
+        const ast::Clause& clause, const std::vector<const ast::Atom*>& leadingAtoms) {
+    const std::string sizesName = getAdaptiveSizesRelationName();
+    const std::string planName = getAdaptivePlanRelationName();
+    auto planIndex = [](std::size_t i) {
+        VecOwn<ram::Expression> values;
+        values.push_back(mk<ram::SignedConstant>(static_cast<RamDomain>(i)));
+        return values;
+    };
+
+    // The relations read by a clause version do not change within an iteration, so their sizes are
+    // computed once, and the plan scanning the smallest relation first, the earliest on ties, is chosen
+    VecOwn<ram::Statement> stmts;
+    appendStmt(stmts, mk<ram::Clear>(sizesName));
+    appendStmt(stmts, mk<ram::Clear>(planName));
+    VecOwn<ram::Expression> sizes;
+    for (std::size_t i = 0; i < MAX_ADAPTIVE_PLANS; i++) {
+        if (i < leadingAtoms.size()) {
+            sizes.push_back(mk<ram::RelationSize>(getClauseAtomName(clause, leadingAtoms[i])));
+        } else {
+            sizes.push_back(mk<ram::SignedConstant>(0));
+        }
+    }
+    appendStmt(stmts, mk<ram::Query>(mk<ram::Insert>(sizesName, std::move(sizes))));
+    for (std::size_t i = 0; i < leadingAtoms.size(); i++) {
+        VecOwn<ram::Condition> smallest;
+        for (std::size_t j = 0; j < leadingAtoms.size(); j++) {
+            if (i != j) {
+                auto op = j < i ? BinaryConstraintOp::LT : BinaryConstraintOp::LE;
+                smallest.push_back(
+                        mk<ram::Constraint>(op, mk<ram::TupleElement>(0, i), mk<ram::TupleElement>(0, j)));
+            }
+        }
+        auto choice = mk<ram::Filter>(ram::toCondition(smallest), mk<ram::Insert>(planName, planIndex(i)));
+        appendStmt(stmts, mk<ram::Query>(mk<ram::Scan>(sizesName, 0, std::move(choice))));
+    }
+
+    // Exactly one of the plans is evaluated
+    for (std::size_t i = 0; i < leadingAtoms.size(); i++) {
+        valueIndex = mk<ValueIndex>();
+        operators.clear();
+        generators.clear();
+        leadingAtom = leadingAtoms[i];
+        auto query = createRamRuleQuery(clause);
+        const auto& operation = asAssert<ram::Query>(query).getOperation();
+        auto chosen = mk<ram::ExistenceCheck>(planName, planIndex(i));
+        appendStmt(stmts, mk<ram::Query>(mk<ram::Filter>(std::move(chosen), clone(operation))));
+    }
+    leadingAtom = nullptr;
+    return mk<ram::Sequence>(std::move(stmts));
+}
+
 Own<ram::Statement> ClauseTranslator::translateNonRecursiveClause(const ast::Clause& clause) {
     // Create the appropriate query
     if (isFact(clause)) {
@@ -172,6 +268,15 @@ std::string ClauseTranslator::getClauseAtomName(const ast::Clause& clause, const
         }
     }
 
+    if (mode == IncrementalRederive) {
+        if (clause.getHead() == atom) {
+            return getNewRelationName(atom->getQualifiedName());
+        }
+        if (rederiveAtom.get() == atom) {
+            return getRemovedRelationName(atom->getQualifiedName());
+        }
+    }
+
     if (!isRecursive()) {
         return getConcreteRelationName(atom->getQualifiedName());
     }
@@ -179,11 +284,19 @@ std::string ClauseTranslator::getClauseAtomName(const ast::Clause& clause, const
         return getNewRelationName(atom->getQualifiedName());
     }
     if (sccAtoms.at(version) == atom) {
-        return getDeltaRelationName(atom->getQualifiedName());
+        return getVersionRelationName(atom);
     }
     return getConcreteRelationName(atom->getQualifiedName());
 }
 
+std::string ClauseTranslator::getVersionRelationName(const ast::Atom* atom) const {
+    switch (mode) {
+        case IncrementalInsert: return getAddedRelationName(atom->getQualifiedName());
+        case IncrementalOverdelete: return getRemovedRelationName(atom->getQualifiedName());
+        default: return getDeltaRelationName(atom->getQualifiedName());
+    }
+}
+
 Own<ram::Statement> ClauseTranslator::createRamFactQuery(const ast::Clause& clause) const {
     assert(isFact(clause) && "clause should be fact");
     assert(!isRecursive() && "recursive clauses cannot have facts");
@@ -484,7 +597,7 @@ Own<ram::Operation> ClauseTranslator::addDistinct(
 Own<ram::Operation> ClauseTranslator::addNegatedDeltaAtom(
         Own<ram::Operation> op, const ast::Atom* atom) const {
     std::size_t arity = atom->getArity();
-    std::string name = getDeltaRelationName(atom->getQualifiedName());
+    std::string name = getVersionRelationName(atom);
 
     if (arity == 0) {
         // for a nullary, negation is a simple emptiness check
@@ -522,6 +635,23 @@ Own<ram::Operation> ClauseTranslator::addNegatedAtom(
             mk<ram::Negation>(mk<ram::ExistenceCheck>(name, std::move(values))), std::move(op));
 }
 
+Own<ram::Operation> ClauseTranslator::addOverdeletedHeadConstraints(
+        Own<ram::Operation> op, const ast::Atom* head) const {
+    VecOwn<ram::Expression> values;
+    VecOwn<ram::Expression> values2;
+    for (const auto* arg : head->getArguments()) {
+        values.push_back(context.translateValue(*valueIndex, arg));
+        values2.push_back(context.translateValue(*valueIndex, arg));
+    }
+
+    // only tuples of the relation that are not removed yet are over-deleted
+    const auto& name = head->getQualifiedName();
+    auto known = mk<ram::ExistenceCheck>(getConcreteRelationName(name), std::move(values));
+    auto removed = mk<ram::ExistenceCheck>(getRemovedRelationName(name), std::move(values2));
+    op = mk<ram::Filter>(mk<ram::Negation>(std::move(removed)), std::move(op));
+    return mk<ram::Filter>(std::move(known), std::move(op));
+}
+
 Own<ram::Operation> ClauseTranslator::addBodyLiteralConstraints(
         const ast::Clause& clause, Own<ram::Operation> op) const {
     for (const auto* lit : clause.getBodyLiterals()) {
@@ -542,10 +672,14 @@ Own<ram::Operation> ClauseTranslator::addBodyLiteralConstraints(
         return op;
     }
 
-    if (isRecursive()) {
+    if (isRecursive() || mode == IncrementalRederive) {
         if (clause.getHead()->getArity() > 0) {
-            // also negate the head
-            op = addNegatedAtom(std::move(op), clause, clause.getHead());
+            if (isOverdeletion()) {
+                op = addOverdeletedHeadConstraints(std::move(op), clause.getHead());
+            } else {
+                // also negate the head
+                op = addNegatedAtom(std::move(op), clause, clause.getHead());
+            }
         }
 
         // also add in prev stuff
@@ -560,9 +694,20 @@ Own<ram::Operation> ClauseTranslator::addBodyLiteralConstraints(
 Own<ram::Condition> ClauseTranslator::createCondition(const ast::Clause& clause) const {
     const auto head = clause.getHead();
 
+    if (head->getArity() != 0) {
+        return nullptr;
+    }
+
+    // over-delete the null tuple only if it is there and not removed yet
+    if (isOverdeletion()) {
+        return mk<ram::Conjunction>(
+                mk<ram::Negation>(mk<ram::EmptinessCheck>(getConcreteRelationName(head->getQualifiedName()))),
+                mk<ram::EmptinessCheck>(getRemovedRelationName(head->getQualifiedName())));
+    }
+
     // add stopping criteria for nullary relations
     // (if it contains already the null tuple, don't re-compute)
-    if (isRecursive() && head->getArity() == 0) {
+    if (isRecursive() || mode == IncrementalRederive) {
         return mk<ram::EmptinessCheck>(getConcreteRelationName(head->getQualifiedName()));
     }
     return nullptr;
@@ -694,8 +839,30 @@ std::vector<ast::Atom*> ClauseTranslator::getAtomOrdering(const ast::Clause& cla
 
     auto atoms = ast::getBodyLiterals<ast::Atom>(clause);
 
+    // an alternative plan scans its leading atom first, followed by the atoms in their static order,
+    // preferring those joined with the atoms before them
+    if (leadingAtom != nullptr) {
+        std::vector<ast::Atom*> ordering;
+        std::set<std::string> boundVariables;
+        auto scanNext = [&](std::vector<ast::Atom*>::iterator it) {
+            visit(**it, [&](const ast::Variable& var) { boundVariables.insert(var.getName()); });
+            ordering.push_back(*it);
+            atoms.erase(it);
+        };
+        scanNext(std::find(atoms.begin(), atoms.end(), leadingAtom));
+        while (!atoms.empty()) {
+            auto joined = std::find_if(atoms.begin(), atoms.end(), [&](const ast::Atom* atom) {
+                return visitExists(*atom,
+                        [&](const ast::Variable& var) { return contains(boundVariables, var.getName()); });
+            });
+            scanNext(joined != atoms.end() ? joined : atoms.begin());
+        }
+        return ordering;
+    }
+
+    // plans are given for the versions of the fixpoint loop, not those over the lower strata
     const auto& plan = clause.getExecutionPlan();
-    if (plan == nullptr) {
+    if (plan == nullptr || mode == IncrementalInsert || mode == IncrementalOverdelete) {
         return atoms;
     }
 
@@ -788,6 +955,22 @@ void ClauseTranslator::indexGenerator(const ast::Argument& arg) {
 }
 
 void ClauseTranslator::indexAtoms(const ast::Clause& clause) {
+    // the removed tuples of the head relation are scanned first, binding the variables of the head
+    if (mode == IncrementalRederive) {
+        const auto* head = clause.getHead();
+        VecOwn<ast::Argument> args;
+        for (const auto* arg : head->getArguments()) {
+            if (const auto* var = as<ast::Variable>(arg)) {
+                args.push_back(clone(var));
+            } else {
+                args.push_back(mk<ast::UnnamedVariable>());
+            }
+        }
+        rederiveAtom = mk<ast::Atom>(head->getQualifiedName(), std::move(args), head->getSrcLoc());
+        int scanLevel = addOperatorLevel(rederiveAtom.get());
+        indexNodeArguments(scanLevel, rederiveAtom->getArguments());
+    }
+
     for (const auto* atom : getAtomOrdering(clause)) {
         // give the atom the current level
         int scanLevel = addOperatorLevel(atom);
@@ -63,15 +63,26 @@ protected:
     std::size_t version{0};
     std::vector<ast::Atom*> sccAtoms{};
 
+    /** Atom over the removed tuples of the head relation, for the rederivation of incremental evaluation */
+    Own<ast::Atom> rederiveAtom;
+
+    /** Atom scanned first by the alternative plan being translated, if any */
+    const ast::Atom* leadingAtom = nullptr;
+
     bool isRecursive() const;
+    bool isOverdeletion() const;
 
     std::string getClauseString(const ast::Clause& clause) const;
 
     std::string getClauseAtomName(const ast::Clause& clause, const ast::Atom* atom) const;
 
+    /** Name of the relation read by the atom of the current version */
+    std::string getVersionRelationName(const ast::Atom* atom) const;
+
     virtual Own<ram::Operation> addNegatedAtom(
             Own<ram::Operation> op, const ast::Clause& clause, const ast::Atom* atom) const;
     virtual Own<ram::Operation> addNegatedDeltaAtom(Own<ram::Operation> op, const ast::Atom* atom) const;
+    Own<ram::Operation> addOverdeletedHeadConstraints(Own<ram::Operation> op, const ast::Atom* head) const;
     virtual Own<ram::Operation> addDistinct(
             Own<ram::Operation> op, const ast::Atom* atom1, const ast::Atom* atom2) const;
 
@@ -86,6 +97,11 @@ protected:
 
     std::vector<ast::Atom*> getAtomOrdering(const ast::Clause& clause) const;
 
+    /** Adaptive joins */
+    std::vector<const ast::Atom*> getLeadingAtoms(const ast::Clause& clause) const;
+    Own<ram::Statement> translateAdaptiveJoins(
+            const ast::Clause& clause, const std::vector<const ast::Atom*>& leadingAtoms);
+
     /** Indexing */
     void indexClause(const ast::Clause& clause);
     virtual void indexAtoms(const ast::Clause& clause);
@@ -15,11 +15,13 @@
 #include "ast2ram/seminaive/UnitTranslator.h"
 #include "Global.h"
 #include "LogStatement.h"
+#include "ast/Atom.h"
 #include "ast/Clause.h"
 #include "ast/Directive.h"
 #include "ast/Relation.h"
 #include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
+#include "ast/analysis/PrecedenceGraph.h"
 #include "ast/analysis/TopologicallySortedSCCGraph.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
@@ -156,6 +158,12 @@ Own<ram::Statement> UnitTranslator::generateNonRecursiveRelation(const ast::Rela
 Own<ram::Statement> UnitTranslator::generateStratum(std::size_t scc) const {
     // Make a new ram statement for the current SCC
     VecOwn<ram::Statement> current;
+    const auto& sccRelations = context->getRelationsInSCC(scc);
+
+    // Erase the retracted tuples, before the input relations are loaded again
+    if (Global::config().has("incremental")) {
+        appendStmt(current, generateIncrementalRetraction(sccRelations));
+    }
 
     // Load all internal input relations from the facts dir with a .facts extension
     for (const auto& relation : context->getInputRelationsInSCC(scc)) {
@@ -163,8 +171,9 @@ Own<ram::Statement> UnitTranslator::generateStratum(std::size_t scc) const {
     }
 
     // Compute the current stratum
-    const auto& sccRelations = context->getRelationsInSCC(scc);
-    if (context->isRecursiveSCC(scc)) {
+    if (Global::config().has("incremental")) {
+        appendStmt(current, generateIncrementalStratum(sccRelations, context->isRecursiveSCC(scc)));
+    } else if (context->isRecursiveSCC(scc)) {
         appendStmt(current, generateRecursiveStratum(sccRelations));
     } else {
         assert(sccRelations.size() == 1 && "only one relation should exist in non-recursive stratum");
@@ -187,7 +196,12 @@ Own<ram::Statement> UnitTranslator::generateClearExpiredRelations(
         const std::set<const ast::Relation*>& expiredRelations) const {
     VecOwn<ram::Statement> stmts;
     for (const auto& relation : expiredRelations) {
-        appendStmt(stmts, generateClearRelation(relation));
+        if (Global::config().has("incremental")) {
+            // the relation is kept for the next evaluation, only its added tuples are dropped
+            appendStmt(stmts, mk<ram::Clear>(getAddedRelationName(relation->getQualifiedName())));
+        } else {
+            appendStmt(stmts, generateClearRelation(relation));
+        }
     }
     return mk<ram::Sequence>(std::move(stmts));
 }
@@ -256,7 +270,7 @@ Own<ram::Statement> UnitTranslator::generateMergeRelations(
 }
 
 Own<ram::Statement> UnitTranslator::translateRecursiveClauses(
-        const std::set<const ast::Relation*>& scc, const ast::Relation* rel) const {
+        const std::set<const ast::Relation*>& scc, const ast::Relation* rel, TranslationMode mode) const {
     assert(contains(scc, rel) && "relation should belong to scc");
     VecOwn<ram::Statement> code;
 
@@ -268,7 +282,7 @@ Own<ram::Statement> UnitTranslator::translateRecursiveClauses(
         }
 
         // generate all delta versions of a recursive clause
-        auto clauseVersions = generateClauseVersions(clause, scc);
+        auto clauseVersions = generateClauseVersions(clause, scc, mode);
         for (auto& clauseVersion : clauseVersions) {
             appendStmt(code, std::move(clauseVersion));
         }
@@ -353,13 +367,13 @@ std::vector<ast::Atom*> UnitTranslator::getSccAtoms(
 }
 
 VecOwn<ram::Statement> UnitTranslator::generateClauseVersions(
-        const ast::Clause* clause, const std::set<const ast::Relation*>& scc) const {
+        const ast::Clause* clause, const std::set<const ast::Relation*>& scc, TranslationMode mode) const {
     const auto& sccAtoms = getSccAtoms(clause, scc);
 
     // Create each version
     VecOwn<ram::Statement> clauseVersions;
     for (std::size_t version = 0; version < sccAtoms.size(); version++) {
-        appendStmt(clauseVersions, context->translateRecursiveClause(*clause, scc, version));
+        appendStmt(clauseVersions, context->translateRecursiveClause(*clause, scc, version, mode));
     }
 
     // Check that the correct number of versions have been created
@@ -468,8 +482,15 @@ Own<ram::Statement> UnitTranslator::generateStratumTableUpdates(
         // swap new and and delta relation and clear new relation afterwards (if not a subsumptive relation)
         Own<ram::Statement> updateRelTable;
         if (!context->hasSubsumptiveClause(rel->getQualifiedName())) {
-            updateRelTable = mk<ram::Sequence>(generateMergeRelations(rel, mainRelation, newRelation),
-                    mk<ram::Swap>(deltaRelation, newRelation), mk<ram::Clear>(newRelation));
+            auto mergeNew = generateMergeRelations(rel, mainRelation, newRelation);
+            if (Global::config().has("incremental")) {
+                // also record the tuples added by the current evaluation
+                std::string addedRelation = getAddedRelationName(rel->getQualifiedName());
+                mergeNew = mk<ram::Sequence>(
+                        std::move(mergeNew), generateMergeRelations(rel, addedRelation, newRelation));
+            }
+            updateRelTable = mk<ram::Sequence>(std::move(mergeNew), mk<ram::Swap>(deltaRelation, newRelation),
+                    mk<ram::Clear>(newRelation));
         } else {
             updateRelTable = generateMergeRelations(rel, mainRelation, deltaRelation);
         }
@@ -577,6 +598,289 @@ Own<ram::Statement> UnitTranslator::generateRecursiveStratum(
     return mk<ram::Sequence>(std::move(result));
 }
 
+bool UnitTranslator::isChangingRelation(const ast::Relation* rel) const {
+    return contains(changingRelations, rel);
+}
+
+bool UnitTranslator::hasExtensionalTuples(const ast::Relation* rel) const {
+    if (!context->getLoadDirectives(rel->getQualifiedName()).empty()) {
+        return true;
+    }
+    return any_of(context->getProgram()->getClauses(*rel),
+            [](const ast::Clause* clause) { return ast::getBodyLiterals<ast::Atom>(*clause).empty(); });
+}
+
+Own<ram::Statement> UnitTranslator::generateIncrementalSeeds(const ast::Relation* rel) const {
+    VecOwn<ram::Statement> seeds;
+    std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+    std::string addedRelation = getAddedRelationName(rel->getQualifiedName());
+    std::string previousRelation = getPreviousRelationName(rel->getQualifiedName());
+
+    // Clauses without atoms, such as facts, are evaluated again in full
+    for (auto&& clause : context->getProgram()->getClauses(*rel)) {
+        if (!ast::getBodyLiterals<ast::Atom>(*clause).empty()) {
+            continue;
+        }
+        std::ostringstream ds;
+        ds << toString(*clause) << "\nin file ";
+        ds << clause->getSrcLoc();
+        appendStmt(seeds, mk<ram::DebugInfo>(context->translateNonRecursiveClause(*clause), ds.str()));
+    }
+    if (!hasExtensionalTuples(rel)) {
+        return mk<ram::Sequence>(std::move(seeds));
+    }
+
+    // Tuples unknown to previous evaluations are added, which includes the loaded tuples and those
+    // inserted through the program interface; the relations are only scanned if they have grown
+    if (rel->getArity() == 0) {
+        auto grown = mk<ram::Conjunction>(mk<ram::Negation>(mk<ram::EmptinessCheck>(mainRelation)),
+                mk<ram::EmptinessCheck>(previousRelation));
+        auto insertion = mk<ram::Insert>(addedRelation, VecOwn<ram::Expression>());
+        appendStmt(seeds, mk<ram::Query>(mk<ram::Filter>(std::move(grown), std::move(insertion))));
+    } else {
+        VecOwn<ram::Expression> values;
+        VecOwn<ram::Expression> values2;
+        for (std::size_t i = 0; i < rel->getArity(); i++) {
+            values.push_back(mk<ram::TupleElement>(0, i));
+            values2.push_back(mk<ram::TupleElement>(0, i));
+        }
+        auto insertion = mk<ram::Filter>(
+                mk<ram::Negation>(mk<ram::ExistenceCheck>(previousRelation, std::move(values))),
+                mk<ram::Insert>(addedRelation, std::move(values2)));
+        auto grown = mk<ram::Constraint>(BinaryConstraintOp::NE, mk<ram::RelationSize>(mainRelation),
+                mk<ram::RelationSize>(previousRelation));
+        appendStmt(seeds, mk<ram::Query>(mk<ram::Filter>(
+                                  std::move(grown), mk<ram::Scan>(mainRelation, 0, std::move(insertion)))));
+    }
+    return mk<ram::Sequence>(std::move(seeds));
+}
+
+Own<ram::Statement> UnitTranslator::translateIncrementalClauses(
+        const std::set<const ast::Relation*>& scc, const ast::Relation* rel, TranslationMode mode) const {
+    VecOwn<ram::Statement> code;
+    for (auto&& clause : context->getProgram()->getClauses(*rel)) {
+        // The relations of lower strata are complete, and their added (or removed) tuples are known;
+        // tuples are only removed from changing relations
+        std::set<const ast::Relation*> lowerRelations;
+        for (const auto* atom : ast::getBodyLiterals<ast::Atom>(*clause)) {
+            const auto* atomRelation = context->getProgram()->getRelation(*atom);
+            if (contains(scc, atomRelation)) {
+                continue;
+            }
+            if (mode == IncrementalInsert || isChangingRelation(atomRelation)) {
+                lowerRelations.insert(atomRelation);
+            }
+        }
+
+        // Generate a version of the clause for each atom of a lower stratum
+        const std::size_t numVersions = getSccAtoms(clause, lowerRelations).size();
+        for (std::size_t version = 0; version < numVersions; version++) {
+            appendStmt(code, context->translateRecursiveClause(*clause, lowerRelations, version, mode));
+        }
+    }
+    return mk<ram::Sequence>(std::move(code));
+}
+
+Own<ram::Statement> UnitTranslator::generateIncrementalRederivation(const ast::Relation* rel) const {
+    VecOwn<ram::Statement> code;
+    for (auto&& clause : context->getProgram()->getClauses(*rel)) {
+        // Clauses without atoms are evaluated again in full by the seeds
+        if (ast::getBodyLiterals<ast::Atom>(*clause).empty()) {
+            continue;
+        }
+        std::ostringstream ds;
+        ds << toString(*clause) << "\nin file ";
+        ds << clause->getSrcLoc();
+        auto rule = context->translateNonRecursiveClause(*clause, IncrementalRederive);
+        appendStmt(code, mk<ram::DebugInfo>(std::move(rule), ds.str()));
+    }
+    return mk<ram::Sequence>(std::move(code));
+}
+
+/**
+ * generate RAM code over-deleting the consequences of the tuples removed from a stratum
+ *
+ * The tuples removed from relations with tuples given directly are those known
+ * to the previous evaluation that are gone.  They are put back until the
+ * stratum is evaluated, so that the relations of all strata hold their
+ * previous tuples while the consequences of the removed tuples are collected in
+ * @removed relations.  Over-deletion runs for all strata before any of them is
+ * evaluated, and the evaluation of the strata rederives the over-deleted
+ * tuples with remaining derivations (delete and rederive).
+ */
+Own<ram::Statement> UnitTranslator::generateIncrementalOverdeletion(
+        const std::set<const ast::Relation*>& scc, bool isRecursive) const {
+    VecOwn<ram::Statement> result;
+
+    // Find the removed tuples given directly
+    for (const ast::Relation* rel : scc) {
+        if (!hasExtensionalTuples(rel)) {
+            continue;
+        }
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string previousRelation = getPreviousRelationName(rel->getQualifiedName());
+        std::string removedRelation = getRemovedRelationName(rel->getQualifiedName());
+        if (rel->getArity() == 0) {
+            auto gone = mk<ram::Conjunction>(mk<ram::Negation>(mk<ram::EmptinessCheck>(previousRelation)),
+                    mk<ram::EmptinessCheck>(mainRelation));
+            auto insertion = mk<ram::Insert>(removedRelation, VecOwn<ram::Expression>());
+            appendStmt(result, mk<ram::Query>(mk<ram::Filter>(std::move(gone), std::move(insertion))));
+        } else {
+            appendStmt(result,
+                    generateMergeRelationsWithFilter(rel, removedRelation, previousRelation, mainRelation));
+        }
+        appendStmt(result, generateMergeRelations(rel, mainRelation, removedRelation));
+    }
+
+    // Over-delete the consequences of the tuples removed from lower strata
+    for (const ast::Relation* rel : scc) {
+        appendStmt(result, translateIncrementalClauses(scc, rel, IncrementalOverdelete));
+    }
+    for (const ast::Relation* rel : scc) {
+        std::string newRelation = getNewRelationName(rel->getQualifiedName());
+        std::string removedRelation = getRemovedRelationName(rel->getQualifiedName());
+        appendStmt(result, generateMergeRelations(rel, removedRelation, newRelation));
+        appendStmt(result, mk<ram::Clear>(newRelation));
+    }
+    if (!isRecursive) {
+        return mk<ram::Sequence>(std::move(result));
+    }
+
+    // Propagate all removed tuples through the recursive clauses
+    VecOwn<ram::Statement> loopBody;
+    Own<ram::Condition> exitCondition;
+    VecOwn<ram::Statement> updateTable;
+    for (const ast::Relation* rel : scc) {
+        std::string newRelation = getNewRelationName(rel->getQualifiedName());
+        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+        std::string removedRelation = getRemovedRelationName(rel->getQualifiedName());
+        appendStmt(result, generateMergeRelations(rel, deltaRelation, removedRelation));
+        appendStmt(loopBody, translateRecursiveClauses(scc, rel, IncrementalOverdeleteDelta));
+        exitCondition = addConjunctiveTerm(std::move(exitCondition), mk<ram::EmptinessCheck>(newRelation));
+        appendStmt(updateTable, generateMergeRelations(rel, removedRelation, newRelation));
+        appendStmt(updateTable, mk<ram::Swap>(deltaRelation, newRelation));
+        appendStmt(updateTable, mk<ram::Clear>(newRelation));
+    }
+    appendStmt(result, mk<ram::Loop>(mk<ram::Sequence>(mk<ram::Sequence>(std::move(loopBody)),
+                               mk<ram::Exit>(std::move(exitCondition)),
+                               mk<ram::Sequence>(std::move(updateTable)))));
+    appendStmt(result, generateStratumPostamble(scc));
+
+    return mk<ram::Sequence>(std::move(result));
+}
+
+Own<ram::Statement> UnitTranslator::generateIncrementalRetraction(
+        const std::set<const ast::Relation*>& scc) const {
+    VecOwn<ram::Statement> result;
+    for (const ast::Relation* rel : scc) {
+        if (!isChangingRelation(rel)) {
+            continue;
+        }
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string previousRelation = getPreviousRelationName(rel->getQualifiedName());
+        std::string removedRelation = getRemovedRelationName(rel->getQualifiedName());
+        std::vector<std::string> targets = {mainRelation};
+        if (hasExtensionalTuples(rel)) {
+            targets.push_back(previousRelation);
+        }
+        for (const auto& target : targets) {
+            if (rel->getArity() != 0) {
+                appendStmt(result, generateEraseTuples(rel, target, removedRelation));
+                continue;
+            }
+
+            // a proposition is kept only if it was not removed, which is computed in @new
+            std::string newRelation = getNewRelationName(rel->getQualifiedName());
+            auto kept = mk<ram::Conjunction>(mk<ram::Negation>(mk<ram::EmptinessCheck>(target)),
+                    mk<ram::EmptinessCheck>(removedRelation));
+            auto insertion = mk<ram::Insert>(newRelation, VecOwn<ram::Expression>());
+            appendStmt(result, mk<ram::Query>(mk<ram::Filter>(std::move(kept), std::move(insertion))));
+            appendStmt(result, mk<ram::Clear>(target));
+            appendStmt(result, generateMergeRelations(rel, target, newRelation));
+            appendStmt(result, mk<ram::Clear>(newRelation));
+        }
+    }
+    return mk<ram::Sequence>(std::move(result));
+}
+
+/**
+ * generate RAM code for a stratum in incremental evaluation
+ *
+ * Only the consequences of the tuples added since the previous evaluation
+ * are derived: the clauses are evaluated on the tuples added to the relations
+ * of lower strata, and the fixpoint loop is primed with the tuples added to the
+ * relations of the stratum.  The first evaluation starts from empty relations,
+ * so all tuples are added.  The tuples over-deleted from the stratum, which
+ * have been erased beforehand, are rederived if they have derivations left,
+ * and count as added.  This is only sound for monotone strata, which the
+ * semantic checker ensures.
+ */
+Own<ram::Statement> UnitTranslator::generateIncrementalStratum(
+        const std::set<const ast::Relation*>& scc, bool isRecursive) const {
+    VecOwn<ram::Statement> result;
+
+    // Forget the tuples added by the previous evaluation
+    for (const ast::Relation* rel : scc) {
+        appendStmt(result, mk<ram::Clear>(getAddedRelationName(rel->getQualifiedName())));
+    }
+
+    // Add the tuples given directly
+    for (const ast::Relation* rel : scc) {
+        appendStmt(result, generateIncrementalSeeds(rel));
+    }
+
+    // Rederive the over-deleted tuples
+    for (const ast::Relation* rel : scc) {
+        if (isChangingRelation(rel)) {
+            appendStmt(result, generateIncrementalRederivation(rel));
+        }
+    }
+
+    // Derive the tuples following from the changes of lower strata
+    for (const ast::Relation* rel : scc) {
+        appendStmt(result, translateIncrementalClauses(scc, rel, IncrementalInsert));
+    }
+    for (const ast::Relation* rel : scc) {
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string newRelation = getNewRelationName(rel->getQualifiedName());
+        std::string addedRelation = getAddedRelationName(rel->getQualifiedName());
+        appendStmt(result, generateMergeRelations(rel, mainRelation, newRelation));
+        appendStmt(result, generateMergeRelations(rel, addedRelation, newRelation));
+        appendStmt(result, mk<ram::Clear>(newRelation));
+    }
+
+    // Propagate all added tuples through the recursive clauses
+    if (isRecursive) {
+        for (const ast::Relation* rel : scc) {
+            appendStmt(result, generateMergeRelations(rel, getDeltaRelationName(rel->getQualifiedName()),
+                                       getAddedRelationName(rel->getQualifiedName())));
+        }
+        auto loopBody = generateStratumLoopBody(scc);
+        auto exitSequence = generateStratumExitSequence(scc);
+        auto updateSequence = generateStratumTableUpdates(scc);
+        appendStmt(result, mk<ram::Loop>(mk<ram::Sequence>(
+                                   std::move(loopBody), std::move(exitSequence), std::move(updateSequence))));
+        appendStmt(result, generateStratumPostamble(scc));
+    }
+
+    // Remember the tuples of the relations with tuples given directly
+    for (const ast::Relation* rel : scc) {
+        if (hasExtensionalTuples(rel)) {
+            appendStmt(result, generateMergeRelations(rel, getPreviousRelationName(rel->getQualifiedName()),
+                                       getAddedRelationName(rel->getQualifiedName())));
+        }
+    }
+
+    // Forget the removed tuples
+    for (const ast::Relation* rel : scc) {
+        if (isChangingRelation(rel)) {
+            appendStmt(result, mk<ram::Clear>(getRemovedRelationName(rel->getQualifiedName())));
+        }
+    }
+
+    return mk<ram::Sequence>(std::move(result));
+}
+
 void UnitTranslator::addAuxiliaryArity(
         const ast::Relation* /* relation */, std::map<std::string, std::string>& directives) const {
     directives.insert(std::make_pair("auxArity", "0"));
@@ -639,6 +943,15 @@ Own<ram::Relation> UnitTranslator::createRamRelation(
         representation = RelationRepresentation::DEFAULT;
     }
 
+    // Retracted tuples are erased from the changing relations of incremental evaluation
+    bool isErased = ramRelationName == getConcreteRelationName(baseRelation->getQualifiedName()) ||
+                    ramRelationName == getPreviousRelationName(baseRelation->getQualifiedName());
+    if (isErased && arity > 0 && isChangingRelation(baseRelation) &&
+            (representation == RelationRepresentation::DEFAULT ||
+                    representation == RelationRepresentation::BTREE)) {
+        representation = RelationRepresentation::BTREE_DELETE;
+    }
+
     std::vector<std::string> attributeNames;
     std::vector<std::string> attributeTypeQualifiers;
     for (const auto& attribute : baseRelation->getAttributes()) {
@@ -684,8 +997,41 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
                 std::string toEraseName = getDeleteRelationName(rel->getQualifiedName());
                 ramRelations.push_back(createRamRelation(rel, toEraseName));
             }
+
+            // Incremental evaluation requires @new and @added variants, @prev for relations with
+            // tuples given directly, and @removed for changing relations
+            if (Global::config().has("incremental")) {
+                if (!isRecursive) {
+                    std::string newName = getNewRelationName(rel->getQualifiedName());
+                    ramRelations.push_back(createRamRelation(rel, newName));
+                }
+                std::string addedName = getAddedRelationName(rel->getQualifiedName());
+                ramRelations.push_back(createRamRelation(rel, addedName));
+                if (hasExtensionalTuples(rel)) {
+                    std::string previousName = getPreviousRelationName(rel->getQualifiedName());
+                    ramRelations.push_back(createRamRelation(rel, previousName));
+                }
+                if (isChangingRelation(rel)) {
+                    std::string removedName = getRemovedRelationName(rel->getQualifiedName());
+                    ramRelations.push_back(createRamRelation(rel, removedName));
+                }
+            }
         }
     }
+
+    // Adaptive joins choose the plans of each clause version from the sizes of their leading relations
+    if (Global::config().has("adaptive-joins") && !Global::config().has("provenance")) {
+        std::vector<std::string> sizeNames;
+        for (std::size_t i = 0; i < MAX_ADAPTIVE_PLANS; i++) {
+            sizeNames.push_back("size" + std::to_string(i));
+        }
+        ramRelations.push_back(mk<ram::Relation>(getAdaptiveSizesRelationName(), MAX_ADAPTIVE_PLANS, 0,
+                sizeNames, std::vector<std::string>(MAX_ADAPTIVE_PLANS, "i:number"),
+                RelationRepresentation::DEFAULT));
+        ramRelations.push_back(mk<ram::Relation>(getAdaptivePlanRelationName(), 1, 0,
+                std::vector<std::string>({"plan"}), std::vector<std::string>({"i:number"}),
+                RelationRepresentation::DEFAULT));
+    }
     return ramRelations;
 }
 
@@ -697,6 +1043,31 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
     const auto& sccOrdering =
             translationUnit.getAnalysis<ast::analysis::TopologicallySortedSCCGraphAnalysis>().order();
 
+    // Find the relations whose tuples may be retracted in incremental evaluation
+    std::vector<std::size_t> changingStrata;
+    if (Global::config().has("incremental")) {
+        std::set<const ast::Relation*> inputs;
+        for (std::size_t scc : sccOrdering) {
+            for (const auto* rel : context->getInputRelationsInSCC(scc)) {
+                inputs.insert(rel);
+            }
+        }
+        const auto& precedenceGraph = translationUnit.getAnalysis<ast::analysis::PrecedenceGraphAnalysis>();
+        for (const auto* rel : precedenceGraph.graph().reachableFromSucc(inputs)) {
+            changingRelations.insert(rel);
+        }
+        for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+            std::size_t scc = sccOrdering.at(i);
+            const auto& sccRelations = context->getRelationsInSCC(scc);
+            if (any_of(sccRelations, [&](const ast::Relation* rel) { return isChangingRelation(rel); })) {
+                bool isRecursive = context->isRecursiveSCC(scc);
+                auto overdeletion = generateIncrementalOverdeletion(sccRelations, isRecursive);
+                addRamSubroutine("overdelete_" + toString(i), std::move(overdeletion));
+                changingStrata.push_back(i);
+            }
+        }
+    }
+
     // Create subroutines for each SCC according to topological order
     for (std::size_t i = 0; i < sccOrdering.size(); i++) {
         // Generate the main stratum code
@@ -711,8 +1082,11 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
         addRamSubroutine(stratumID, std::move(stratum));
     }
 
-    // Invoke all strata
+    // Invoke all strata, after over-deleting the consequences of retracted tuples
     VecOwn<ram::Statement> res;
+    for (std::size_t i : changingStrata) {
+        appendStmt(res, mk<ram::Call>("overdelete_" + toString(i)));
+    }
     for (std::size_t i = 0; i < sccOrdering.size(); i++) {
         appendStmt(res, mk<ram::Call>("stratum_" + toString(i)));
     }
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "ast2ram/ClauseTranslator.h"
 #include "ast2ram/UnitTranslator.h"
 #include "souffle/utility/ContainerUtil.h"
 #include <map>
@@ -49,12 +50,12 @@ protected:
     virtual Own<ram::Relation> createRamRelation(
             const ast::Relation* baseRelation, std::string ramRelationName) const;
     virtual VecOwn<ram::Relation> createRamRelations(const std::vector<std::size_t>& sccOrdering) const;
-    Own<ram::Statement> translateRecursiveClauses(
-            const std::set<const ast::Relation*>& scc, const ast::Relation* rel) const;
+    Own<ram::Statement> translateRecursiveClauses(const std::set<const ast::Relation*>& scc,
+            const ast::Relation* rel, TranslationMode mode = DEFAULT) const;
     Own<ram::Statement> translateSubsumptiveRecursiveClauses(
             const std::set<const ast::Relation*>& scc, const ast::Relation* rel) const;
-    VecOwn<ram::Statement> generateClauseVersions(
-            const ast::Clause* clause, const std::set<const ast::Relation*>& scc) const;
+    VecOwn<ram::Statement> generateClauseVersions(const ast::Clause* clause,
+            const std::set<const ast::Relation*>& scc, TranslationMode mode = DEFAULT) const;
     std::vector<ast::Atom*> getSccAtoms(
             const ast::Clause* clause, const std::set<const ast::Relation*>& scc) const;
 
@@ -81,6 +82,19 @@ protected:
     Own<ram::Statement> generateStratumTableUpdates(const std::set<const ast::Relation*>& scc) const;
     Own<ram::Statement> generateStratumExitSequence(const std::set<const ast::Relation*>& scc) const;
 
+    /** Incremental stratum translation */
+    Own<ram::Statement> generateIncrementalStratum(
+            const std::set<const ast::Relation*>& scc, bool isRecursive) const;
+    Own<ram::Statement> generateIncrementalSeeds(const ast::Relation* rel) const;
+    Own<ram::Statement> translateIncrementalClauses(const std::set<const ast::Relation*>& scc,
+            const ast::Relation* rel, TranslationMode mode) const;
+    Own<ram::Statement> generateIncrementalOverdeletion(
+            const std::set<const ast::Relation*>& scc, bool isRecursive) const;
+    Own<ram::Statement> generateIncrementalRetraction(const std::set<const ast::Relation*>& scc) const;
+    Own<ram::Statement> generateIncrementalRederivation(const ast::Relation* rel) const;
+    bool hasExtensionalTuples(const ast::Relation* rel) const;
+    bool isChangingRelation(const ast::Relation* rel) const;
+
     /** Other helper generations */
     virtual Own<ram::Statement> generateClearExpiredRelations(
             const std::set<const ast::Relation*>& expiredRelations) const;
@@ -95,6 +109,9 @@ protected:
 
 private:
     std::map<std::string, Own<ram::Statement>> ramSubroutines;
+
+    /** Relations changing with the input relations in incremental evaluation */
+    std::set<const ast::Relation*> changingRelations;
 };
 
 }  // namespace souffle::ast2ram::seminaive
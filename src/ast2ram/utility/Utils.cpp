@@ -55,6 +55,26 @@ std::string getDeleteRelationName(const ast::QualifiedName& name) {
     return getConcreteRelationName(name, "@delete_");
 }
 
+std::string getAddedRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@added_");
+}
+
+std::string getPreviousRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@prev_");
+}
+
+std::string getRemovedRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@removed_");
+}
+
+std::string getAdaptiveSizesRelationName() {
+    return "@adaptive_sizes";
+}
+
+std::string getAdaptivePlanRelationName() {
+    return "@adaptive_plan";
+}
+
 std::string getRelationName(const ast::QualifiedName& name) {
     return toString(join(name.getQualifiers(), "."));
 }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
 #include <string>
 
 namespace souffle::ast {
@@ -55,6 +56,24 @@ std::string getRejectRelationName(const ast::QualifiedName& name);
 /** Get the corresponding RAM 'delete' relation name for the relation */
 std::string getDeleteRelationName(const ast::QualifiedName& name);
 
+/** Get the corresponding RAM relation name of the tuples added to the relation by the current evaluation */
+std::string getAddedRelationName(const ast::QualifiedName& name);
+
+/** Get the corresponding RAM relation name of the tuples of the relation known to previous evaluations */
+std::string getPreviousRelationName(const ast::QualifiedName& name);
+
+/** Get the corresponding RAM relation name of the tuples removed from the relation by the evaluation */
+std::string getRemovedRelationName(const ast::QualifiedName& name);
+
+/** Maximal number of alternative plans of a clause version with adaptive joins */
+constexpr std::size_t MAX_ADAPTIVE_PLANS = 3;
+
+/** Get the RAM relation name of the sizes of the relations compared by adaptive joins */
+std::string getAdaptiveSizesRelationName();
+
+/** Get the RAM relation name of the plan chosen by adaptive joins */
+std::string getAdaptivePlanRelationName();
+
 /** Get base relation name, strip off any possible prefix */
 std::string getBaseRelationName(const ast::QualifiedName& name);
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "souffle/PrebuiltRelations.h"
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SignalHandler.h"
@@ -31,6 +32,9 @@
 #ifndef __EMBEDDED_SOUFFLE__
 #include "souffle/CompiledOptions.h"
 #endif
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 #if defined(_OPENMP)
 #include <omp.h>
@@ -44,8 +48,46 @@ inline souffle::SouffleProgram* getInstance(const char* p) {
 }
 }
 
+/** Whether relations of the given type can erase tuples of the given type */
+template <class RelType, class TupleType, class = void>
+struct is_erasable : std::false_type {};
+
+template <class RelType, class TupleType>
+struct is_erasable<RelType, TupleType,
+        std::void_t<decltype(std::declval<RelType&>().erase(std::declval<const TupleType&>()))>>
+        : std::true_type {};
+
+/**
+ * Give a relation shared with forks of its program its own copy, so that it
+ * can be written without affecting the forks.  The copy is made by inserting
+ * the tuples of the shared relation into a new one.
+ */
+template <class RelType>
+void unshareRelation(std::shared_ptr<RelType>& relation) {
+    if (relation.use_count() > 1) {
+        auto copy = std::make_shared<RelType>();
+        for (const auto& t : *relation) {
+            copy->insert(t);
+        }
+        relation = std::move(copy);
+    }
+}
+
+/** Remove all the tuples of a relation, replacing it by a new one if it is shared with forks */
+template <class RelType>
+void purgeRelation(std::shared_ptr<RelType>& relation) {
+    if (relation.use_count() > 1) {
+        relation = std::make_shared<RelType>();
+    } else {
+        relation->purge();
+    }
+}
+
 /**
  * Relation wrapper used internally in the generated Datalog program
+ *
+ * The wrapper refers to the pointer to the relation held by the program, so
+ * that it follows the copies made when a relation shared with forks is written.
  */
 template <class RelType>
 class RelationWrapper : public souffle::Relation {
@@ -55,7 +97,7 @@ public:
     using AttrStrSeq = std::array<const char*, Arity>;
 
 private:
-    RelType& relation;
+    std::shared_ptr<RelType>& relation;
     SouffleProgram& program;
     std::string name;
     AttrStrSeq attrTypes;
@@ -94,16 +136,16 @@ private:
     };
 
 public:
-    RelationWrapper(uint32_t id, RelType& r, SouffleProgram& p, std::string name, const AttrStrSeq& t,
-            const AttrStrSeq& n, arity_type numAuxAttribs)
+    RelationWrapper(uint32_t id, std::shared_ptr<RelType>& r, SouffleProgram& p, std::string name,
+            const AttrStrSeq& t, const AttrStrSeq& n, arity_type numAuxAttribs)
             : relation(r), program(p), name(std::move(name)), attrTypes(t), attrNames(n), id(id),
               numAuxAttribs(numAuxAttribs) {}
 
     iterator begin() const override {
-        return iterator(mk<iterator_wrapper>(id, this, relation.begin()));
+        return iterator(mk<iterator_wrapper>(id, this, relation->begin()));
     }
     iterator end() const override {
-        return iterator(mk<iterator_wrapper>(id, this, relation.end()));
+        return iterator(mk<iterator_wrapper>(id, this, relation->end()));
     }
 
     void insert(const tuple& arg) override {
@@ -113,7 +155,8 @@ public:
         for (std::size_t i = 0; i < Arity; i++) {
             t[i] = arg[i];
         }
-        relation.insert(t);
+        unshareRelation(relation);
+        relation->insert(t);
     }
     bool contains(const tuple& arg) const override {
         TupleType t;
@@ -121,10 +164,24 @@ public:
         for (std::size_t i = 0; i < Arity; i++) {
             t[i] = arg[i];
         }
-        return relation.contains(t);
+        return relation->contains(t);
+    }
+    bool erase(const tuple& arg) override {
+        if constexpr (is_erasable<RelType, TupleType>::value) {
+            TupleType t;
+            assert(&arg.getRelation() == this && "wrong relation");
+            assert(arg.size() == Arity && "wrong tuple arity");
+            for (std::size_t i = 0; i < Arity; i++) {
+                t[i] = arg[i];
+            }
+            unshareRelation(relation);
+            return relation->erase(t);
+        } else {
+            return false;
+        }
     }
     std::size_t size() const override {
-        return relation.size();
+        return relation->size();
     }
     std::string getName() const override {
         return name;
@@ -149,7 +206,7 @@ public:
 
     /** Eliminate all the tuples in relation*/
     void purge() override {
-        relation.purge();
+        purgeRelation(relation);
     }
 };
 
@@ -224,6 +281,9 @@ public:
     bool contains(const t_tuple& /* t */, context& /* ctxt */) const {
         return data;
     }
+    bool erase(const t_tuple& /* t */) {
+        return data.exchange(false);
+    }
     std::size_t size() const {
         return data ? 1 : 0;
     }
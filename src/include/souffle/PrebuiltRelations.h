@@ -0,0 +1,131 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file PrebuiltRelations.h
+ *
+ * Index orders shared by the relation types of compiled programs, and the
+ * data structures of common relation shapes, which are instantiated once in
+ * the souffle-relations library instead of in every compiled program.
+ *
+ * If SOUFFLE_PREBUILT_RELATIONS is defined, the instantiations are declared
+ * extern, and the program must be linked with the souffle-relations library.
+ * The library must be built with the same configuration (domain size and
+ * OpenMP support) as the program; souffle-compile takes care of both.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/BTree.h"
+#include "souffle/datastructure/Brie.h"
+#include "souffle/datastructure/EquivalenceRelation.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cstddef>
+#include <memory>
+
+namespace souffle {
+
+/**
+ * Lexicographic order of tuples on the given columns, which all hold signed
+ * numbers (or symbols, records and ADTs, which are compared by their index).
+ *
+ * The synthesiser uses it for the indices without unsigned or float columns,
+ * so that indices of the same shape have the same type in all programs.
+ */
+template <std::size_t... Columns>
+struct SignedLexOrder {
+    template <typename T>
+    int operator()(const T& a, const T& b) const {
+        return compare<Columns...>(a, b);
+    }
+
+    template <typename T>
+    bool less(const T& a, const T& b) const {
+        return compare<Columns...>(a, b) < 0;
+    }
+
+    template <typename T>
+    bool equal(const T& a, const T& b) const {
+        return ((ramBitCast<RamSigned>(a[Columns]) == ramBitCast<RamSigned>(b[Columns])) && ...);
+    }
+
+private:
+    template <std::size_t Column, std::size_t... Rest, typename T>
+    static int compare(const T& a, const T& b) {
+        const auto x = ramBitCast<RamSigned>(a[Column]);
+        const auto y = ramBitCast<RamSigned>(b[Column]);
+        if (x < y) {
+            return -1;
+        }
+        if (x > y) {
+            return 1;
+        }
+        if constexpr (sizeof...(Rest) == 0) {
+            return 0;
+        } else {
+            return compare<Rest...>(a, b);
+        }
+    }
+};
+
+/**
+ * The prebuilt btree indices, as F(kind, arity, columns...): all orders of
+ * the relations up to arity three.  Full orders are sets, the others
+ * multisets, as chosen by the synthesiser.
+ */
+#define SOUFFLE_FOR_EACH_PREBUILT_INDEX(F) \
+    F(set, 1, 0)                           \
+    F(set, 2, 0, 1)                        \
+    F(set, 2, 1, 0)                        \
+    F(multiset, 2, 0)                      \
+    F(multiset, 2, 1)                      \
+    F(set, 3, 0, 1, 2)                     \
+    F(set, 3, 0, 2, 1)                     \
+    F(set, 3, 1, 0, 2)                     \
+    F(set, 3, 1, 2, 0)                     \
+    F(set, 3, 2, 0, 1)                     \
+    F(set, 3, 2, 1, 0)                     \
+    F(multiset, 3, 0, 1)                   \
+    F(multiset, 3, 0, 2)                   \
+    F(multiset, 3, 1, 0)                   \
+    F(multiset, 3, 1, 2)                   \
+    F(multiset, 3, 2, 0)                   \
+    F(multiset, 3, 2, 1)                   \
+    F(multiset, 3, 0)                      \
+    F(multiset, 3, 1)                      \
+    F(multiset, 3, 2)
+
+#define SOUFFLE_BTREE_IS_SET_set true
+#define SOUFFLE_BTREE_IS_SET_multiset false
+
+/** Explicit instantiation of a btree index, and of its base class; PREFIX is empty or extern */
+#define SOUFFLE_PREBUILT_INDEX(PREFIX, kind, arity, ...)                                                   \
+    PREFIX template class btree_##kind<Tuple<RamDomain, arity>, SignedLexOrder<__VA_ARGS__>>;              \
+    PREFIX template class detail::btree<Tuple<RamDomain, arity>, SignedLexOrder<__VA_ARGS__>,              \
+            std::allocator<Tuple<RamDomain, arity>>, 256,                                                  \
+            typename detail::default_strategy<Tuple<RamDomain, arity>>::type, SOUFFLE_BTREE_IS_SET_##kind, \
+            SignedLexOrder<__VA_ARGS__>, detail::updater<Tuple<RamDomain, arity>>>;
+
+/** Explicit instantiation of the other relation data structures; PREFIX is empty or extern */
+#define SOUFFLE_PREBUILT_STRUCTURES(PREFIX) \
+    PREFIX template class Trie<1>;          \
+    PREFIX template class Trie<2>;          \
+    PREFIX template class Trie<3>;          \
+    PREFIX template class EquivalenceRelation<Tuple<RamDomain, 2>>;
+
+#ifdef SOUFFLE_PREBUILT_RELATIONS
+#define SOUFFLE_EXTERN_INDEX(kind, arity, ...) SOUFFLE_PREBUILT_INDEX(extern, kind, arity, __VA_ARGS__)
+SOUFFLE_FOR_EACH_PREBUILT_INDEX(SOUFFLE_EXTERN_INDEX)
+SOUFFLE_PREBUILT_STRUCTURES(extern)
+#undef SOUFFLE_EXTERN_INDEX
+#endif
+
+}  // namespace souffle
@@ -0,0 +1,244 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ProgramProgress.h
+ *
+ * Progress of the evaluation of a compiled program, which can be observed
+ * while the program is running.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif  //_WIN32
+
+namespace souffle {
+
+/**
+ * Counters of the evaluation of a program: the stratum being evaluated, the
+ * iterations of its fixpoint loop, the elapsed time, and the sizes of the
+ * relations when the strata computing them were completed.
+ *
+ * The program updates the counters at the start and the end of each stratum
+ * and once per iteration, so they are cheap to maintain.  They may be read
+ * from other threads, and from a signal handler with dump(), at any time.
+ */
+class ProgramProgress {
+public:
+    using clock = std::chrono::steady_clock;
+
+    ProgramProgress() = default;
+    ProgramProgress(const ProgramProgress&) = delete;
+    ProgramProgress& operator=(const ProgramProgress&) = delete;
+
+    /** Register a relation whose size is reported; relations are identified by registration order. */
+    void addRelation(std::string name) {
+        relationNames.push_back(std::move(name));
+        relationSizes.emplace_back(0);
+    }
+
+    // -- updates of the running program --
+
+    /** Start an evaluation of the given number of strata. */
+    void beginEvaluation(std::size_t strata) {
+        numStrata = strata;
+        completedStrata = 0;
+        stratum = NONE;
+        iteration = 0;
+        totalIterations = 0;
+        startTime = now();
+        stratumStartTime = startTime.load();
+        running = true;
+    }
+
+    /** Finish the evaluation. */
+    void endEvaluation() {
+        stratum = NONE;
+        running = false;
+    }
+
+    void beginStratum(std::size_t index) {
+        iteration = 0;
+        stratumStartTime = now();
+        stratum = index;
+    }
+
+    void endStratum() {
+        stratum = NONE;
+        iteration = 0;
+        ++completedStrata;
+    }
+
+    /** Record the completion of an iteration of the fixpoint loop of the current stratum. */
+    void nextIteration() {
+        iteration.fetch_add(1, std::memory_order_relaxed);
+        totalIterations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Record the size of the given relation. */
+    void setRelationSize(std::size_t relation, std::size_t size) {
+        relationSizes[relation].store(size, std::memory_order_relaxed);
+    }
+
+    // -- queries --
+
+    bool isRunning() const {
+        return running;
+    }
+
+    /** Whether a stratum is being evaluated, rather than the program between two strata. */
+    bool inStratum() const {
+        return stratum != NONE;
+    }
+
+    /** The stratum being evaluated; only meaningful if inStratum(). */
+    std::size_t getStratum() const {
+        return stratum;
+    }
+
+    std::size_t getNumStrata() const {
+        return numStrata;
+    }
+
+    std::size_t getCompletedStrata() const {
+        return completedStrata;
+    }
+
+    /** The number of completed iterations of the fixpoint loop of the current stratum. */
+    std::size_t getIteration() const {
+        return iteration.load(std::memory_order_relaxed);
+    }
+
+    /** The number of completed iterations of all fixpoint loops so far. */
+    std::size_t getTotalIterations() const {
+        return totalIterations.load(std::memory_order_relaxed);
+    }
+
+    /** The time since the start of the evaluation. */
+    std::chrono::nanoseconds getElapsedTime() const {
+        return std::chrono::nanoseconds(now() - startTime);
+    }
+
+    /** The time since the start of the current stratum. */
+    std::chrono::nanoseconds getStratumTime() const {
+        return std::chrono::nanoseconds(now() - stratumStartTime);
+    }
+
+    /** The size of each relation when the last stratum inserting into it was completed. */
+    std::vector<std::pair<std::string, std::size_t>> getRelationSizes() const {
+        std::vector<std::pair<std::string, std::size_t>> sizes;
+        for (std::size_t i = 0; i < relationNames.size(); ++i) {
+            sizes.emplace_back(relationNames[i], relationSizes[i].load(std::memory_order_relaxed));
+        }
+        return sizes;
+    }
+
+    /**
+     * Write the progress to the given file descriptor.
+     *
+     * Only async-signal-safe functions are used, so that the progress can be
+     * reported by a signal handler.
+     */
+    void dump(int fd) const {
+        write(fd, "Progress: ");
+        if (!running) {
+            write(fd, "not running");
+        } else if (inStratum()) {
+            write(fd, "stratum ");
+            write(fd, getStratum());
+            write(fd, ", iteration ");
+            write(fd, getIteration());
+            write(fd, ", ");
+            writeSeconds(fd, getStratumTime());
+            write(fd, " in stratum");
+        } else {
+            write(fd, "between strata");
+        }
+        write(fd, "\n  ");
+        write(fd, getCompletedStrata());
+        write(fd, " of ");
+        write(fd, getNumStrata());
+        write(fd, " strata completed, ");
+        write(fd, getTotalIterations());
+        write(fd, " iterations, ");
+        writeSeconds(fd, getElapsedTime());
+        write(fd, " elapsed\n");
+        for (std::size_t i = 0; i < relationNames.size(); ++i) {
+            write(fd, "  ");
+            write(fd, relationNames[i].c_str());
+            write(fd, ": ");
+            write(fd, relationSizes[i].load(std::memory_order_relaxed));
+            write(fd, "\n");
+        }
+    }
+
+private:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    static std::int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count();
+    }
+
+    static void write(int fd, const char* text) {
+        // a failure to report the progress is not worth handling
+        [[maybe_unused]] auto _ = ::write(fd, text, std::strlen(text));
+    }
+
+    static void write(int fd, std::size_t number) {
+        char digits[24];
+        char* pos = digits + sizeof(digits);
+        *--pos = '\0';
+        do {
+            *--pos = static_cast<char>('0' + number % 10);
+            number /= 10;
+        } while (number != 0);
+        write(fd, pos);
+    }
+
+    static void writeSeconds(int fd, std::chrono::nanoseconds time) {
+        const auto millis = static_cast<std::size_t>(std::max<std::int64_t>(0, time.count() / 1000000));
+        write(fd, millis / 1000);
+        write(fd, ".");
+        const std::size_t fraction = millis % 1000;
+        write(fd, fraction < 100 ? (fraction < 10 ? "00" : "0") : "");
+        write(fd, fraction);
+        write(fd, "s");
+    }
+
+    std::atomic<bool> running{false};
+    std::atomic<std::size_t> numStrata{0};
+    std::atomic<std::size_t> completedStrata{0};
+    std::atomic<std::size_t> stratum{NONE};
+    std::atomic<std::size_t> iteration{0};
+    std::atomic<std::size_t> totalIterations{0};
+    std::atomic<std::int64_t> startTime{0};
+    std::atomic<std::int64_t> stratumStartTime{0};
+
+    /** Relation names and sizes, in registration order; a deque keeps the atomics in place */
+    std::vector<std::string> relationNames;
+    std::deque<std::atomic<std::size_t>> relationSizes;
+};
+
+}  // namespace souffle
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "souffle/ProgramProgress.h"
 #include <atomic>
 #include <csignal>
 #include <cstdio>
@@ -78,6 +79,14 @@ public:
         msg = m;
     }
 
+    /**
+     * Set the progress of the running program, which is reported on SIGUSR1
+     * once the signal handlers are set.
+     */
+    void setProgress(const ProgramProgress* p) {
+        progress = p;
+    }
+
     /***
      * set signal handlers
      */
@@ -99,6 +108,16 @@ public:
                 perror("Failed to set SIGSEGV signal handler.");
                 exit(1);
             }
+#ifndef _WIN32
+            // progress reports
+            if (progress != nullptr) {
+                if ((prevUsr1Handler = signal(SIGUSR1, progressHandler)) == SIG_ERR) {
+                    perror("Failed to set SIGUSR1 signal handler.");
+                    exit(1);
+                }
+                isUsr1Set = true;
+            }
+#endif
             isSet = true;
         }
     }
@@ -123,6 +142,16 @@ public:
                 perror("Failed to reset SIGSEGV signal handler.");
                 exit(1);
             }
+#ifndef _WIN32
+            // progress reports
+            if (isUsr1Set) {
+                if (signal(SIGUSR1, prevUsr1Handler) == SIG_ERR) {
+                    perror("Failed to reset SIGUSR1 signal handler.");
+                    exit(1);
+                }
+                isUsr1Set = false;
+            }
+#endif
             isSet = false;
         }
     }
@@ -145,8 +174,12 @@ private:
     std::atomic<const char*> msg;
     static_assert(decltype(msg)::is_always_lock_free, "cannot safely use in signal handler");
 
+    // progress of the running program
+    std::atomic<const ProgramProgress*> progress{nullptr};
+
     // state of signal handler
     bool isSet = false;
+    bool isUsr1Set = false;
 
     bool logMessages = false;
 
@@ -154,6 +187,7 @@ private:
     void (*prevFpeHandler)(int) = nullptr;
     void (*prevIntHandler)(int) = nullptr;
     void (*prevSegVHandler)(int) = nullptr;
+    void (*prevUsr1Handler)(int) = nullptr;
 
     /**
      * Signal handler for various types of signals.
@@ -193,6 +227,15 @@ private:
         std::_Exit(EXIT_FAILURE);
     }
 
+    /**
+     * Signal handler reporting the progress of the running program, which continues.
+     */
+    static void progressHandler(int) {
+        if (const ProgramProgress* progress = instance()->progress) {
+            progress->dump(STDERR_FILENO);
+        }
+    }
+
     SignalHandler() : msg(nullptr) {}
 };
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "souffle/ProgramProgress.h"
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
@@ -300,6 +301,18 @@ public:
      */
     virtual bool contains(const tuple& t) const = 0;
 
+    /**
+     * Erase a tuple from the relation.
+     * Only relations whose representation supports erasure erase tuples, such as
+     * the relations of programs compiled for incremental evaluation.
+     *
+     * @param t Reference to a tuple object
+     * @return Boolean. True, if the tuple existed and was erased. False, otherwise
+     */
+    virtual bool erase(const tuple& /* t */) {
+        return false;
+    }
+
     /**
      * Return an iterator pointing to the first tuple of the relation.
      * This iterator is used to access the tuples of the relation.
@@ -733,6 +746,11 @@ protected:
      */
     bool pruneImdtRels = true;
 
+    /**
+     * Progress of the evaluation, updated by the running program.
+     */
+    ProgramProgress progress;
+
     /**
      * Add the relation to relationMap (with its name) and allRelations,
      * depends on the properties of the relation, if the relation is an input relation, it will be added to
@@ -747,6 +765,7 @@ protected:
     void addRelation(const std::string& name, Relation& rel, bool isInput, bool isOutput) {
         relationMap[name] = &rel;
         allRelations.push_back(&rel);
+        progress.addRelation(name);
         if (isInput) {
             inputRelations.push_back(&rel);
         }
@@ -830,6 +849,14 @@ public:
         return numThreads;
     }
 
+    /**
+     * Get the progress of the evaluation, which may be queried while the program is running
+     * (e.g. from another thread). Relations are reported in the order of getAllRelations().
+     */
+    const ProgramProgress& getProgress() const {
+        return progress;
+    }
+
     /**
      * Get Relation by its name from relationMap, if relation not found, return a nullptr.
      *
@@ -935,6 +962,21 @@ public:
      */
     virtual RecordTable& getRecordTable() = 0;
 
+    /**
+     * Fork the program: the new instance shares the relations, the symbol table and the record
+     * table of this one, and may be run on additional facts without affecting it.
+     *
+     * Relations are shared copy-on-write; a relation is copied when it is first written by either
+     * instance, so that only the relations touched by a run are duplicated.  The symbol and record
+     * tables are only ever extended, and remain shared.  Neither instance may be running while it
+     * is forked, and each instance is used by one thread at a time.
+     *
+     * @return the new instance, or null if the program cannot be forked
+     */
+    virtual std::unique_ptr<SouffleProgram> fork() {
+        return nullptr;
+    }
+
     /**
      * Remove all the tuples from the outputRelations, calling the purge method of each.
      *
@@ -22,10 +22,13 @@
 #include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <deque>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -117,6 +120,119 @@ public:
         auto Res = Base::findOrInsert(symbol);
         return std::make_pair(Res.first, Res.second);
     }
+
+    /**
+     * @brief Assign order-preserving ranks to all symbols currently in the table.
+     *
+     * Symbol indices are handed out in insertion order, hence comparing two
+     * symbols lexicographically requires decoding both. Once ranked, two
+     * symbols are compared by their ranks instead. Symbols inserted after this
+     * call remain unranked and are compared by their string value until the
+     * ranks are recomputed.
+     * This function is not thread-safe, do not call when other threads are using the datastructure.
+     */
+    void computeOrder() {
+        rankSymbols();
+        orderStale.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief Have the symbols ranked again by the next comparison, e.g. after loading a relation.
+     *
+     * Unlike computeOrder, this is cheap, so that loading many relations ranks
+     * the symbols once rather than after each of them.
+     * This function is not thread-safe, do not call when other threads are using the datastructure.
+     */
+    void invalidateOrder() {
+        orderStale.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Compare the symbols with the given indices lexicographically.
+     *
+     * @return a negative value, zero or a positive value if the first symbol
+     * is respectively less than, equal to or greater than the second symbol.
+     */
+    int compare(const RamDomain lhs, const RamDomain rhs) const {
+        if (lhs == rhs) {
+            return 0;
+        }
+        if (orderStale.load(std::memory_order_acquire)) {
+            refreshOrder();
+        }
+        const std::size_t lhsRank = rankOf(lhs);
+        const std::size_t rhsRank = rankOf(rhs);
+        if (lhsRank != UNRANKED && rhsRank != UNRANKED) {
+            return lhsRank < rhsRank ? -1 : 1;
+        }
+        return decode(lhs).compare(decode(rhs));
+    }
+
+    /** @brief Return the index of the lexicographically smallest of the given symbols. */
+    RamDomain minimum(std::initializer_list<RamDomain> indices) const {
+        return *std::min_element(indices.begin(), indices.end(),
+                [&](RamDomain lhs, RamDomain rhs) { return compare(lhs, rhs) < 0; });
+    }
+
+    /** @brief Return the index of the lexicographically greatest of the given symbols. */
+    RamDomain maximum(std::initializer_list<RamDomain> indices) const {
+        return *std::max_element(indices.begin(), indices.end(),
+                [&](RamDomain lhs, RamDomain rhs) { return compare(lhs, rhs) < 0; });
+    }
+
+private:
+    /** Rank the symbols currently in the table */
+    void rankSymbols() const {
+        std::vector<std::pair<const std::string*, std::size_t>> symbols;
+        std::size_t maxIndex = 0;
+        for (const auto& entry : *this) {
+            symbols.emplace_back(&entry.first, entry.second);
+            maxIndex = std::max(maxIndex, entry.second);
+        }
+        if (symbols.size() == numRanked) {
+            return;
+        }
+        std::sort(symbols.begin(), symbols.end(),
+                [](const auto& lhs, const auto& rhs) { return *lhs.first < *rhs.first; });
+        ranks.assign(maxIndex + 1, UNRANKED);
+        for (std::size_t rank = 0; rank < symbols.size(); ++rank) {
+            ranks[symbols[rank].second] = rank;
+        }
+        numRanked = symbols.size();
+    }
+
+    /**
+     * Rank the symbols on the first comparison after the order was invalidated; the threads comparing
+     * symbols concurrently wait for the first of them to rank the symbols
+     */
+    void refreshOrder() const {
+        const std::lock_guard<std::mutex> guard(orderMutex);
+        if (orderStale.load(std::memory_order_relaxed)) {
+            rankSymbols();
+            orderStale.store(false, std::memory_order_release);
+        }
+    }
+
+    /** Rank of a symbol that has been inserted after the symbols were last ranked */
+    static constexpr std::size_t UNRANKED = std::numeric_limits<std::size_t>::max();
+
+    /** Return the rank of the symbol with the given index, or UNRANKED */
+    std::size_t rankOf(const RamDomain index) const {
+        const auto i = static_cast<std::size_t>(index);
+        return i < ranks.size() ? ranks[i] : UNRANKED;
+    }
+
+    /** Maps symbol indices to their lexicographic rank */
+    mutable std::vector<std::size_t> ranks;
+
+    /** Number of symbols ranked when the symbols were last ranked */
+    mutable std::size_t numRanked = 0;
+
+    /** If the symbols have to be ranked again before the next comparison */
+    mutable std::atomic<bool> orderStale{false};
+
+    /** Serialises the ranking of the symbols by concurrent comparisons */
+    mutable std::mutex orderMutex;
 };
 
 }  // namespace souffle
@@ -1732,6 +1732,28 @@ public:
         }
     }
 
+    /**
+     * Obtains the lower boundaries of a batch of keys, as lower_bound would for
+     * each of them. The keys are looked up together, level by level, and the
+     * node visited next by each lookup is prefetched, such that the cache misses
+     * of the lookups overlap instead of adding up.
+     *
+     * @param keys .. the keys to be looked up
+     * @param n .. the number of keys
+     * @param out .. the array receiving the n boundaries
+     */
+    void lower_bounds(const Key* keys, std::size_t n, iterator* out) const {
+        batched_bounds<true>(keys, n, out);
+    }
+
+    /**
+     * Obtains the upper boundaries of a batch of keys, as upper_bound would for
+     * each of them, looking them up like lower_bounds.
+     */
+    void upper_bounds(const Key* keys, std::size_t n, iterator* out) const {
+        batched_bounds<false>(keys, n, out);
+    }
+
     /**
      * Clears this tree.
      */
@@ -1945,6 +1967,66 @@ protected:
     }
 
 private:
+    /** The number of lookups of lower_bounds and upper_bounds progressing together */
+    static constexpr std::size_t lookup_batch_size = 16;
+
+    /** Loads the given node into the cache ahead of its use. */
+    static void prefetch(const node* cur) {
+#if defined(__GNUC__) || defined(__clang__)
+        const auto* bytes = reinterpret_cast<const char*>(cur);
+        for (std::size_t offset = 0; offset < sizeof(node); offset += 64) {
+            __builtin_prefetch(bytes + offset);
+        }
+#else
+        (void)cur;
+#endif
+    }
+
+    /** The implementation of lower_bounds and upper_bounds. */
+    template <bool lower>
+    void batched_bounds(const Key* keys, std::size_t n, iterator* out) const {
+        for (std::size_t first = 0; first < n; first += lookup_batch_size) {
+            const std::size_t count = std::min(lookup_batch_size, n - first);
+
+            // the node each lookup is visiting next, or null if it is complete
+            const node* cur[lookup_batch_size];
+            for (std::size_t i = 0; i < count; ++i) {
+                cur[i] = root;
+                out[first + i] = end();
+            }
+
+            bool active = (root != nullptr);
+            while (active) {
+                active = false;
+                for (std::size_t i = 0; i < count; ++i) {
+                    const node* at = cur[i];
+                    if (at == nullptr) {
+                        continue;
+                    }
+                    const Key& k = keys[first + i];
+                    auto a = &(at->keys[0]);
+                    auto b = &(at->keys[at->numElements]);
+
+                    auto pos = lower ? search.lower_bound(k, a, b, comp) : search.upper_bound(k, a, b, comp);
+                    auto idx = static_cast<field_index_type>(pos - a);
+
+                    if (pos != b) {
+                        out[first + i] = iterator(at, idx);
+                    }
+
+                    if (!at->inner || (lower && isSet && pos != b && equal(*pos, k))) {
+                        cur[i] = nullptr;
+                        continue;
+                    }
+
+                    cur[i] = at->getChild(idx);
+                    prefetch(cur[i]);
+                    active = true;
+                }
+            }
+        }
+    }
+
     /**
      * Determines whether the range covered by this node covers
      * the upper bound of the given key.
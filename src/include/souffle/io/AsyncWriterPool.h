@@ -0,0 +1,180 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file AsyncWriterPool.h
+ *
+ * Writes output relations in the background, so that formatting,
+ * compression and disk IO overlap with the remaining evaluation.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/IOSystem.h"
+#include "souffle/io/WriteStream.h"
+#include "souffle/utility/ParallelUtil.h"
+#include "souffle/utility/span.h"
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A copy of the tuples of a relation, which can be written while the
+ * relation itself keeps changing.
+ */
+class RelationSnapshot {
+public:
+    template <typename T>
+    RelationSnapshot(const T& relation, const std::size_t arity) : arity(arity) {
+        data.reserve(relation.size() * arity);
+        for (const auto& tuple : relation) {
+            const RamDomain* values = dataOf(tuple);
+            data.insert(data.end(), values, values + arity);
+            ++count;
+        }
+    }
+
+    class iterator {
+    public:
+        iterator(const RelationSnapshot& snapshot, std::size_t row) : snapshot(snapshot), row(row) {}
+
+        const RamDomain* operator*() const {
+            return snapshot.data.data() + row * snapshot.arity;
+        }
+
+        iterator& operator++() {
+            ++row;
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const {
+            return row == other.row;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return row != other.row;
+        }
+
+    private:
+        const RelationSnapshot& snapshot;
+        std::size_t row;
+    };
+
+    iterator begin() const {
+        return iterator(*this, 0);
+    }
+
+    iterator end() const {
+        return iterator(*this, count);
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+private:
+    static const RamDomain* dataOf(const RamDomain* tuple) {
+        return tuple;
+    }
+
+    template <typename Tuple>
+    static const RamDomain* dataOf(const Tuple& tuple) {
+        return tcb::make_span(tuple).data();
+    }
+
+    const std::size_t arity;
+    std::size_t count = 0;
+    std::vector<RamDomain> data;
+};
+
+/**
+ * Hands output relations to background writers.
+ *
+ * A relation is copied into a snapshot when it is stored, so it may be
+ * modified or cleared right after.  The writers decode symbols and records
+ * while the evaluation continues, which relies on the locking of the
+ * concurrent symbol and record tables; sequential builds therefore write
+ * immediately.  Output to the standard output is always written immediately
+ * to keep it in program order.
+ *
+ * Errors of background writers are reported by wait().
+ */
+class AsyncWriterPool {
+public:
+    AsyncWriterPool() : maxPending(std::max(1u, std::thread::hardware_concurrency())) {}
+
+    /** Waits for the pending writes; their errors must be collected with wait() beforehand. */
+    ~AsyncWriterPool() {
+        for (auto& write : pending) {
+            write.wait();
+        }
+    }
+
+    /** Write the given relation of the given arity, as requested by the IO directives. */
+    template <typename T>
+    void writeAll(const std::map<std::string, std::string>& directives, const SymbolTable& symbolTable,
+            const RecordTable& recordTable, const T& relation, [[maybe_unused]] const std::size_t arity) {
+        auto writer = IOSystem::getInstance().getWriter(directives, symbolTable, recordTable);
+#ifdef IS_PARALLEL
+        const std::string& io = directives.at("IO");
+        if (io != "stdout" && io != "stdoutprintsize") {
+            // bound the number of snapshots held at the same time
+            if (pending.size() >= maxPending) {
+                pending.front().get();
+                pending.pop_front();
+            }
+            auto snapshot = std::make_shared<RelationSnapshot>(relation, arity);
+            pending.push_back(std::async(std::launch::async, [writer = std::move(writer), snapshot]() mutable {
+                writer->writeAll(*snapshot);
+                // streams may complete their output on destruction
+                writer.reset();
+            }));
+            return;
+        }
+#endif
+        writer->writeAll(relation);
+    }
+
+    /** Wait for all pending writes, and rethrow the first error that occurred. */
+    void wait() {
+        std::exception_ptr error;
+        while (!pending.empty()) {
+            try {
+                pending.front().get();
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            pending.pop_front();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    const std::size_t maxPending;
+    std::deque<std::future<void>> pending;
+};
+
+}  // namespace souffle
@@ -0,0 +1,110 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BinaryFormat.h
+ *
+ * Layout of the columnar binary fact files used by IO="binary".
+ *
+ * A file consists of, in this order:
+ *  - the header (see BinaryHeader),
+ *  - one kind byte per column,
+ *  - the symbol dictionary: for each symbol its length (uint32) and bytes,
+ *  - the record dictionary: for each record its arity (uint32), one kind
+ *    byte per field, and the field values (RamDomain),
+ *  - zero bytes up to the next multiple of COLUMN_ALIGNMENT,
+ *  - the columns: numTuples values (RamDomain) per column.
+ *
+ * Values of kind SYMBOL are indices into the symbol dictionary; values of
+ * kind RECORD are zero for nil, and one plus an index into the record
+ * dictionary otherwise.  Records are stored after all records they refer to.
+ * All numbers are stored in the byte order of the writing machine; the
+ * header records it so that a reader can reject foreign files.  As the
+ * columns are aligned and of fixed width, they can be mapped into memory.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/io/SerialisationStream.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace souffle::binary {
+
+/** Kind of a stored value */
+enum Kind : char {
+    VALUE = 'v',
+    SYMBOL = 's',
+    RECORD = 'r',
+};
+
+constexpr char MAGIC[8] = {'S', 'O', 'U', 'F', 'F', 'L', 'E', 'B'};
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::size_t COLUMN_ALIGNMENT = 8;
+
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t domainSize;
+    std::uint64_t arity;
+    std::uint64_t numTuples;
+    std::uint64_t numSymbols;
+    std::uint64_t numRecords;
+};
+
+/** Kind used to store values of the given type */
+inline char kindOf(const TypeDescriptor& type) {
+    switch (type.kind) {
+        case 's': return SYMBOL;
+        case 'r': return RECORD;
+        case '+': return type.isEnum ? VALUE : RECORD;
+        default: return VALUE;
+    }
+}
+
+template <typename T>
+void write(std::ostream& out, const T* values, std::size_t count = 1) {
+    out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(sizeof(T) * count));
+    if (!out) {
+        throw std::runtime_error("Cannot write binary fact file");
+    }
+}
+
+/** Read values from the given position of a file in memory, and advance the position past them */
+template <typename T>
+void read(const char* data, const std::size_t size, std::size_t& offset, T* values, std::size_t count = 1) {
+    const std::size_t bytes = sizeof(T) * count;
+    if (bytes / sizeof(T) != count || size - offset < bytes) {
+        throw std::runtime_error("Unexpected end of binary fact file");
+    }
+    std::memcpy(values, data + offset, bytes);
+    offset += bytes;
+}
+
+/** Number of padding bytes in front of the columns starting at the given offset */
+inline std::size_t columnPadding(const std::streamoff offset) {
+    return (COLUMN_ALIGNMENT - static_cast<std::size_t>(offset) % COLUMN_ALIGNMENT) % COLUMN_ALIGNMENT;
+}
+
+inline void checkHeader(const BinaryHeader& header) {
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a binary fact file");
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK || header.domainSize != sizeof(RamDomain)) {
+        throw std::runtime_error("Binary fact file was written by an incompatible build");
+    }
+}
+
+}  // namespace souffle::binary
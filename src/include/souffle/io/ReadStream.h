@@ -24,6 +24,7 @@
 #include "souffle/utility/json11.h"
 #include <cctype>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -42,6 +43,9 @@ protected:
 public:
     template <typename T>
     void readAll(T& relation) {
+        if (readAllChunked([&](const RamDomain* tuple) { relation.insert(tuple); })) {
+            return;
+        }
         while (const auto next = readNextTuple()) {
             const RamDomain* ramDomain = next.get();
             relation.insert(ramDomain);
@@ -53,72 +57,42 @@ protected:
      * Read a record from a string.
      *
      * @param source - string containing a record
-     * @param recordTypeName - record type.
+     * @param type - record type.
      * @parem pos - start parsing from this position.
      * @param consumed - if not nullptr: number of characters read.
      *
      */
-    RamDomain readRecord(const std::string& source, const std::string& recordTypeName, std::size_t pos = 0,
+    RamDomain readRecord(const std::string& source, const TypeDescriptor& type, std::size_t pos = 0,
             std::size_t* charactersRead = nullptr) {
         const std::size_t initial_position = pos;
 
         // Check if record type information are present
-        auto&& recordInfo = types["records"][recordTypeName];
-        if (recordInfo.is_null()) {
-            throw std::invalid_argument("Missing record type information: " + recordTypeName);
+        if (!type.known) {
+            throw std::invalid_argument("Missing record type information: " + type.name);
         }
 
         // Handle nil case
         consumeWhiteSpace(source, pos);
-        if (source.substr(pos, 3) == "nil") {
+        if (source.compare(pos, 3, "nil") == 0) {
             if (charactersRead != nullptr) {
                 *charactersRead = 3;
             }
             return 0;
         }
 
-        auto&& recordTypes = recordInfo["types"];
-        const std::size_t recordArity = recordInfo["arity"].long_value();
+        const std::size_t recordArity = type.fields.size();
 
         std::vector<RamDomain> recordValues(recordArity);
 
         consumeChar(source, '[', pos);
 
         for (std::size_t i = 0; i < recordArity; ++i) {
-            const std::string& recordType = recordTypes[i].string_value();
-            std::size_t consumed = 0;
-
             if (i > 0) {
                 consumeChar(source, ',', pos);
             }
             consumeWhiteSpace(source, pos);
-            switch (recordType[0]) {
-                case 's': {
-                    recordValues[i] = symbolTable.encode(readSymbol(source, ",]", pos, &consumed));
-                    break;
-                }
-                case 'i': {
-                    recordValues[i] = RamSignedFromString(source.substr(pos), &consumed);
-                    break;
-                }
-                case 'u': {
-                    recordValues[i] = ramBitCast(RamUnsignedFromString(source.substr(pos), &consumed));
-                    break;
-                }
-                case 'f': {
-                    recordValues[i] = ramBitCast(RamFloatFromString(source.substr(pos), &consumed));
-                    break;
-                }
-                case 'r': {
-                    recordValues[i] = readRecord(source, recordType, pos, &consumed);
-                    break;
-                }
-                case '+': {
-                    recordValues[i] = readADT(source, recordType, pos, &consumed);
-                    break;
-                }
-                default: fatal("Invalid type attribute");
-            }
+            std::size_t consumed = 0;
+            recordValues[i] = readValue(source, typeDescriptors[type.fields[i]], ",]", pos, &consumed);
             pos += consumed;
         }
         consumeChar(source, ']', pos);
@@ -130,7 +104,7 @@ protected:
         return recordTable.pack(recordValues.data(), recordValues.size());
     }
 
-    RamDomain readADT(const std::string& source, const std::string& adtName, std::size_t pos = 0,
+    RamDomain readADT(const std::string& source, const TypeDescriptor& type, std::size_t pos = 0,
             std::size_t* charactersRead = nullptr) {
         const std::size_t initial_position = pos;
 
@@ -138,33 +112,20 @@ protected:
         // [branchIdx, [branchValues...]]
         // [branchIdx, branchValue]
         // branchIdx
-        RamDomain branchIdx = -1;
-
-        auto&& adtInfo = types["ADTs"][adtName];
-        const auto& branches = adtInfo["branches"];
-
-        if (adtInfo.is_null() || !branches.is_array()) {
-            throw std::invalid_argument("Missing ADT information: " + adtName);
+        if (!type.known) {
+            throw std::invalid_argument("Missing ADT information: " + type.name);
         }
 
         // Consume initial character
         consumeChar(source, '$', pos);
         std::string constructor = readIdentifier(source, pos);
 
-        json11::Json branchInfo = [&]() -> json11::Json {
-            for (auto branch : branches.array_items()) {
-                ++branchIdx;
-
-                if (branch["name"].string_value() == constructor) {
-                    return branch;
-                }
-            }
-
+        auto branchPos = type.branchIndex.find(constructor);
+        if (branchPos == type.branchIndex.end()) {
             throw std::invalid_argument("Missing branch information: " + constructor);
-        }();
-
-        assert(branchInfo["types"].is_array());
-        auto branchTypes = branchInfo["types"].array_items();
+        }
+        const auto branchIdx = static_cast<RamDomain>(branchPos->second);
+        const auto& branchTypes = type.branches[branchPos->second].types;
 
         // Handle a branch without arguments.
         if (branchTypes.empty()) {
@@ -172,7 +133,7 @@ protected:
                 *charactersRead = pos - initial_position;
             }
 
-            if (adtInfo["enum"].bool_value()) {
+            if (type.isEnum) {
                 return branchIdx;
             }
 
@@ -186,43 +147,12 @@ protected:
         std::vector<RamDomain> branchArgs(branchTypes.size());
 
         for (std::size_t i = 0; i < branchTypes.size(); ++i) {
-            auto argType = branchTypes[i].string_value();
-            assert(!argType.empty());
-
-            std::size_t consumed = 0;
-
             if (i > 0) {
                 consumeChar(source, ',', pos);
             }
             consumeWhiteSpace(source, pos);
-
-            switch (argType[0]) {
-                case 's': {
-                    branchArgs[i] = symbolTable.encode(readSymbol(source, ",)", pos, &consumed));
-                    break;
-                }
-                case 'i': {
-                    branchArgs[i] = RamSignedFromString(source.substr(pos), &consumed);
-                    break;
-                }
-                case 'u': {
-                    branchArgs[i] = ramBitCast(RamUnsignedFromString(source.substr(pos), &consumed));
-                    break;
-                }
-                case 'f': {
-                    branchArgs[i] = ramBitCast(RamFloatFromString(source.substr(pos), &consumed));
-                    break;
-                }
-                case 'r': {
-                    branchArgs[i] = readRecord(source, argType, pos, &consumed);
-                    break;
-                }
-                case '+': {
-                    branchArgs[i] = readADT(source, argType, pos, &consumed);
-                    break;
-                }
-                default: fatal("Invalid type attribute");
-            }
+            std::size_t consumed = 0;
+            branchArgs[i] = readValue(source, typeDescriptors[branchTypes[i]], ",)", pos, &consumed);
             pos += consumed;
         }
 
@@ -245,6 +175,22 @@ protected:
         return recordTable.pack(rec, 2);
     }
 
+    /**
+     * Read a record field or an ADT argument; a symbol ends before any of the given stopChars.
+     */
+    RamDomain readValue(const std::string& source, const TypeDescriptor& type, const char* stopChars,
+            const std::size_t pos, std::size_t* charactersRead) {
+        switch (type.kind) {
+            case 's': return symbolTable.encode(readSymbol(source, stopChars, pos, charactersRead));
+            case 'i': return RamSignedFromString(source.substr(pos), charactersRead);
+            case 'u': return ramBitCast(RamUnsignedFromString(source.substr(pos), charactersRead));
+            case 'f': return ramBitCast(RamFloatFromString(source.substr(pos), charactersRead));
+            case 'r': return readRecord(source, type, pos, charactersRead);
+            case '+': return readADT(source, type, pos, charactersRead);
+            default: fatal("Invalid type attribute");
+        }
+    }
+
     /**
      * Read the next alphanumeric + ('_', '?') sequence (corresponding to IDENT).
      * Consume preceding whitespace.
@@ -381,6 +327,17 @@ protected:
     }
 
     virtual Own<RamDomain[]> readNextTuple() = 0;
+
+    /**
+     * Read all remaining tuples, possibly on several threads, and pass each of
+     * them to the given callback. The callback must tolerate concurrent calls.
+     *
+     * Returns false if the stream cannot be read in chunks, in which case
+     * nothing has been consumed.
+     */
+    virtual bool readAllChunked(const std::function<void(const RamDomain*)>& /* insert */) {
+        return false;
+    }
 };
 
 class ReadStreamFactory {
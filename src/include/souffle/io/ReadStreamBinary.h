@@ -0,0 +1,317 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReadStreamBinary.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFormat.h"
+#include "souffle/io/ReadStream.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FileUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace souffle {
+
+/**
+ * Reads a relation from the columnar binary format described in BinaryFormat.h.
+ *
+ * The file is mapped into memory where possible, so that the columns of
+ * plain values are used in place.  The dictionaries are decoded into the
+ * symbol and record tables first, and the columns of symbols and records
+ * are translated into them; the tuples are then assembled from the columns,
+ * on several threads if possible.
+ */
+class ReadFileBinary : public ReadStream {
+public:
+    ReadFileBinary(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable)
+            : ReadStream(rwOperation, symbolTable, recordTable), fileName(getFileName(rwOperation)) {
+        if (!open()) {
+            // suppress error message in case file cannot be open when flag -w is set
+            if (getOr(rwOperation, "no-warn", "false") != "true") {
+                throw std::invalid_argument("Cannot open fact file " + baseName(fileName) + "\n");
+            }
+            loaded = true;
+        }
+    }
+
+    ReadFileBinary(const ReadFileBinary&) = delete;
+    ReadFileBinary& operator=(const ReadFileBinary&) = delete;
+
+    ~ReadFileBinary() override {
+#ifndef _WIN32
+        if (mapping != nullptr) {
+            munmap(mapping, size);
+        }
+#endif
+    }
+
+protected:
+    /**
+     * Read and return the next tuple.
+     *
+     * Returns nullptr if no tuple was readable.
+     * @return
+     */
+    Own<RamDomain[]> readNextTuple() override {
+        load();
+        if (nextTuple >= numTuples) {
+            return nullptr;
+        }
+        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
+        assemble(nextTuple++, tuple.get());
+        return tuple;
+    }
+
+    bool readAllChunked(const std::function<void(const RamDomain*)>& insert) override {
+        load();
+        // rows are handed out in blocks to keep the scheduling overhead low
+        constexpr std::size_t BLOCK_SIZE = 4096;
+        const std::size_t first = nextTuple;
+        const auto numBlocks = static_cast<std::int64_t>((numTuples - first + BLOCK_SIZE - 1) / BLOCK_SIZE);
+        PARALLEL_START
+        std::vector<RamDomain> tuple(typeAttributes.size());
+        pfor(std::int64_t block = 0; block < numBlocks; ++block) {
+            const std::size_t begin = first + static_cast<std::size_t>(block) * BLOCK_SIZE;
+            const std::size_t end = std::min(begin + BLOCK_SIZE, numTuples);
+            for (std::size_t row = begin; row < end; ++row) {
+                assemble(row, tuple.data());
+                insert(tuple.data());
+            }
+        }
+        PARALLEL_END
+        nextTuple = numTuples;
+        return true;
+    }
+
+    /** Copy the given row of the columns into a tuple. */
+    void assemble(const std::size_t row, RamDomain* tuple) const {
+        for (std::size_t col = 0; col < arity; ++col) {
+            tuple[col] = columns[col][row];
+        }
+    }
+
+    /**
+     * Map the file into memory, or read it if it cannot be mapped, e.g. as it is a pipe.
+     * Returns false if the file cannot be opened.
+     */
+    bool open() {
+#ifndef _WIN32
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat status;
+        if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+            const auto length = static_cast<std::size_t>(status.st_size);
+            void* map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                mapping = map;
+                data = static_cast<const char*>(map);
+                size = length;
+            }
+        }
+        ::close(fd);
+        if (mapping != nullptr) {
+            return true;
+        }
+#endif
+        std::ifstream file(fileName, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        const std::vector<char> bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        // copy into values, so that the columns are aligned for reading them in place
+        contents.resize((bytes.size() + sizeof(RamDomain) - 1) / sizeof(RamDomain));
+        std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(contents.data()));
+        data = reinterpret_cast<const char*>(contents.data());
+        size = bytes.size();
+        return true;
+    }
+
+    /** Decode the dictionaries and locate the columns, translating references into the current tables */
+    void load() {
+        if (loaded) {
+            return;
+        }
+        loaded = true;
+        try {
+            std::size_t offset = 0;
+            binary::BinaryHeader header;
+            binary::read(data, size, offset, &header);
+            binary::checkHeader(header);
+            if (header.arity != arity) {
+                std::stringstream errorMessage;
+                errorMessage << "Expected " << arity << " columns, found " << header.arity << "\n";
+                throw std::runtime_error(errorMessage.str());
+            }
+
+            std::vector<char> columnKinds(arity);
+            binary::read(data, size, offset, columnKinds.data(), arity);
+            for (std::size_t col = 0; col < arity; ++col) {
+                if (columnKinds[col] != binary::kindOf(typeDescriptors[attributeTypes[col]])) {
+                    throw std::runtime_error("Column " + std::to_string(col) + " does not match type " +
+                                             typeAttributes[col] + "\n");
+                }
+            }
+
+            symbols.resize(header.numSymbols);
+            std::string symbol;
+            for (auto& ref : symbols) {
+                std::uint32_t length;
+                binary::read(data, size, offset, &length);
+                symbol.resize(length);
+                binary::read(data, size, offset, symbol.data(), length);
+                ref = symbolTable.encode(symbol);
+            }
+
+            records.resize(header.numRecords);
+            std::vector<char> kinds;
+            std::vector<RamDomain> values;
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                std::uint32_t recordArity;
+                binary::read(data, size, offset, &recordArity);
+                kinds.resize(recordArity);
+                values.resize(recordArity);
+                binary::read(data, size, offset, kinds.data(), recordArity);
+                binary::read(data, size, offset, values.data(), recordArity);
+                for (std::size_t j = 0; j < recordArity; ++j) {
+                    // records only refer to records stored before them
+                    values[j] = translate(kinds[j], values[j], i);
+                }
+                records[i] = recordTable.pack(values.data(), recordArity);
+            }
+            offset += binary::columnPadding(static_cast<std::streamoff>(offset));
+
+            numTuples = header.numTuples;
+            if (arity > 0 && (size - std::min(offset, size)) / sizeof(RamDomain) / arity < numTuples) {
+                throw std::runtime_error("Unexpected end of binary fact file");
+            }
+            columns.resize(arity);
+            translated.resize(arity);
+            for (std::size_t col = 0; col < arity; ++col) {
+                // the offset is aligned, and so are the mapping and the contents read from the file
+                const auto* column = reinterpret_cast<const RamDomain*>(data + offset);
+                offset += numTuples * sizeof(RamDomain);
+                if (columnKinds[col] == binary::VALUE) {
+                    columns[col] = column;
+                    continue;
+                }
+                translated[col].resize(numTuples);
+                for (std::size_t row = 0; row < numTuples; ++row) {
+                    translated[col][row] = translate(columnKinds[col], column[row], records.size());
+                }
+                columns[col] = translated[col].data();
+            }
+        } catch (std::exception& e) {
+            throw std::invalid_argument(std::string(e.what()) + "\ncannot parse fact file " +
+                                        baseName(fileName) + "!\n");
+        }
+    }
+
+    /** Translate a stored value into the current symbol or record table. */
+    RamDomain translate(const char kind, const RamDomain value, const std::size_t numKnownRecords) const {
+        switch (kind) {
+            case binary::VALUE: return value;
+            case binary::SYMBOL:
+                if (static_cast<std::size_t>(value) >= symbols.size()) {
+                    throw std::runtime_error("Invalid symbol reference");
+                }
+                return symbols[value];
+            case binary::RECORD:
+                if (value == 0) {
+                    return 0;
+                }
+                if (value < 0 || static_cast<std::size_t>(value) > numKnownRecords) {
+                    throw std::runtime_error("Invalid record reference");
+                }
+                return records[value - 1];
+            default: throw std::runtime_error("Invalid value kind");
+        }
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].bin
+     *
+     * @param rwOperation map of IO configuration options
+     * @return input filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".bin");
+        if (name.front() != '/') {
+            name = getOr(rwOperation, "fact-dir", ".") + "/" + name;
+        }
+        return name;
+    }
+
+    std::string fileName;
+    bool loaded = false;
+
+    /** The contents of the file, which are mapped or were read into contents */
+    const char* data = nullptr;
+    std::size_t size = 0;
+    void* mapping = nullptr;
+    std::vector<RamDomain> contents;
+
+    std::size_t numTuples = 0;
+    std::size_t nextTuple = 0;
+
+    /** The columns, in the file if they hold plain values and translated otherwise */
+    std::vector<const RamDomain*> columns;
+    std::vector<std::vector<RamDomain>> translated;
+
+    /** The current references of the stored symbols and records */
+    std::vector<RamDomain> symbols;
+    std::vector<RamDomain> records;
+};
+
+class ReadFileBinaryFactory : public ReadStreamFactory {
+public:
+    Own<ReadStream> getReader(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable) override {
+        return mk<ReadFileBinary>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+
+    ~ReadFileBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
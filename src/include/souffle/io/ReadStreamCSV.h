@@ -20,6 +20,7 @@
 #include "souffle/io/ReadStream.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
 
 #ifdef USE_LIBZ
@@ -32,6 +33,8 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -60,6 +63,14 @@ public:
             int size = static_cast<int>(inputMap.size());
             inputMap[size] = size;
         }
+
+        // flatten the column map for the per-element lookups
+        for (auto&& [column, attribute] : inputMap) {
+            if (static_cast<std::size_t>(column) >= columnAttributes.size()) {
+                columnAttributes.resize(column + 1, -1);
+            }
+            columnAttributes[column] = attribute;
+        }
     }
 
 protected:
@@ -74,7 +85,6 @@ protected:
             return nullptr;
         }
         std::string line;
-        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
 
         if (!getline(file, line)) {
             return nullptr;
@@ -85,45 +95,169 @@ protected:
         }
         ++lineNumber;
 
+        return parseLine(line, [&]() { return lineNumber; });
+    }
+
+    /**
+     * Read the remaining input in large blocks, split each block at line
+     * boundaries into one chunk per thread, and parse the chunks in parallel.
+     */
+    bool readAllChunked(const std::function<void(const RamDomain*)>& insert) override {
+        const std::size_t numThreads = MAX_THREADS;
+        if (numThreads <= 1) {
+            return false;
+        }
+
+        // start with small blocks so that small inputs do not pay for a large buffer
+        std::vector<char> buffer(initialBlockSize);
+        std::string block;
+        while (file) {
+            file.read(buffer.data(), buffer.size());
+            block.append(buffer.data(), static_cast<std::size_t>(file.gcount()));
+
+            // keep the trailing partial line for the next block
+            std::string rest;
+            if (file) {
+                const std::size_t lastNewline = block.rfind('\n');
+                if (lastNewline == std::string::npos) {
+                    continue;
+                }
+                rest = block.substr(lastNewline + 1);
+                block.resize(lastNewline + 1);
+            }
+
+            parseBlock(block, numThreads, insert);
+            lineNumber += static_cast<std::size_t>(std::count(block.begin(), block.end(), '\n'));
+            if (!block.empty() && block.back() != '\n') {
+                ++lineNumber;
+            }
+            block = std::move(rest);
+            buffer.resize(std::min(buffer.size() * 2, maxBlockSizePerThread * numThreads));
+        }
+        return true;
+    }
+
+    /**
+     * Parse all lines of a block of input on the given number of threads.
+     *
+     * The chunks are parsed before any of their tuples is inserted.  If a line
+     * cannot be parsed, only the lines before it are inserted and the error of
+     * the first failing line of the block is thrown, as in a sequential load.
+     */
+    void parseBlock(const std::string& block, const std::size_t numThreads,
+            const std::function<void(const RamDomain*)>& insert) {
+        // chunk boundaries, each chunk starts at the beginning of a line
+        std::vector<std::size_t> bounds{0};
+        const std::size_t chunkSize = block.size() / numThreads + 1;
+        while (bounds.back() < block.size()) {
+            const std::size_t next = block.find('\n', std::min(bounds.back() + chunkSize, block.size() - 1));
+            bounds.push_back(next == std::string::npos ? block.size() : next + 1);
+        }
+
+        // the tuples of each chunk, and the error of its first failing line
+        const int numChunks = static_cast<int>(bounds.size()) - 1;
+        const std::size_t tupleSize = typeAttributes.size();
+        std::vector<std::vector<RamDomain>> tuples(numChunks);
+        std::vector<std::size_t> numTuples(numChunks, 0);
+        std::vector<std::exception_ptr> errors(numChunks);
+
+        PARALLEL_START
+        pfor(int chunk = 0; chunk < numChunks; ++chunk) {
+            std::size_t pos = bounds[chunk];
+            const std::size_t end = bounds[chunk + 1];
+            std::string line;
+            try {
+                while (pos < end) {
+                    std::size_t eol = block.find('\n', pos);
+                    eol = std::min(eol == std::string::npos ? block.size() : eol, end);
+                    std::size_t len = eol - pos;
+                    if (len > 0 && block[pos + len - 1] == '\r') {
+                        --len;
+                    }
+                    line.assign(block, pos, len);
+                    // line numbers are only computed if an error is reported
+                    const auto lineOf = [&]() {
+                        return lineNumber + 1 +
+                               static_cast<std::size_t>(std::count(block.begin(), block.begin() + pos, '\n'));
+                    };
+                    const Own<RamDomain[]> tuple = parseLine(line, lineOf);
+                    tuples[chunk].insert(tuples[chunk].end(), tuple.get(), tuple.get() + tupleSize);
+                    ++numTuples[chunk];
+                    pos = eol + 1;
+                }
+            } catch (...) {
+                errors[chunk] = std::current_exception();
+            }
+        }
+        PARALLEL_END
+
+        const int numValid = static_cast<int>(
+                std::find_if(errors.begin(), errors.end(), [](const auto& error) { return error; }) -
+                errors.begin());
+        const int numInserted = std::min(numValid + 1, numChunks);
+        PARALLEL_START
+        pfor(int chunk = 0; chunk < numInserted; ++chunk) {
+            for (std::size_t tuple = 0; tuple < numTuples[chunk]; ++tuple) {
+                insert(tuples[chunk].data() + tuple * tupleSize);
+            }
+        }
+        PARALLEL_END
+
+        if (numValid < numChunks) {
+            std::rethrow_exception(errors[numValid]);
+        }
+    }
+
+    /**
+     * Parse a single line of input into a tuple.
+     *
+     * This function may be called concurrently; the line number is only
+     * needed to report errors and hence is computed on demand.
+     */
+    template <typename LineNumber>
+    Own<RamDomain[]> parseLine(const std::string& line, const LineNumber& getLineNumber) {
+        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
+
         std::size_t start = 0;
         std::size_t columnsFilled = 0;
         for (uint32_t column = 0; columnsFilled < arity; column++) {
             std::size_t charactersRead = 0;
-            std::string element = nextElement(line, start);
-            if (inputMap.count(column) == 0) {
+            std::string element = nextElement(line, start, getLineNumber);
+            const int attribute = column < columnAttributes.size() ? columnAttributes[column] : -1;
+            if (attribute < 0) {
                 continue;
             }
             ++columnsFilled;
 
             try {
-                auto&& ty = typeAttributes.at(inputMap[column]);
-                switch (ty[0]) {
+                const TypeDescriptor& type = typeDescriptors[attributeTypes[attribute]];
+                switch (type.kind) {
                     case 's': {
-                        tuple[inputMap[column]] = symbolTable.encode(element);
+                        tuple[attribute] = symbolTable.encode(element);
                         charactersRead = element.size();
                         break;
                     }
                     case 'r': {
-                        tuple[inputMap[column]] = readRecord(element, ty, 0, &charactersRead);
+                        tuple[attribute] = readRecord(element, type, 0, &charactersRead);
                         break;
                     }
                     case '+': {
-                        tuple[inputMap[column]] = readADT(element, ty, 0, &charactersRead);
+                        tuple[attribute] = readADT(element, type, 0, &charactersRead);
                         break;
                     }
                     case 'i': {
-                        tuple[inputMap[column]] = RamSignedFromString(element, &charactersRead);
+                        tuple[attribute] = RamSignedFromString(element, &charactersRead);
                         break;
                     }
                     case 'u': {
-                        tuple[inputMap[column]] = ramBitCast(readRamUnsigned(element, charactersRead));
+                        tuple[attribute] = ramBitCast(readRamUnsigned(element, charactersRead));
                         break;
                     }
                     case 'f': {
-                        tuple[inputMap[column]] = ramBitCast(RamFloatFromString(element, &charactersRead));
+                        tuple[attribute] = ramBitCast(RamFloatFromString(element, &charactersRead));
                         break;
                     }
-                    default: fatal("invalid type attribute: `%c`", ty[0]);
+                    default: fatal("invalid type attribute: `%c`", type.kind);
                 }
                 // Check if everything was read.
                 if (charactersRead != element.size()) {
@@ -133,7 +267,7 @@ protected:
             } catch (...) {
                 std::stringstream errorMessage;
                 errorMessage << "Error converting <" + element + "> in column " << column + 1 << " in line "
-                             << lineNumber << "; ";
+                             << getLineNumber() << "; ";
                 throw std::invalid_argument(errorMessage.str());
             }
         }
@@ -162,7 +296,8 @@ protected:
         return value;
     }
 
-    std::string nextElement(const std::string& line, std::size_t& start) {
+    template <typename LineNumber>
+    std::string nextElement(const std::string& line, std::size_t& start, const LineNumber& getLineNumber) {
         std::string element;
 
         if (rfc4180) {
@@ -188,7 +323,7 @@ protected:
                 if (!foundEndQuote) {
                     // missing closing quote
                     std::stringstream errorMessage;
-                    errorMessage << "Unbalanced field quote in line " << lineNumber << "; ";
+                    errorMessage << "Unbalanced field quote in line " << getLineNumber() << "; ";
                     throw std::invalid_argument(errorMessage.str());
                 }
 
@@ -198,7 +333,7 @@ protected:
                     if (nextDelimiter != pos) {
                         std::stringstream errorMessage;
                         errorMessage << "Separator expected immediately after quoted field in line "
-                                     << lineNumber << "; ";
+                                     << getLineNumber() << "; ";
                         throw std::invalid_argument(errorMessage.str());
                     }
                 }
@@ -247,7 +382,7 @@ protected:
             // Handle the end-of-the-line case where parenthesis are unbalanced.
             if (record_parens != 0) {
                 std::stringstream errorMessage;
-                errorMessage << "Unbalanced record parenthesis in line " << lineNumber << "; ";
+                errorMessage << "Unbalanced record parenthesis in line " << getLineNumber() << "; ";
                 throw std::invalid_argument(errorMessage.str());
             }
         } else {
@@ -257,7 +392,7 @@ protected:
         // Check for missing value.
         if (start > end) {
             std::stringstream errorMessage;
-            errorMessage << "Values missing in line " << lineNumber << "; ";
+            errorMessage << "Values missing in line " << getLineNumber() << "; ";
             throw std::invalid_argument(errorMessage.str());
         }
 
@@ -291,11 +426,19 @@ protected:
         return inputColumnMap;
     }
 
+    /** Size of the first block read when loading in parallel */
+    std::size_t initialBlockSize = 1 << 16;
+
+    /** Maximal size of the blocks read when loading in parallel, per thread */
+    std::size_t maxBlockSizePerThread = 1 << 22;
+
     const bool rfc4180;
     const std::string delimiter;
     std::istream& file;
     std::size_t lineNumber;
     std::map<int, int> inputMap;
+    /** Attribute of each input column, or -1 if the column is skipped */
+    std::vector<int> columnAttributes;
 };
 
 class ReadFileCSV : public ReadStreamCSV {
@@ -335,6 +478,17 @@ public:
         }
     }
 
+    bool readAllChunked(const std::function<void(const RamDomain*)>& insert) override {
+        try {
+            return ReadStreamCSV::readAllChunked(insert);
+        } catch (std::exception& e) {
+            std::stringstream errorMessage;
+            errorMessage << e.what();
+            errorMessage << "cannot parse fact file " << baseName << "!\n";
+            throw std::invalid_argument(errorMessage.str());
+        }
+    }
+
     ~ReadFileCSV() override = default;
 
 protected:
@@ -120,8 +120,8 @@ protected:
         pos++;
         for (std::size_t i = 0; i < typeAttributes.size(); ++i) {
             try {
-                auto&& ty = typeAttributes.at(i);
-                switch (ty[0]) {
+                auto&& ty = typeDescriptors[attributeTypes.at(i)];
+                switch (ty.kind) {
                     case 's': {
                         tuple[i] = symbolTable.encode(jsonObj[i].string_value());
                         break;
@@ -142,7 +142,7 @@ protected:
                         tuple[i] = static_cast<RamDomain>(jsonObj[i].number_value());
                         break;
                     }
-                    default: throwError("invalid type attribute: '", ty[0], "'");
+                    default: throwError("invalid type attribute: '", ty.kind, "'");
                 }
             } catch (...) {
                 std::stringstream errorMessage;
@@ -158,11 +158,9 @@ protected:
         return tuple;
     }
 
-    RamDomain readNextElementList(const Json& source, const std::string& recordTypeName) {
-        auto&& recordInfo = types["records"][recordTypeName];
-
-        if (recordInfo.is_null()) {
-            throw std::invalid_argument("Missing record type information: " + recordTypeName);
+    RamDomain readNextElementList(const Json& source, const TypeDescriptor& recordType) {
+        if (!recordType.known) {
+            throw std::invalid_argument("Missing record type information: " + recordType.name);
         }
 
         // Handle null case
@@ -171,18 +169,17 @@ protected:
         }
 
         assert(source.is_array() && "the input is not json array");
-        auto&& recordTypes = recordInfo["types"];
-        const std::size_t recordArity = recordInfo["arity"].long_value();
+        const std::size_t recordArity = recordType.fields.size();
         std::vector<RamDomain> recordValues(recordArity);
         for (std::size_t i = 0; i < recordArity; ++i) {
-            const std::string& recordType = recordTypes[i].string_value();
-            switch (recordType[0]) {
+            const TypeDescriptor& fieldType = typeDescriptors[recordType.fields[i]];
+            switch (fieldType.kind) {
                 case 's': {
                     recordValues[i] = symbolTable.encode(source[i].string_value());
                     break;
                 }
                 case 'r': {
-                    recordValues[i] = readNextElementList(source[i], recordType);
+                    recordValues[i] = readNextElementList(source[i], fieldType);
                     break;
                 }
                 case 'i': {
@@ -220,8 +217,8 @@ protected:
                     throwError("invalid parameter: ", p.first);
                 }
                 std::size_t i = paramIndex.at(p.first);
-                auto&& ty = typeAttributes.at(i);
-                switch (ty[0]) {
+                auto&& ty = typeDescriptors[attributeTypes.at(i)];
+                switch (ty.kind) {
                     case 's': {
                         tuple[i] = symbolTable.encode(p.second.string_value());
                         break;
@@ -242,7 +239,7 @@ protected:
                         tuple[i] = static_cast<RamDomain>(p.second.number_value());
                         break;
                     }
-                    default: throwError("invalid type attribute: '", ty[0], "'");
+                    default: throwError("invalid type attribute: '", ty.kind, "'");
                 }
             } catch (...) {
                 std::stringstream errorMessage;
@@ -254,19 +251,11 @@ protected:
         return tuple;
     }
 
-    RamDomain readNextElementObject(const Json& source, const std::string& recordTypeName) {
-        auto&& recordInfo = types["records"][recordTypeName];
-        const std::string recordName = recordTypeName.substr(2);
-        std::map<const std::string, const std::size_t> recordIndex;
-
-        std::size_t index_pos = 0;
-        for (auto param : params["records"][recordName]["params"].array_items()) {
-            recordIndex.insert(std::make_pair(param.string_value(), index_pos));
-            index_pos++;
-        }
+    RamDomain readNextElementObject(const Json& source, const TypeDescriptor& recordType) {
+        const auto& recordIndex = recordType.fieldIndex;
 
-        if (recordInfo.is_null()) {
-            throw std::invalid_argument("Missing record type information: " + recordTypeName);
+        if (!recordType.known) {
+            throw std::invalid_argument("Missing record type information: " + recordType.name);
         }
 
         // Handle null case
@@ -275,18 +264,18 @@ protected:
         }
 
         assert(source.is_object() && "the input is not json object");
-        auto&& recordTypes = recordInfo["types"];
-        const std::size_t recordArity = recordInfo["arity"].long_value();
+        const std::size_t recordArity = recordType.fields.size();
         std::vector<RamDomain> recordValues(recordArity);
         recordValues.reserve(recordIndex.size());
-        for (auto readParam : source.object_items()) {
+        for (auto&& readParam : source.object_items()) {
             // get the corresponding position by parameter name
-            if (recordIndex.find(readParam.first) == recordIndex.end()) {
+            auto index = recordIndex.find(readParam.first);
+            if (index == recordIndex.end()) {
                 throwError("invalid parameter: ", readParam.first);
             }
-            std::size_t i = recordIndex.at(readParam.first);
-            auto&& type = recordTypes[i].string_value();
-            switch (type[0]) {
+            std::size_t i = index->second;
+            auto&& type = typeDescriptors[recordType.fields[i]];
+            switch (type.kind) {
                 case 's': {
                     recordValues[i] = symbolTable.encode(readParam.second.string_value());
                     break;
@@ -307,7 +296,7 @@ protected:
                     recordValues[i] = static_cast<RamDomain>(readParam.second.number_value());
                     break;
                 }
-                default: throwError("invalid type attribute: '", type[0], "'");
+                default: throwError("invalid type attribute: '", type.kind, "'");
             }
         }
 
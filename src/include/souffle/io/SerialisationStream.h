@@ -24,6 +24,7 @@
 #include <cstddef>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,39 @@ class SymbolTable;
 
 using json11::Json;
 
+/**
+ * The type of an attribute, record field or ADT argument, compiled from the
+ * JSON type information so that values can be serialised without looking up
+ * or comparing type names.  Nested types are referred to by their index in
+ * the descriptor table of the stream.
+ */
+struct TypeDescriptor {
+    /** A branch of an ADT */
+    struct Branch {
+        std::string name;
+        std::vector<std::size_t> types;
+    };
+
+    /** The type name, e.g. "i:number" */
+    std::string name;
+
+    /** The first character of the type name: 'i', 'u', 'f', 's', 'r' or '+' */
+    char kind = 0;
+
+    /** Whether type information for the record or ADT is present */
+    bool known = false;
+
+    /** Record fields, and their names if given */
+    std::vector<std::size_t> fields;
+    std::vector<std::string> fieldNames;
+    std::map<std::string, std::size_t> fieldIndex;
+
+    /** ADT branches, ordered by branch id */
+    bool isEnum = false;
+    std::vector<Branch> branches;
+    std::unordered_map<std::string, std::size_t> branchIndex;
+};
+
 template <bool readOnlyTables>
 class SerialisationStream {
 public:
@@ -47,7 +81,9 @@ protected:
             std::vector<std::string> relTypes, std::size_t auxArity = 0)
             : symbolTable(symTab), recordTable(recTab), types(std::move(types)),
               typeAttributes(std::move(relTypes)), arity(typeAttributes.size() - auxArity),
-              auxiliaryArity(auxArity) {}
+              auxiliaryArity(auxArity) {
+        setupTypeDescriptors();
+    }
 
     SerialisationStream(RO<SymbolTable>& symTab, RO<RecordTable>& recTab, Json types)
             : symbolTable(symTab), recordTable(recTab), types(std::move(types)) {
@@ -81,6 +117,10 @@ protected:
     std::size_t arity = 0;
     std::size_t auxiliaryArity = 0;
 
+    /** Descriptors of all types reachable from the attributes, and the descriptor of each attribute */
+    std::vector<TypeDescriptor> typeDescriptors;
+    std::vector<std::size_t> attributeTypes;
+
 private:
     void setupFromJson() {
         auto&& relInfo = types["relation"];
@@ -99,6 +139,60 @@ private:
         for (std::size_t i = 0; i < auxiliaryArity; i++) {
             typeAttributes.push_back("i:number");
         }
+
+        setupTypeDescriptors();
+    }
+
+    void setupTypeDescriptors() {
+        std::map<std::string, std::size_t> index;
+        for (const auto& type : typeAttributes) {
+            attributeTypes.push_back(compileType(type, index));
+        }
+    }
+
+    /** Return the descriptor of the given type, creating it and all descriptors it refers to if needed. */
+    std::size_t compileType(const std::string& type, std::map<std::string, std::size_t>& index) {
+        auto pos = index.find(type);
+        if (pos != index.end()) {
+            return pos->second;
+        }
+
+        // register the descriptor first, so that recursive types refer to it
+        const std::size_t id = typeDescriptors.size();
+        index[type] = id;
+        typeDescriptors.emplace_back();
+
+        TypeDescriptor descriptor;
+        descriptor.name = type;
+        descriptor.kind = type.empty() ? 0 : type[0];
+        if (descriptor.kind == 'r') {
+            auto&& recordInfo = types["records"][type];
+            descriptor.known = !recordInfo.is_null();
+            const std::size_t recordArity = recordInfo["arity"].long_value();
+            for (std::size_t i = 0; i < recordArity; ++i) {
+                descriptor.fields.push_back(compileType(recordInfo["types"][i].string_value(), index));
+            }
+            for (auto&& param : params["records"][type.substr(2)]["params"].array_items()) {
+                descriptor.fieldIndex.emplace(param.string_value(), descriptor.fieldNames.size());
+                descriptor.fieldNames.push_back(param.string_value());
+            }
+        } else if (descriptor.kind == '+') {
+            auto&& adtInfo = types["ADTs"][type];
+            descriptor.known = !adtInfo.is_null() && adtInfo["branches"].is_array();
+            descriptor.isEnum = adtInfo["enum"].bool_value();
+            for (auto&& branchInfo : adtInfo["branches"].array_items()) {
+                TypeDescriptor::Branch branch;
+                branch.name = branchInfo["name"].string_value();
+                for (auto&& argType : branchInfo["types"].array_items()) {
+                    branch.types.push_back(compileType(argType.string_value(), index));
+                }
+                descriptor.branchIndex.emplace(branch.name, descriptor.branches.size());
+                descriptor.branches.push_back(std::move(branch));
+            }
+        }
+
+        typeDescriptors[id] = std::move(descriptor);
+        return id;
     }
 };
 
@@ -48,11 +48,12 @@ public:
             if (relation.begin() != relation.end()) {
                 writeNullary();
             }
-            return;
-        }
-        for (const auto& current : relation) {
-            writeNext(current);
+        } else {
+            for (const auto& current : relation) {
+                writeNext(current);
+            }
         }
+        writeEnd();
     }
 
     template <typename T>
@@ -65,6 +66,8 @@ protected:
 
     virtual void writeNullary() = 0;
     virtual void writeNextTuple(const RamDomain* tuple) = 0;
+    /** Complete the output after the last tuple */
+    virtual void writeEnd() {}
     virtual void writeSize(std::size_t) {
         fatal("attempting to print size of a write operation");
     }
@@ -79,11 +82,9 @@ protected:
         destination << value;
     }
 
-    void outputRecord(std::ostream& destination, const RamDomain value, const std::string& name) {
-        auto&& recordInfo = types["records"][name];
-
+    void outputRecord(std::ostream& destination, const RamDomain value, const TypeDescriptor& type) {
         // Check if record type information are present
-        assert(!recordInfo.is_null() && "Missing record type information");
+        assert(type.known && "Missing record type information");
 
         // Check for nil
         if (value == 0) {
@@ -91,9 +92,7 @@ protected:
             return;
         }
 
-        auto&& recordTypes = recordInfo["types"];
-        const std::size_t recordArity = recordInfo["arity"].long_value();
-
+        const std::size_t recordArity = type.fields.size();
         const RamDomain* tuplePtr = recordTable.unpack(value, recordArity);
 
         destination << "[";
@@ -103,88 +102,67 @@ protected:
             if (i > 0) {
                 destination << ", ";
             }
-
-            const std::string& recordType = recordTypes[i].string_value();
-            const RamDomain recordValue = tuplePtr[i];
-
-            switch (recordType[0]) {
-                case 'i': destination << recordValue; break;
-                case 'f': destination << ramBitCast<RamFloat>(recordValue); break;
-                case 'u': destination << ramBitCast<RamUnsigned>(recordValue); break;
-                case 's': outputSymbol(destination, symbolTable.decode(recordValue)); break;
-                case 'r': outputRecord(destination, recordValue, recordType); break;
-                case '+': outputADT(destination, recordValue, recordType); break;
-                default: fatal("Unsupported type attribute: `%c`", recordType[0]);
-            }
+            outputValue(destination, tuplePtr[i], typeDescriptors[type.fields[i]]);
         }
         destination << "]";
     }
 
-    void outputADT(std::ostream& destination, const RamDomain value, const std::string& name) {
-        auto&& adtInfo = types["ADTs"][name];
-
-        assert(!adtInfo.is_null() && "Missing adt type information");
-        assert(adtInfo["arity"].long_value() > 0);
+    void outputADT(std::ostream& destination, const RamDomain value, const TypeDescriptor& type) {
+        assert(type.known && "Missing adt type information");
+        assert(!type.branches.empty());
 
         // adt is encoded in one of three possible ways:
         // [branchID, [branch_args]] when |branch_args| != 1
         // [branchID, arg] when a branch takes a single argument.
         // branchID when ADT is an enumeration.
-        bool isEnum = adtInfo["enum"].bool_value();
-
         RamDomain branchId = value;
         const RamDomain* branchArgs = nullptr;
-        json11::Json branchInfo;
-        json11::Json::array branchTypes;
 
-        if (!isEnum) {
+        if (!type.isEnum) {
             const RamDomain* tuplePtr = recordTable.unpack(value, 2);
-
             branchId = tuplePtr[0];
-            branchInfo = adtInfo["branches"][branchId];
-            branchTypes = branchInfo["types"].array_items();
+            const std::size_t numArgs = type.branches[branchId].types.size();
 
             // Prepare branch's arguments for output.
-            branchArgs = [&]() -> const RamDomain* {
-                if (branchTypes.size() > 1) {
-                    return recordTable.unpack(tuplePtr[1], branchTypes.size());
-                } else {
-                    return &tuplePtr[1];
-                }
-            }();
-        } else {
-            branchInfo = adtInfo["branches"][branchId];
-            branchTypes = branchInfo["types"].array_items();
+            if (numArgs > 1) {
+                branchArgs = recordTable.unpack(tuplePtr[1], numArgs);
+            } else {
+                branchArgs = &tuplePtr[1];
+            }
         }
 
-        destination << "$" << branchInfo["name"].string_value();
+        const auto& branch = type.branches[branchId];
+        destination << "$" << branch.name;
 
-        if (branchTypes.size() > 0) {
+        if (branch.types.size() > 0) {
             destination << "(";
         }
 
         // Print arguments
-        for (std::size_t i = 0; i < branchTypes.size(); ++i) {
+        for (std::size_t i = 0; i < branch.types.size(); ++i) {
             if (i > 0) {
                 destination << ", ";
             }
-
-            auto argType = branchTypes[i].string_value();
-            switch (argType[0]) {
-                case 'i': destination << branchArgs[i]; break;
-                case 'f': destination << ramBitCast<RamFloat>(branchArgs[i]); break;
-                case 'u': destination << ramBitCast<RamUnsigned>(branchArgs[i]); break;
-                case 's': outputSymbol(destination, symbolTable.decode(branchArgs[i])); break;
-                case 'r': outputRecord(destination, branchArgs[i], argType); break;
-                case '+': outputADT(destination, branchArgs[i], argType); break;
-                default: fatal("Unsupported type attribute: `%c`", argType[0]);
-            }
+            outputValue(destination, branchArgs[i], typeDescriptors[branch.types[i]]);
         }
 
-        if (branchTypes.size() > 0) {
+        if (branch.types.size() > 0) {
             destination << ")";
         }
     }
+
+    /** Print a record field or an ADT argument. */
+    void outputValue(std::ostream& destination, const RamDomain value, const TypeDescriptor& type) {
+        switch (type.kind) {
+            case 'i': destination << value; break;
+            case 'f': destination << ramBitCast<RamFloat>(value); break;
+            case 'u': destination << ramBitCast<RamUnsigned>(value); break;
+            case 's': outputSymbol(destination, symbolTable.decode(value)); break;
+            case 'r': outputRecord(destination, value, type); break;
+            case '+': outputADT(destination, value, type); break;
+            default: fatal("Unsupported type attribute: `%c`", type.kind);
+        }
+    }
 };
 
 class WriteStreamFactory {
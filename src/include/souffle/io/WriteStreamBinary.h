@@ -0,0 +1,225 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file WriteStreamBinary.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFormat.h"
+#include "souffle/io/WriteStream.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Writes a relation in the columnar binary format described in BinaryFormat.h.
+ *
+ * Tuples are collected column by column while the relation is written, and
+ * the file is produced after the last tuple.
+ */
+class WriteFileBinary : public WriteStream {
+public:
+    WriteFileBinary(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
+            const RecordTable& recordTable)
+            : WriteStream(rwOperation, symbolTable, recordTable), fileName(getFileName(rwOperation)),
+              file(fileName, std::ios::out | std::ios::binary), columns(arity) {
+        if (!file.is_open()) {
+            throw std::invalid_argument("Cannot open output file " + fileName);
+        }
+        for (std::size_t col = 0; col < arity; ++col) {
+            columnKinds.push_back(binary::kindOf(typeDescriptors[attributeTypes[col]]));
+        }
+    }
+
+protected:
+    /** A record of the record dictionary */
+    struct Record {
+        std::vector<char> kinds;
+        std::vector<RamDomain> values;
+    };
+
+    /** Write the file, as its header and dictionaries are only known after the last tuple */
+    void writeEnd() override {
+        binary::BinaryHeader header{};
+        std::copy(std::begin(binary::MAGIC), std::end(binary::MAGIC), header.magic);
+        header.byteOrder = binary::BYTE_ORDER_MARK;
+        header.domainSize = sizeof(RamDomain);
+        header.arity = arity;
+        header.numTuples = numTuples;
+        header.numSymbols = symbols.size();
+        header.numRecords = records.size();
+        binary::write(file, &header);
+        binary::write(file, columnKinds.data(), columnKinds.size());
+
+        for (const auto& symbol : symbols) {
+            const auto length = static_cast<std::uint32_t>(symbol.size());
+            binary::write(file, &length);
+            binary::write(file, symbol.data(), symbol.size());
+        }
+
+        for (const auto& record : records) {
+            const auto recordArity = static_cast<std::uint32_t>(record.kinds.size());
+            binary::write(file, &recordArity);
+            binary::write(file, record.kinds.data(), record.kinds.size());
+            binary::write(file, record.values.data(), record.values.size());
+        }
+
+        const char padding[binary::COLUMN_ALIGNMENT] = {};
+        binary::write(file, padding, binary::columnPadding(file.tellp()));
+        for (const auto& column : columns) {
+            binary::write(file, column.data(), column.size());
+        }
+        file.close();
+        if (file.fail()) {
+            throw std::runtime_error("Cannot write output file " + fileName);
+        }
+    }
+
+    void writeNullary() override {
+        ++numTuples;
+    }
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        for (std::size_t col = 0; col < arity; ++col) {
+            columns[col].push_back(encode(attributeTypes[col], tuple[col]));
+        }
+        ++numTuples;
+    }
+
+    /** Translate a value of the given type into its stored form. */
+    RamDomain encode(const std::size_t type, const RamDomain value) {
+        switch (binary::kindOf(typeDescriptors[type])) {
+            case binary::SYMBOL: return encodeSymbol(value);
+            case binary::RECORD: return value == 0 ? 0 : encodeRecord(type, value);
+            default: return value;
+        }
+    }
+
+    RamDomain encodeSymbol(const RamDomain value) {
+        auto [it, inserted] = symbolIndex.emplace(value, static_cast<RamDomain>(symbols.size()));
+        if (inserted) {
+            symbols.push_back(symbolTable.decode(value));
+        }
+        return it->second;
+    }
+
+    /** Store a record or a non-enum ADT, and all records it refers to. */
+    RamDomain encodeRecord(const std::size_t typeId, const RamDomain value) {
+        auto& index = recordIndex[typeId];
+        auto pos = index.find(value);
+        if (pos != index.end()) {
+            return pos->second;
+        }
+
+        const TypeDescriptor& type = typeDescriptors[typeId];
+        Record record;
+        if (type.kind == 'r') {
+            assert(type.known && "Missing record type information");
+            const RamDomain* tuplePtr = recordTable.unpack(value, type.fields.size());
+            addFields(record, type.fields, tuplePtr);
+        } else {
+            // a non-enum ADT is stored as [branchId, argument] or [branchId, [arguments]]
+            assert(type.known && "Missing adt type information");
+            const RamDomain* tuplePtr = recordTable.unpack(value, 2);
+            const RamDomain branchId = tuplePtr[0];
+            const auto& branchTypes = type.branches[branchId].types;
+            record.kinds.push_back(binary::VALUE);
+            record.values.push_back(branchId);
+            if (branchTypes.size() == 1) {
+                addFields(record, branchTypes, &tuplePtr[1]);
+            } else {
+                Record arguments;
+                addFields(arguments, branchTypes, recordTable.unpack(tuplePtr[1], branchTypes.size()));
+                record.kinds.push_back(binary::RECORD);
+                record.values.push_back(addRecord(std::move(arguments)));
+            }
+        }
+
+        const RamDomain ref = addRecord(std::move(record));
+        index.emplace(value, ref);
+        return ref;
+    }
+
+    void addFields(Record& record, const std::vector<std::size_t>& fieldTypes, const RamDomain* values) {
+        for (std::size_t i = 0; i < fieldTypes.size(); ++i) {
+            record.kinds.push_back(binary::kindOf(typeDescriptors[fieldTypes[i]]));
+            record.values.push_back(encode(fieldTypes[i], values[i]));
+        }
+    }
+
+    RamDomain addRecord(Record&& record) {
+        records.push_back(std::move(record));
+        return static_cast<RamDomain>(records.size());
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].bin
+     *
+     * @param rwOperation map of IO configuration options
+     * @return output filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".bin");
+        if (name.front() != '/') {
+            name = getOr(rwOperation, "output-dir", ".") + "/" + name;
+        }
+        return name;
+    }
+
+    std::string fileName;
+    std::ofstream file;
+    std::vector<char> columnKinds;
+    std::vector<std::vector<RamDomain>> columns;
+    std::size_t numTuples = 0;
+
+    /** Symbol dictionary, and the dictionary index of each symbol written so far */
+    std::vector<std::string> symbols;
+    std::unordered_map<RamDomain, RamDomain> symbolIndex;
+
+    /** Record dictionary, and the stored reference of each record written so far, by type descriptor */
+    std::vector<Record> records;
+    std::map<std::size_t, std::unordered_map<RamDomain, RamDomain>> recordIndex;
+};
+
+class WriteFileBinaryFactory : public WriteStreamFactory {
+public:
+    Own<WriteStream> getWriter(const std::map<std::string, std::string>& rwOperation,
+            const SymbolTable& symbolTable, const RecordTable& recordTable) override {
+        return mk<WriteFileBinary>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+
+    ~WriteFileBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
@@ -55,11 +55,11 @@ protected:
     const std::string delimiter;
 
     void writeNextTupleCSV(std::ostream& destination, const RamDomain* tuple) {
-        writeNextTupleElement(destination, typeAttributes.at(0), tuple[0]);
+        writeNextTupleElement(destination, typeDescriptors[attributeTypes[0]], tuple[0]);
 
         for (std::size_t col = 1; col < arity; ++col) {
             destination << delimiter;
-            writeNextTupleElement(destination, typeAttributes.at(col), tuple[col]);
+            writeNextTupleElement(destination, typeDescriptors[attributeTypes[col]], tuple[col]);
         }
 
         destination << "\n";
@@ -95,8 +95,8 @@ protected:
         }
     }
 
-    void writeNextTupleElement(std::ostream& destination, const std::string& type, RamDomain value) {
-        switch (type[0]) {
+    void writeNextTupleElement(std::ostream& destination, const TypeDescriptor& type, RamDomain value) {
+        switch (type.kind) {
             case 's': outputSymbol(destination, symbolTable.decode(value), true); break;
             case 'i': destination << value; break;
             case 'u': destination << ramBitCast<RamUnsigned>(value); break;
@@ -119,7 +119,7 @@ protected:
                     destination << '"';
                 }
                 break;
-            default: fatal("unsupported type attribute: `%c`", type[0]);
+            default: fatal("unsupported type attribute: `%c`", type.kind);
         }
     }
 };
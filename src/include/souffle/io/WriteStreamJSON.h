@@ -42,12 +42,28 @@ protected:
             if (err.length() > 0) {
                 fatal("cannot get internal param names: %s", err);
             }
+
+            // quote the attribute and field names once
+            for (auto&& param : params["relation"]["params"].array_items()) {
+                attributeKeys.push_back(param.dump());
+            }
+            for (const auto& type : typeDescriptors) {
+                std::vector<std::string> keys;
+                for (const auto& name : type.fieldNames) {
+                    keys.push_back(Json(name).dump());
+                }
+                fieldKeys.push_back(std::move(keys));
+            }
         }
     };
 
     const bool useObjects;
     Json params;
 
+    /** Quoted names of the attributes, and of the record fields of each type descriptor */
+    std::vector<std::string> attributeKeys;
+    std::vector<std::vector<std::string>> fieldKeys;
+
     void writeNextTupleJSON(std::ostream& destination, const RamDomain* tuple) {
         std::vector<Json> result;
 
@@ -62,10 +78,10 @@ protected:
             }
 
             if (useObjects) {
-                destination << params["relation"]["params"][col].dump() << ": ";
-                writeNextTupleObject(destination, typeAttributes.at(col), tuple[col]);
+                destination << attributeKeys.at(col) << ": ";
+                writeNextTupleObject(destination, attributeTypes[col], tuple[col]);
             } else {
-                writeNextTupleList(destination, typeAttributes.at(col), tuple[col]);
+                writeNextTupleList(destination, attributeTypes[col], tuple[col]);
             }
         }
 
@@ -75,116 +91,105 @@ protected:
             destination << "]";
     }
 
-    void writeNextTupleList(std::ostream& destination, const std::string& name, const RamDomain value) {
-        using ValueTuple = std::pair<const std::string, const RamDomain>;
-        std::stack<std::variant<ValueTuple, std::string>> worklist;
-        worklist.push(std::make_pair(name, value));
+    void writeNextTupleList(std::ostream& destination, const std::size_t type, const RamDomain value) {
+        using ValueTuple = std::pair<std::size_t, RamDomain>;
+        std::stack<std::variant<ValueTuple, const char*>> worklist;
+        worklist.push(std::make_pair(type, value));
 
         // the Json11 output is not tail recursive, therefore highly inefficient for recursive record
         // in addition the JSON object is immutable, so has memory overhead
         while (!worklist.empty()) {
-            std::variant<ValueTuple, std::string> curr = worklist.top();
+            std::variant<ValueTuple, const char*> curr = worklist.top();
             worklist.pop();
 
-            if (std::holds_alternative<std::string>(curr)) {
-                destination << std::get<std::string>(curr);
+            if (std::holds_alternative<const char*>(curr)) {
+                destination << std::get<const char*>(curr);
                 continue;
             }
 
-            const std::string& currType = std::get<ValueTuple>(curr).first;
+            const TypeDescriptor& currType = typeDescriptors[std::get<ValueTuple>(curr).first];
             const RamDomain currValue = std::get<ValueTuple>(curr).second;
-            assert(currType.length() > 2 && "Invalid type length");
-            switch (currType[0]) {
+            switch (currType.kind) {
                 // since some strings may need to be escaped, we use dump here
                 case 's': destination << Json(symbolTable.decode(currValue)).dump(); break;
                 case 'i': destination << currValue; break;
                 case 'u': destination << (int)ramBitCast<RamUnsigned>(currValue); break;
                 case 'f': destination << ramBitCast<RamFloat>(currValue); break;
                 case 'r': {
-                    auto&& recordInfo = types["records"][currType];
-                    assert(!recordInfo.is_null() && "Missing record type information");
+                    assert(currType.known && "Missing record type information");
                     if (currValue == 0) {
                         destination << "null";
                         break;
                     }
 
-                    auto&& recordTypes = recordInfo["types"];
-                    const std::size_t recordArity = recordInfo["arity"].long_value();
+                    const std::size_t recordArity = currType.fields.size();
                     const RamDomain* tuplePtr = recordTable.unpack(currValue, recordArity);
                     worklist.push("]");
                     for (auto i = (long long)(recordArity - 1); i >= 0; --i) {
                         if (i != (long long)(recordArity - 1)) {
                             worklist.push(", ");
                         }
-                        const std::string& recordType = recordTypes[i].string_value();
-                        const RamDomain recordValue = tuplePtr[i];
-                        worklist.push(std::make_pair(recordType, recordValue));
+                        worklist.push(std::make_pair(currType.fields[i], tuplePtr[i]));
                     }
 
                     worklist.push("[");
                     break;
                 }
-                default: fatal("unsupported type attribute: `%c`", currType[0]);
+                default: fatal("unsupported type attribute: `%c`", currType.kind);
             }
         }
     }
 
-    void writeNextTupleObject(std::ostream& destination, const std::string& name, const RamDomain value) {
-        using ValueTuple = std::pair<const std::string, const RamDomain>;
-        std::stack<std::variant<ValueTuple, std::string>> worklist;
-        worklist.push(std::make_pair(name, value));
+    void writeNextTupleObject(std::ostream& destination, const std::size_t type, const RamDomain value) {
+        using ValueTuple = std::pair<std::size_t, RamDomain>;
+        std::stack<std::variant<ValueTuple, const char*>> worklist;
+        worklist.push(std::make_pair(type, value));
 
         // the Json11 output is not tail recursive, therefore highly inefficient for recursive record
         // in addition the JSON object is immutable, so has memory overhead
         while (!worklist.empty()) {
-            std::variant<ValueTuple, std::string> curr = worklist.top();
+            std::variant<ValueTuple, const char*> curr = worklist.top();
             worklist.pop();
 
-            if (std::holds_alternative<std::string>(curr)) {
-                destination << std::get<std::string>(curr);
+            if (std::holds_alternative<const char*>(curr)) {
+                destination << std::get<const char*>(curr);
                 continue;
             }
 
-            const std::string& currType = std::get<ValueTuple>(curr).first;
+            const std::size_t currTypeId = std::get<ValueTuple>(curr).first;
+            const TypeDescriptor& currType = typeDescriptors[currTypeId];
             const RamDomain currValue = std::get<ValueTuple>(curr).second;
-            const std::string& typeName = currType.substr(2);
-            assert(currType.length() > 2 && "Invalid type length");
-            switch (currType[0]) {
+            switch (currType.kind) {
                 // since some strings may need to be escaped, we use dump here
                 case 's': destination << Json(symbolTable.decode(currValue)).dump(); break;
                 case 'i': destination << currValue; break;
                 case 'u': destination << (int)ramBitCast<RamUnsigned>(currValue); break;
                 case 'f': destination << ramBitCast<RamFloat>(currValue); break;
                 case 'r': {
-                    auto&& recordInfo = types["records"][currType];
-                    assert(!recordInfo.is_null() && "Missing record type information");
+                    assert(currType.known && "Missing record type information");
                     if (currValue == 0) {
                         destination << "null";
                         break;
                     }
 
-                    auto&& recordTypes = recordInfo["types"];
-                    const std::size_t recordArity = recordInfo["arity"].long_value();
+                    const std::size_t recordArity = currType.fields.size();
                     const RamDomain* tuplePtr = recordTable.unpack(currValue, recordArity);
+                    const auto& keys = fieldKeys[currTypeId];
+                    assert(keys.size() == recordArity && "Missing record field names");
                     worklist.push("}");
                     for (auto i = (long long)(recordArity - 1); i >= 0; --i) {
                         if (i != (long long)(recordArity - 1)) {
                             worklist.push(", ");
                         }
-                        const std::string& recordType = recordTypes[i].string_value();
-                        const RamDomain recordValue = tuplePtr[i];
-                        worklist.push(std::make_pair(recordType, recordValue));
+                        worklist.push(std::make_pair(currType.fields[i], tuplePtr[i]));
                         worklist.push(": ");
-
-                        auto&& recordParam = params["records"][typeName]["params"][i];
-                        assert(recordParam.is_string());
-                        worklist.push(recordParam.dump());
+                        worklist.push(keys[i].c_str());
                     }
 
                     worklist.push("{");
                     break;
                 }
-                default: fatal("unsupported type attribute: `%c`", currType[0]);
+                default: fatal("unsupported type attribute: `%c`", currType.kind);
             }
         }
     }
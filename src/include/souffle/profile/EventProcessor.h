@@ -535,6 +535,24 @@ public:
 
 } relationReadsProcessor;
 
+/**
+ * Distinct Values Processor
+ */
+const class RelationStatisticsProcessor : public EventProcessor {
+public:
+    RelationStatisticsProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@relation-statistics", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& columns = signature[2];
+        std::size_t distinctValues = va_arg(args, std::size_t);
+        db.addSizeEntry({"program", "relation", relation, "distinct-values", columns}, distinctValues);
+    }
+
+} relationStatisticsProcessor;
+
 /**
  * Config entry processor
  */
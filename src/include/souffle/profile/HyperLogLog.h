@@ -0,0 +1,107 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HyperLogLog.h
+ *
+ * Sketch estimating the number of distinct values of a column set of a
+ * relation, for the join statistics of the profiler.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace souffle {
+namespace profile {
+
+/**
+ * HyperLogLog sketch (Flajolet et al.) of a multiset of hashed values.
+ *
+ * The sketch keeps 2^precision registers of one byte each; the relative
+ * error of the estimate is about 1.04 / sqrt(2^precision), i.e. 1.6% for
+ * the default precision.  Small cardinalities are estimated by linear
+ * counting of the empty registers.
+ */
+class HyperLogLog {
+public:
+    explicit HyperLogLog(unsigned precision = 12) : precision(precision), registers(1u << precision, 0) {
+        assert(4 <= precision && precision <= 16 && "unsupported precision");
+    }
+
+    /** Add a value, given by a well-mixed 64 bit hash */
+    void insert(std::uint64_t hash) {
+        const std::size_t index = hash >> (64 - precision);
+        // the rank is the position of the first set bit of the remaining bits, which are padded
+        // with a set bit so that the rank is bounded
+        std::uint64_t rest = (hash << precision) | (std::uint64_t(1) << (precision - 1));
+        std::uint8_t rank = 1;
+        while ((rest & (std::uint64_t(1) << 63)) == 0) {
+            rest <<= 1;
+            ++rank;
+        }
+        registers[index] = std::max(registers[index], rank);
+    }
+
+    /** Add the projection of a tuple onto the given columns */
+    void insert(const RamDomain* tuple, const std::vector<std::size_t>& columns) {
+        std::uint64_t hash = 0;
+        for (std::size_t column : columns) {
+            hash = mix(hash ^ static_cast<std::uint64_t>(static_cast<RamUnsigned>(tuple[column])));
+        }
+        insert(hash);
+    }
+
+    /** Merge the values of another sketch of the same precision */
+    void merge(const HyperLogLog& other) {
+        assert(precision == other.precision && "merging sketches of different precisions");
+        for (std::size_t i = 0; i < registers.size(); ++i) {
+            registers[i] = std::max(registers[i], other.registers[i]);
+        }
+    }
+
+    /** Estimate the number of distinct values added */
+    double estimate() const {
+        const double m = static_cast<double>(registers.size());
+        double sum = 0;
+        std::size_t zeros = 0;
+        for (std::uint8_t rank : registers) {
+            sum += std::ldexp(1.0, -rank);
+            zeros += (rank == 0) ? 1 : 0;
+        }
+        const double alpha = 0.7213 / (1 + 1.079 / m);
+        const double estimate = alpha * m * m / sum;
+        if (estimate <= 2.5 * m && zeros != 0) {
+            return m * std::log(m / static_cast<double>(zeros));
+        }
+        return estimate;
+    }
+
+    /** Mix the bits of a value, so that hashes of similar tuples are unrelated (splitmix64) */
+    static std::uint64_t mix(std::uint64_t value) {
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+private:
+    unsigned precision;
+    std::vector<std::uint8_t> registers;
+};
+
+}  // namespace profile
+}  // namespace souffle
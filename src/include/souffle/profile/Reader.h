@@ -247,6 +247,12 @@ public:
             for (const auto& key : directory.getKeys()) {
                 directory.readEntry(key)->accept(rulesVisitor);
             }
+        } else if (directory.getKey() == "distinct-values") {
+            for (const auto& key : directory.getKeys()) {
+                if (auto* distinctValues = as<SizeEntry>(directory.readEntry(key))) {
+                    base.setDistinctValues(key, distinctValues->getSize());
+                }
+            }
         } else if (directory.getKey() == "maxRSS") {
             auto* preMaxRSS = as<SizeEntry>(directory.readEntry("pre"));
             auto* postMaxRSS = as<SizeEntry>(directory.readEntry("post"));
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -42,6 +43,9 @@ private:
     int recursiveId = 0;
     std::size_t tuplesRead = 0;
 
+    /** Estimated numbers of distinct values of column sets, given as comma-separated columns */
+    std::map<std::string, std::size_t> distinctValues;
+
     std::vector<std::shared_ptr<Iteration>> iterations;
 
     std::unordered_map<std::string, std::shared_ptr<Rule>> ruleMap;
@@ -248,6 +252,14 @@ public:
     void addReads(std::size_t tuplesRead) {
         this->tuplesRead += tuplesRead;
     }
+
+    const std::map<std::string, std::size_t>& getDistinctValues() const {
+        return distinctValues;
+    }
+
+    void setDistinctValues(const std::string& columns, std::size_t count) {
+        distinctValues[columns] = count;
+    }
 };
 
 }  // namespace profile
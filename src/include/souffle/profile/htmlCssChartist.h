@@ -3,7 +3,7 @@
 namespace souffle {
 namespace profile {
 namespace html {
-std::string cssChartist = R"___(
+inline std::string cssChartist = R"___(
 p {
     padding: 4px
 }
@@ -5,7 +5,7 @@
 namespace souffle {
 namespace profile {
 namespace html {
-std::string cssStyle = R"___(
+inline std::string cssStyle = R"___(
 a, abbr, acronym, address,
 applet, article, aside, audio, b, big, blockquote, body, canvas, caption,
 center, cite, code, dd, del, details, dfn, dl, dt, em, embed, fieldset,
@@ -3,7 +3,7 @@
 namespace souffle {
 namespace profile {
 namespace html {
-std::string jsChartistPlugin = R"___(
+inline std::string jsChartistPlugin = R"___(
 /**
  * Chartist.js plugin to display a data label on top of the points in a line chart.
  * The MIT License (MIT)
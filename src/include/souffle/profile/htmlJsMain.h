@@ -11,7 +11,7 @@
 namespace souffle {
 namespace profile {
 namespace html {
-std::string jsMain = R"___(
+inline std::string jsMain = R"___(
 function changeSelectedRel(id) {
     selected.rel = id;
     highlightRow();
@@ -3,7 +3,7 @@
 namespace souffle {
 namespace profile {
 namespace html {
-std::string jsTableSort = R"___(
+inline std::string jsTableSort = R"___(
 /*!
  * tablesort v4.1.0 (2016-12-29)
  * http://tristen.ca/tablesort/demo/
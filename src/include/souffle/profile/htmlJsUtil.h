@@ -3,7 +3,7 @@
 namespace souffle {
 namespace profile {
 namespace html {
-std::string jsUtil = R"___(
+inline std::string jsUtil = R"___(
 /*
  * Souffle - A Datalog Compiler
  * Copyright (c) 2017, The Souffle Developers. All rights reserved
@@ -3,7 +3,7 @@
 namespace souffle {
 namespace profile {
 namespace html {
-std::string htmlHeadTop = R"___(
+inline std::string htmlHeadTop = R"___(
 <!--
 * Souffle - A Datalog Compiler
 * Copyright (c) 2017, The Souffle Developers. All rights reserved
@@ -17,11 +17,11 @@ std::string htmlHeadTop = R"___(
     <meta charset="UTF-8">
     <title>Souffle Profiler</title>
 )___";
-std::string htmlHeadBottom = R"___(
+inline std::string htmlHeadBottom = R"___(
 </head>
 )___";
 
-std::string htmlBodyTop = R"___(
+inline std::string htmlBodyTop = R"___(
 <body>
 <div id="wrapper" style="width:100%;height:inherit;">
     <ul class="tab">
@@ -239,7 +239,7 @@ std::string htmlBodyTop = R"___(
 </div>
 </div>
 )___";
-std::string htmlBodyBottom = R"___(
+inline std::string htmlBodyBottom = R"___(
 </body>
 </html>
 
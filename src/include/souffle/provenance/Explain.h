@@ -101,6 +101,27 @@ public:
             }
             query = parseTuple(command[1]);
             printTree(prov.explain(query.first, query.second, ExplainConfig::getExplainConfig().depthLimit));
+        } else if (command[0] == "explainall") {
+            if (command.size() != 2) {
+                printError(
+                        "Usage: explainall <relation1>(<element1>, <element2>, ...), "
+                        "<relation2>(<element1>, <element2>, ...), ...\n");
+                return true;
+            }
+            std::vector<std::pair<std::string, std::vector<std::string>>> queries;
+            std::regex tupleRegex(
+                    "[a-zA-Z0-9_.-]*[[:blank:]]*\\(([^\")]|\"[^\"]*\")*\\)", std::regex_constants::extended);
+            std::smatch tupleMatcher;
+            std::string tuplesStr = command[1];
+            while (std::regex_search(tuplesStr, tupleMatcher, tupleRegex)) {
+                queries.push_back(parseTuple(tupleMatcher[0]));
+                if (queries.back().first.empty()) {
+                    printError("<" + tupleMatcher.str(0) + "> is not a valid tuple\n");
+                    return true;
+                }
+                tuplesStr = tupleMatcher.suffix().str();
+            }
+            printTrees(prov.explainAll(queries, ExplainConfig::getExplainConfig().depthLimit));
         } else if (command[0] == "subproof") {
             std::pair<std::string, std::vector<std::string>> query;
             int label = -1;
@@ -253,6 +274,8 @@ public:
                     "----------\n"
                     "setdepth <depth>: Set a limit for printed derivation tree height\n"
                     "explain <relation>(<element1>, <element2>, ...): Prints derivation tree\n"
+                    "explainall <relation1>(<element1>, ...), <relation2>(<element1>, ...), ...:\n"
+                    "    Prints the derivation trees of several tuples, sharing their sub-proofs\n"
                     "explainnegation <relation>(<element1>, <element2>, ...): Enters an interactive\n"
                     "    interface where the non-existence of a tuple can be explained\n"
                     "subproof <relation>(<label>): Prints derivation tree for a subproof, label is\n"
@@ -275,6 +298,33 @@ public:
     /* The main explain call */
     virtual void explain() = 0;
 
+protected:
+    /* Write the trees of a batch of tuples, in json format as a single document */
+    void writeTrees(std::ostream& os, const VecOwn<TreeNode>& trees) {
+        if (!ExplainConfig::getExplainConfig().json) {
+            for (const Own<TreeNode>& tree : trees) {
+                tree->place(0, 0);
+                ScreenBuffer screenBuffer(tree->getWidth(), tree->getHeight());
+                tree->render(screenBuffer);
+                os << screenBuffer.getString() << "\n";
+            }
+        } else {
+            os << "{ \"proofs\": [\n";
+            bool first = true;
+            for (const Own<TreeNode>& tree : trees) {
+                if (first) {
+                    first = false;
+                } else {
+                    os << ",\n";
+                }
+                tree->printJSON(os, 1);
+            }
+            os << "\n],";
+            prov.printRulesJSON(os);
+            os << "}\n";
+        }
+    }
+
 private:
     /* Get input */
     virtual std::string getInput() = 0;
@@ -285,6 +335,9 @@ private:
     /* Print a tree */
     virtual void printTree(Own<TreeNode> tree) = 0;
 
+    /* Print the trees of a batch of tuples */
+    virtual void printTrees(VecOwn<TreeNode> trees) = 0;
+
     /* Print any other information, disabled for non-terminal outputs */
     virtual void printInfo(const std::string& info) = 0;
 
@@ -444,6 +497,15 @@ private:
         }
     }
 
+    /* Print the trees of a batch of tuples */
+    void printTrees(VecOwn<TreeNode> trees) override {
+        if (ExplainConfig::getExplainConfig().outputStream == nullptr) {
+            writeTrees(std::cout, trees);
+        } else {
+            writeTrees(*ExplainConfig::getExplainConfig().outputStream, trees);
+        }
+    }
+
     /* Print any other information, disabled for non-terminal outputs */
     void printInfo(const std::string& info) override {
         if (isatty(fileno(stdin)) == 0) {
@@ -554,6 +616,17 @@ private:
         }
     }
 
+    /* Print the trees of a batch of tuples */
+    void printTrees(VecOwn<TreeNode> trees) override {
+        if (ExplainConfig::getExplainConfig().outputStream == nullptr) {
+            std::stringstream ss;
+            writeTrees(ss, trees);
+            wprintw(treePad, "%s", ss.str().c_str());
+        } else {
+            writeTrees(*ExplainConfig::getExplainConfig().outputStream, trees);
+        }
+    }
+
     /* Print any other information, disabled for non-terminal outputs */
     void printInfo(const std::string& info) override {
         if (!isatty(fileno(stdin))) {
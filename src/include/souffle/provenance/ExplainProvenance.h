@@ -167,6 +167,15 @@ public:
     virtual Own<TreeNode> explain(
             std::string relName, std::vector<std::string> tuple, std::size_t depthLimit) = 0;
 
+    /**
+     * Explain a batch of tuples, sharing the evaluation of their common sub-proofs
+     * @param tuples, vector of relation, argument pairs
+     * @return a proof tree for each tuple, in the same order
+     * */
+    virtual VecOwn<TreeNode> explainAll(
+            const std::vector<std::pair<std::string, std::vector<std::string>>>& tuples,
+            std::size_t depthLimit) = 0;
+
     virtual Own<TreeNode> explainSubproof(std::string relName, RamDomain label, std::size_t depthLimit) = 0;
 
     virtual std::vector<std::string> explainNegationGetVariables(
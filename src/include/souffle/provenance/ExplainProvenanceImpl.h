@@ -24,16 +24,19 @@
 #include "souffle/provenance/ExplainTree.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <regex>
+#include <set>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -83,6 +86,8 @@ public:
                 tuple >> rule;
 
                 std::string relName = name.substr(0, name.find(".@info"));
+                ruleInfo.insert(
+                        {std::make_pair(relName, ruleNum), resolveRule(relName, ruleNum, bodyLiterals)});
                 info.insert({std::make_pair(relName, ruleNum), bodyLiterals});
                 rules.insert({std::make_pair(relName, ruleNum), rule});
             }
@@ -95,29 +100,24 @@ public:
         joinedArgs << join(decodeArguments(relName, tuple), ", ");
         auto joinedArgsStr = joinedArgs.str();
 
-        // if fact
-        if (levelNum == 0) {
+        // if fact, or if the provenance of the relation is not kept
+        if (levelNum == 0 || !contains(ruleInfo, std::make_pair(relName, ruleNum))) {
             return mk<LeafNode>(relName + "(" + joinedArgsStr + ")");
         }
 
-        assert(contains(info, std::make_pair(relName, ruleNum)) && "invalid rule for tuple");
-
         // if depth limit exceeded
         if (depthLimit <= 1) {
             tuple.push_back(ruleNum);
             tuple.push_back(levelNum);
 
             // find if subproof exists already
-            std::size_t idx = 0;
-            auto it = std::find(subproofs.begin(), subproofs.end(), tuple);
-            if (it != subproofs.end()) {
-                idx = it - subproofs.begin();
-            } else {
+            auto it = subproofIndex.find(tuple);
+            if (it == subproofIndex.end()) {
+                it = subproofIndex.insert({tuple, subproofs.size()}).first;
                 subproofs.push_back(tuple);
-                idx = subproofs.size() - 1;
             }
 
-            return mk<LeafNode>("subproof " + relName + "(" + std::to_string(idx) + ")");
+            return mk<LeafNode>("subproof " + relName + "(" + std::to_string(it->second) + ")");
         }
 
         tuple.push_back(levelNum);
@@ -125,90 +125,42 @@ public:
         auto internalNode =
                 mk<InnerNode>(relName + "(" + joinedArgsStr + ")", "(R" + std::to_string(ruleNum) + ")");
 
-        // make return vector pointer
-        std::vector<RamDomain> ret;
-
-        // execute subroutine to get subproofs
-        prog.executeSubroutine(relName + "_" + std::to_string(ruleNum) + "_subproof", tuple, ret);
-
-        // recursively get nodes for subproofs
-        std::size_t tupleCurInd = 0;
-        auto bodyRelations = info.at(std::make_pair(relName, ruleNum));
-
-        // start from begin + 1 because the first element represents the head atom
-        for (auto it = bodyRelations.begin() + 1; it < bodyRelations.end(); it++) {
-            std::string bodyLiteral = *it;
-            // split bodyLiteral since it contains relation name plus arguments
-            std::string bodyRel = splitString(bodyLiteral, ',')[0];
-
-            // check whether the current atom is a constraint
-            assert(bodyRel.size() > 0 && "body of a relation should have positive length");
-            bool isConstraint = contains(constraintList, bodyRel);
-
-            // handle negated atom names
-            auto bodyRelAtomName = bodyRel;
-            if (bodyRel[0] == '!' && bodyRel != "!=") {
-                bodyRelAtomName = bodyRel.substr(1);
-            }
-
-            // traverse subroutine return
-            std::size_t arity;
-            std::size_t auxiliaryArity;
-            if (isConstraint) {
-                // we only handle binary constraints, and assume arity is 4 to account for hidden provenance
-                // annotations
-                arity = 4;
-                auxiliaryArity = 2;
-            } else {
-                arity = prog.getRelation(bodyRelAtomName)->getArity();
-                auxiliaryArity = prog.getRelation(bodyRelAtomName)->getAuxiliaryArity();
-            }
-            auto tupleEnd = tupleCurInd + arity;
-
-            // store current tuple
-            std::vector<RamDomain> subproofTuple;
-
-            for (; tupleCurInd < tupleEnd - auxiliaryArity; tupleCurInd++) {
-                subproofTuple.push_back(ret[tupleCurInd]);
-            }
-
-            int subproofRuleNum = ret[tupleCurInd];
-            int subproofLevelNum = ret[tupleCurInd + 1];
-
-            tupleCurInd += 2;
-
-            // for a negation, display the corresponding tuple and do not recurse
-            if (bodyRel[0] == '!' && bodyRel != "!=") {
-                std::stringstream joinedTuple;
-                joinedTuple << join(decodeArguments(bodyRelAtomName, subproofTuple), ", ");
-                auto joinedTupleStr = joinedTuple.str();
-                internalNode->add_child(mk<LeafNode>(bodyRel + "(" + joinedTupleStr + ")"));
-                internalNode->setSize(internalNode->getSize() + 1);
-                // for a binary constraint, display the corresponding values and do not recurse
-            } else if (isConstraint) {
-                std::stringstream joinedConstraint;
-
-                // FIXME: We need type info in order to figure out how to print arguments.
-                BinaryConstraintOp rawBinOp = toBinaryConstraintOp(bodyRel);
-                if (isOrderedBinaryConstraintOp(rawBinOp)) {
-                    joinedConstraint << subproofTuple[0] << " " << bodyRel << " " << subproofTuple[1];
-                } else {
-                    joinedConstraint << bodyRel << "(\"" << symTable.decode(subproofTuple[0]) << "\", \""
-                                     << symTable.decode(subproofTuple[1]) << "\")";
-                }
-
-                internalNode->add_child(mk<LeafNode>(joinedConstraint.str()));
-                internalNode->setSize(internalNode->getSize() + 1);
-                // otherwise, for a normal tuple, recurse
-            } else {
-                auto child =
-                        explain(bodyRel, subproofTuple, subproofRuleNum, subproofLevelNum, depthLimit - 1);
-                internalNode->setSize(internalNode->getSize() + child->getSize());
-                internalNode->add_child(std::move(child));
-            }
+        // get the premises of the tuple, shared with other proofs deriving it
+        RuleInfo& rule = ruleInfo.at(std::make_pair(relName, ruleNum));
+        forEachPremise(rule, getProofStep(rule, tuple),
+                [&](const BodyLiteral& literal, const std::vector<RamDomain>& subproofTuple,
+                        RamDomain subproofRuleNum, RamDomain subproofLevelNum) {
+                    const std::string& bodyRel = literal.relName;
+                    // for a negation, display the corresponding tuple and do not recurse
+                    if (literal.isNegation) {
+                        std::stringstream joinedTuple;
+                        joinedTuple << join(decodeArguments(literal.atomName, subproofTuple), ", ");
+                        auto joinedTupleStr = joinedTuple.str();
+                        internalNode->add_child(mk<LeafNode>(bodyRel + "(" + joinedTupleStr + ")"));
+                        internalNode->setSize(internalNode->getSize() + 1);
+                        // for a binary constraint, display the corresponding values and do not recurse
+                    } else if (literal.isConstraint) {
+                        std::stringstream joinedConstraint;
+
+                        // FIXME: We need type info in order to figure out how to print arguments.
+                        BinaryConstraintOp rawBinOp = toBinaryConstraintOp(bodyRel);
+                        if (isOrderedBinaryConstraintOp(rawBinOp)) {
+                            joinedConstraint << subproofTuple[0] << " " << bodyRel << " " << subproofTuple[1];
+                        } else {
+                            joinedConstraint << bodyRel << "(\"" << symTable.decode(subproofTuple[0])
+                                             << "\", \"" << symTable.decode(subproofTuple[1]) << "\")";
+                        }
 
-            tupleCurInd = tupleEnd;
-        }
+                        internalNode->add_child(mk<LeafNode>(joinedConstraint.str()));
+                        internalNode->setSize(internalNode->getSize() + 1);
+                        // otherwise, for a normal tuple, recurse
+                    } else {
+                        auto child = explain(
+                                bodyRel, subproofTuple, subproofRuleNum, subproofLevelNum, depthLimit - 1);
+                        internalNode->setSize(internalNode->getSize() + child->getSize());
+                        internalNode->add_child(std::move(child));
+                    }
+                });
 
         return internalNode;
     }
@@ -232,6 +184,53 @@ public:
         return explain(relName, tuple, ruleNum, levelNum, depthLimit);
     }
 
+    VecOwn<TreeNode> explainAll(const std::vector<std::pair<std::string, std::vector<std::string>>>& tuples,
+            std::size_t depthLimit) override {
+        // locate the annotations of all tuples with a single scan per relation
+        std::map<std::string, std::map<std::vector<RamDomain>, std::pair<RamDomain, RamDomain>>> found;
+        std::vector<std::vector<RamDomain>> nums;
+        for (const auto& [relName, args] : tuples) {
+            nums.push_back(argsToNums(relName, args));
+            if (!nums.back().empty()) {
+                found[relName].insert({nums.back(), std::make_pair(-1, -1)});
+            }
+        }
+        for (auto& [relName, annotations] : found) {
+            findTuples(relName, annotations);
+        }
+
+        // evaluate the proof steps of all tuples down to the depth limit, sharing common sub-proofs
+        std::vector<std::pair<RuleInfo*, std::vector<RamDomain>>> roots;
+        for (std::size_t i = 0; i < tuples.size(); ++i) {
+            if (nums[i].empty()) {
+                continue;
+            }
+            auto [ruleNum, levelNum] = found[tuples[i].first].at(nums[i]);
+            auto rule = ruleInfo.find(std::make_pair(tuples[i].first, ruleNum));
+            if (ruleNum >= 0 && levelNum > 0 && rule != ruleInfo.end()) {
+                std::vector<RamDomain> key = nums[i];
+                key.push_back(levelNum);
+                roots.emplace_back(&rule->second, std::move(key));
+            }
+        }
+        evaluateProofSteps(std::move(roots), depthLimit);
+
+        VecOwn<TreeNode> trees;
+        for (std::size_t i = 0; i < tuples.size(); ++i) {
+            if (nums[i].empty()) {
+                trees.push_back(mk<LeafNode>("Relation not found"));
+                continue;
+            }
+            auto [ruleNum, levelNum] = found[tuples[i].first].at(nums[i]);
+            if (ruleNum < 0 || levelNum == -1) {
+                trees.push_back(mk<LeafNode>("Tuple not found"));
+            } else {
+                trees.push_back(explain(tuples[i].first, nums[i], ruleNum, levelNum, depthLimit));
+            }
+        }
+        return trees;
+    }
+
     Own<TreeNode> explainSubproof(
             std::string relName, RamDomain subproofNum, std::size_t depthLimit) override {
         if (subproofNum >= (int)subproofs.size()) {
@@ -734,12 +733,149 @@ public:
     }
 
 private:
+    /** A literal in the body of a rule, as returned by the subproof subroutine of the rule */
+    struct BodyLiteral {
+        /** Name of the relation, negated relation (e.g. `!edge`) or constraint */
+        std::string relName;
+        /** Name of the relation without negation */
+        std::string atomName;
+        bool isConstraint;
+        bool isNegation;
+        /** Number of values returned for the literal, including its provenance annotations */
+        std::size_t arity;
+        std::size_t auxiliaryArity;
+    };
+
+    /** A rule resolved once in setup, with the proof steps of its head tuples evaluated so far */
+    struct RuleInfo {
+        std::string subroutine;
+        std::vector<BodyLiteral> body;
+        /**
+         * Return values of the subroutine by head tuple and level number; these are the edges of a
+         * proof DAG shared by all explanations, so that a common sub-proof is only evaluated once
+         */
+        std::map<std::vector<RamDomain>, std::vector<RamDomain>> proofSteps;
+    };
+
+    std::map<std::pair<std::string, std::size_t>, RuleInfo> ruleInfo;
     std::map<std::pair<std::string, std::size_t>, std::vector<std::string>> info;
     std::map<std::pair<std::string, std::size_t>, std::string> rules;
     std::vector<std::vector<RamDomain>> subproofs;
+    std::map<std::vector<RamDomain>, std::size_t> subproofIndex;
     std::vector<std::string> constraintList = {
             "=", "!=", "<", "<=", ">=", ">", "match", "contains", "not_match", "not_contains"};
 
+    RuleInfo resolveRule(const std::string& relName, RamDomain ruleNum,
+            const std::vector<std::string>& bodyLiterals) const {
+        RuleInfo rule;
+        rule.subroutine = relName + "_" + std::to_string(ruleNum) + "_subproof";
+
+        // start from begin + 1 because the first element represents the head atom
+        for (std::size_t i = 1; i < bodyLiterals.size(); i++) {
+            // split the body literal since it contains the relation name plus arguments
+            BodyLiteral literal;
+            literal.relName = splitString(bodyLiterals[i], ',')[0];
+            assert(literal.relName.size() > 0 && "body of a relation should have positive length");
+            literal.isConstraint = contains(constraintList, literal.relName);
+            literal.isNegation = literal.relName[0] == '!' && literal.relName != "!=";
+            literal.atomName = literal.isNegation ? literal.relName.substr(1) : literal.relName;
+
+            if (literal.isConstraint) {
+                // we only handle binary constraints, and assume arity is 4 to account for hidden provenance
+                // annotations
+                literal.arity = 4;
+                literal.auxiliaryArity = 2;
+            } else if (const Relation* atom = prog.getRelation(literal.atomName)) {
+                literal.arity = atom->getArity();
+                literal.auxiliaryArity = atom->getAuxiliaryArity();
+            } else {
+                literal.arity = literal.auxiliaryArity = 0;
+            }
+            rule.body.push_back(std::move(literal));
+        }
+        return rule;
+    }
+
+    /** Get the return values of the subproof subroutine of a rule for a head tuple and level number */
+    const std::vector<RamDomain>& getProofStep(RuleInfo& rule, const std::vector<RamDomain>& key) {
+        auto [it, inserted] = rule.proofSteps.try_emplace(key);
+        if (inserted) {
+            prog.executeSubroutine(rule.subroutine, key, it->second);
+        }
+        return it->second;
+    }
+
+    /**
+     * Visit the premises of a proof step: each body literal of the rule with its values and, for atoms,
+     * the rule and level numbers of the premise
+     */
+    template <typename Visitor>
+    void forEachPremise(const RuleInfo& rule, const std::vector<RamDomain>& ret, Visitor visitor) const {
+        std::size_t tupleCurInd = 0;
+        for (const BodyLiteral& literal : rule.body) {
+            auto tupleEnd = tupleCurInd + literal.arity;
+            auto valuesEnd = tupleEnd - literal.auxiliaryArity;
+            std::vector<RamDomain> subproofTuple(ret.begin() + tupleCurInd, ret.begin() + valuesEnd);
+            visitor(literal, subproofTuple, ret[valuesEnd], ret[valuesEnd + 1]);
+            tupleCurInd = tupleEnd;
+        }
+    }
+
+    /**
+     * Evaluate the proof steps reachable from the given ones within the depth limit, level by level.
+     *
+     * Each step is evaluated once, and the independent steps of a level are evaluated in parallel;
+     * the proof trees are then built from the cached steps.
+     */
+    void evaluateProofSteps(std::vector<std::pair<RuleInfo*, std::vector<RamDomain>>> frontier,
+            std::size_t depthLimit) {
+        std::set<std::pair<const RuleInfo*, std::vector<RamDomain>>> visited;
+        for (; !frontier.empty() && depthLimit > 1; --depthLimit) {
+            // collect the steps that have not been evaluated yet
+            std::vector<std::pair<RuleInfo*, std::vector<RamDomain>>> level;
+            std::vector<std::pair<const std::string*, std::vector<RamDomain>*>> pending;
+            std::vector<const std::vector<RamDomain>*> keys;
+            for (auto& node : frontier) {
+                if (!visited.insert(node).second) {
+                    continue;
+                }
+                auto [it, inserted] = node.first->proofSteps.try_emplace(node.second);
+                if (inserted) {
+                    pending.emplace_back(&node.first->subroutine, &it->second);
+                    keys.push_back(&it->first);
+                }
+                level.push_back(std::move(node));
+            }
+
+            // evaluate them in parallel; each subroutine call has its own context and return values
+            std::int64_t numPending = pending.size();
+            PARALLEL_START
+            pfor(std::int64_t i = 0; i < numPending; ++i) {
+                prog.executeSubroutine(*pending[i].first, *keys[i], *pending[i].second);
+            }
+            PARALLEL_END
+
+            // descend into the premises that are derived tuples
+            frontier.clear();
+            for (const auto& [rule, key] : level) {
+                forEachPremise(*rule, rule->proofSteps.at(key),
+                        [&](const BodyLiteral& literal, const std::vector<RamDomain>& subproofTuple,
+                                RamDomain subproofRuleNum, RamDomain subproofLevelNum) {
+                            if (literal.isNegation || literal.isConstraint || subproofLevelNum == 0) {
+                                return;
+                            }
+                            auto premise = ruleInfo.find(std::make_pair(literal.relName, subproofRuleNum));
+                            if (premise == ruleInfo.end()) {
+                                return;
+                            }
+                            std::vector<RamDomain> premiseKey = subproofTuple;
+                            premiseKey.push_back(subproofLevelNum);
+                            frontier.emplace_back(&premise->second, std::move(premiseKey));
+                        });
+            }
+        }
+    }
+
     RamDomain lookupExisting(const std::string& symbol) {
         auto Res = symTable.findOrInsert(symbol);
         if (Res.second) {
@@ -801,6 +937,27 @@ private:
         return std::make_tuple(-1, -1);
     }
 
+    /** Find the rule and level numbers of the given tuples of a relation, in a single scan */
+    void findTuples(const std::string& relName,
+            std::map<std::vector<RamDomain>, std::pair<RamDomain, RamDomain>>& annotations) {
+        auto rel = prog.getRelation(relName);
+        if (rel == nullptr) {
+            return;
+        }
+
+        for (auto& tuple : *rel) {
+            std::vector<RamDomain> currentTuple;
+            for (arity_type i = 0; i < rel->getPrimaryArity(); i++) {
+                currentTuple.push_back(tuple[i]);
+            }
+
+            auto it = annotations.find(currentTuple);
+            if (it != annotations.end()) {
+                it->second = std::make_pair(tuple[rel->getPrimaryArity()], tuple[rel->getPrimaryArity() + 1]);
+            }
+        }
+    }
+
     /*
      * Find solution for parameterised query satisfying constant constraints and equivalence constraints
      * @param varRels, reference to vector of relation of tuple contains at least one variable in its
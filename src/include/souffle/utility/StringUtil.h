@@ -347,6 +347,18 @@ inline std::string stripPrefix(const std::string& prefix, const std::string& ele
     return isPrefix(prefix, element) ? element.substr(prefix.length()) : element;
 }
 
+/**
+ * Removes the leading and trailing whitespace of a given string
+ */
+inline std::string trim(std::string_view str) {
+    const std::size_t begin = str.find_first_not_of(" \t\n\v\f\r");
+    if (begin == std::string_view::npos) {
+        return "";
+    }
+    const std::size_t end = str.find_last_not_of(" \t\n\v\f\r");
+    return std::string(str.substr(begin, end - begin + 1));
+}
+
 /**
  * Stringify a string using escapes for escape, newline, tab, double-quotes and semicolons
  */
@@ -87,6 +87,7 @@
 #include "souffle/io/IOSystem.h"
 #include "souffle/io/ReadStream.h"
 #include "souffle/io/WriteStream.h"
+#include "souffle/profile/HyperLogLog.h"
 #include "souffle/profile/Logger.h"
 #include "souffle/profile/ProfileEvent.h"
 #include "souffle/utility/EvaluatorUtil.h"
@@ -97,6 +98,7 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -107,6 +109,7 @@
 #include <map>
 #include <memory>
 #include <regex>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -159,10 +162,26 @@ std::size_t number_of_threads(const std::size_t) {
 Engine::Engine(ram::TranslationUnit& tUnit)
         : profileEnabled(Global::config().has("profile")),
           frequencyCounterEnabled(Global::config().has("profile-frequency")),
+          statisticsEnabled(profileEnabled && Global::config().has("profile-statistics")),
           isProvenance(Global::config().has("provenance")),
+          isSymbolOrder(Global::config().has("order-symbols")),
+          isAsyncOutput(Global::config().has("async-output")),
           numOfThreads(number_of_threads(std::stoi(Global::config().get("jobs")))), tUnit(tUnit),
-          isa(tUnit.getAnalysis<ram::analysis::IndexAnalysis>()), recordTable(numOfThreads),
-          symbolTable(numOfThreads) {}
+          isa(tUnit.getAnalysis<ram::analysis::IndexAnalysis>()),
+          recordTable(std::make_shared<SpecializedRecordTable<0, 1, 2, 3, 4, 5, 6, 7, 8, 9>>(numOfThreads)),
+          symbolTable(std::make_shared<SymbolTable>(numOfThreads)) {}
+
+Own<Engine> Engine::fork() const {
+    auto forked = mk<Engine>(tUnit);
+    forked->recordTable = recordTable;
+    forked->symbolTable = symbolTable;
+    forked->counter = counter.load();
+    forked->relationDecls = relationDecls;
+    for (const auto& handle : relations) {
+        forked->relations.push_back(handle == nullptr ? nullptr : mk<RelationHandle>(*handle));
+    }
+    return forked;
+}
 
 Engine::RelationHandle& Engine::getRelationHandle(const std::size_t idx) {
     return *relations[idx];
@@ -179,7 +198,7 @@ int Engine::incCounter() {
 }
 
 RecordTable& Engine::getRecordTable() {
-    return recordTable;
+    return *recordTable;
 }
 
 ram::TranslationUnit& Engine::getTranslationUnit() {
@@ -204,19 +223,38 @@ void Engine::createRelation(const ram::Relation& id, const std::size_t idx) {
     if (relations.size() < idx + 1) {
         relations.resize(idx + 1);
     }
+    relationDecls[id.getName()] = &id;
 
-    RelationHandle res;
+    // the relations of a fork are shared with the forked engine
+    if (relations[idx] == nullptr) {
+        relations[idx] = mk<RelationHandle>(makeRelation(id));
+    }
+}
 
+Engine::RelationHandle Engine::makeRelation(const ram::Relation& id) {
     if (id.getRepresentation() == RelationRepresentation::EQREL) {
-        res = createEqrelRelation(id, isa.getIndexSelection(id.getName()));
+        return createEqrelRelation(id, isa.getIndexSelection(id.getName()));
     } else if (id.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
-        res = createBTreeDeleteRelation(id, isa.getIndexSelection(id.getName()));
+        return createBTreeDeleteRelation(id, isa.getIndexSelection(id.getName()));
     } else if (isProvenance) {
-        res = createProvenanceRelation(id, isa.getIndexSelection(id.getName()));
+        return createProvenanceRelation(id, isa.getIndexSelection(id.getName()));
     } else {
-        res = createBTreeRelation(id, isa.getIndexSelection(id.getName()));
+        return createBTreeRelation(id, isa.getIndexSelection(id.getName()));
     }
-    relations[idx] = mk<RelationHandle>(std::move(res));
+}
+
+bool Engine::unshareRelation(RelationHandle& handle, bool keepTuples) {
+    if (handle.use_count() == 1) {
+        return false;
+    }
+    RelationHandle copy = makeRelation(*relationDecls.at(handle->getName()));
+    if (keepTuples) {
+        for (const RamDomain* tuple : *handle) {
+            copy->insert(tuple);
+        }
+    }
+    handle = std::move(copy);
+    return true;
 }
 
 const std::vector<void*>& Engine::loadDLL() {
@@ -274,7 +312,8 @@ void Engine::resetIterationNumber() {
     iteration = 0;
 }
 
-void Engine::executeMain() {
+void Engine::executeMain(bool performIOArg) {
+    performIO = performIOArg;
     SignalHandler::instance()->set();
     if (Global::config().has("verbose")) {
         SignalHandler::instance()->enableLogging();
@@ -335,6 +374,19 @@ void Engine::executeMain() {
             ProfileEventSingleton::instance().makeQuantityEvent(
                     "@relation-reads;" + cur.first, cur.second, 0);
         }
+        if (statisticsEnabled) {
+            for (const auto& handle : relations) {
+                if (handle != nullptr && *handle != nullptr) {
+                    logRelationStatistics(**handle);
+                }
+            }
+        }
+    }
+    try {
+        asyncWriters.wait();
+    } catch (std::exception& e) {
+        std::cerr << e.what();
+        exit(EXIT_FAILURE);
     }
     SignalHandler::instance()->reset();
 }
@@ -344,6 +396,7 @@ void Engine::generateIR() {
     NodeGenerator generator(*this);
     if (subroutine.empty()) {
         for (const auto& sub : program.getSubroutines()) {
+            subroutineIndex[sub.first] = subroutine.size();
             subroutine.push_back(generator.generateTree(*sub.second));
         }
     }
@@ -358,10 +411,7 @@ void Engine::executeSubroutine(
     ctxt.setReturnValues(ret);
     ctxt.setArguments(args);
     generateIR();
-    const ram::Program& program = tUnit.getProgram();
-    auto subs = program.getSubroutines();
-    std::size_t i = distance(subs.begin(), subs.find(name));
-    execute(subroutine[i].get(), ctxt);
+    execute(subroutine[subroutineIndex.at(name)].get(), ctxt);
 }
 
 RamDomain Engine::execute(const Node* node, Context& ctxt) {
@@ -451,21 +501,30 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
     case FunctorOp::   opcode: BINARY_OP_SHIFT_MASK(tySigned   , op); \
     case FunctorOp::U##opcode: BINARY_OP_SHIFT_MASK(tyUnsigned , op);
 
-#define MINMAX_OP_SYM(op)                                        \
-    {                                                            \
-        auto result = EVAL_CHILD(RamDomain, 0);                  \
-        auto* result_val = &getSymbolTable().decode(result);     \
-        for (std::size_t i = 1; i < args.size(); i++) {          \
-            auto alt = EVAL_CHILD(RamDomain, i);                 \
-            if (alt == result) continue;                         \
-                                                                 \
-            const auto& alt_val = getSymbolTable().decode(alt);  \
-            if (*result_val op alt_val) {                        \
-                result_val = &alt_val;                           \
-                result = alt;                                    \
-            }                                                    \
-        }                                                        \
-        return result;                                           \
+#define MINMAX_OP_SYM(op)                                         \
+    {                                                             \
+        auto result = EVAL_CHILD(RamDomain, 0);                   \
+        if (isSymbolOrder) {                                      \
+            for (std::size_t i = 1; i < args.size(); i++) {       \
+                auto alt = EVAL_CHILD(RamDomain, i);              \
+                if (getSymbolTable().compare(result, alt) op 0) { \
+                    result = alt;                                 \
+                }                                                 \
+            }                                                     \
+            return result;                                        \
+        }                                                         \
+        auto* result_val = &getSymbolTable().decode(result);      \
+        for (std::size_t i = 1; i < args.size(); i++) {           \
+            auto alt = EVAL_CHILD(RamDomain, i);                  \
+            if (alt == result) continue;                          \
+                                                                  \
+            const auto& alt_val = getSymbolTable().decode(alt);   \
+            if (*result_val op alt_val) {                         \
+                result_val = &alt_val;                            \
+                result = alt;                                     \
+            }                                                     \
+        }                                                         \
+        return result;                                            \
     }
 #define MINMAX_OP(ty, op)                           \
     {                                               \
@@ -847,8 +906,11 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         CASE(Constraint)
         // clang-format off
 #define COMPARE_NUMERIC(ty, op) return EVAL_LEFT(ty) op EVAL_RIGHT(ty)
-#define COMPARE_STRING(op)                                        \
-    return (getSymbolTable().decode(EVAL_LEFT(RamDomain)) op \
+#define COMPARE_STRING(op)                                                                 \
+    if (isSymbolOrder) {                                                                   \
+        return getSymbolTable().compare(EVAL_LEFT(RamDomain), EVAL_RIGHT(RamDomain)) op 0; \
+    }                                                                                      \
+    return (getSymbolTable().decode(EVAL_LEFT(RamDomain)) op                               \
             getSymbolTable().decode(EVAL_RIGHT(RamDomain)))
 #define COMPARE_EQ_NE(opCode, op)                                         \
     case BinaryConstraintOp::   opCode: COMPARE_NUMERIC(RamDomain  , op); \
@@ -1171,11 +1233,18 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return execute(shadow.getChild(), ctxt);
         ESAC(DebugInfo)
 
-#define CLEAR(Structure, Arity, ...)                              \
-    CASE(Clear, Structure, Arity)                                 \
-        auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
-        rel.__purge();                                            \
-        return true;                                              \
+#define CLEAR(Structure, Arity, ...)                                  \
+    CASE(Clear, Structure, Arity)                                     \
+        if (statisticsEnabled) {                                      \
+            logRelationStatistics(*shadow.getRelation());             \
+        }                                                             \
+        /* a relation shared with forks is replaced by an empty one */ \
+        if (unshareRelation(shadow.getRelationHandle(), false)) {     \
+            return true;                                              \
+        }                                                             \
+        auto& rel = *static_cast<RelType*>(shadow.getRelation());     \
+        rel.__purge();                                                \
+        return true;                                                  \
     ESAC(Clear)
 
         FOR_EACH(CLEAR)
@@ -1194,8 +1263,15 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(LogSize)
 
         CASE(IO)
+            if (!performIO) {
+                return true;
+            }
             const auto& directive = cur.getDirectives();
             const std::string& op = cur.get("operation");
+            // an input relation shared with forks is copied before it is read into
+            if (op == "input") {
+                unshareRelation(shadow.getRelationHandle());
+            }
             auto& rel = *shadow.getRelation();
 
             if (op == "input") {
@@ -1206,12 +1282,20 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                 } catch (std::exception& e) {
                     std::cerr << "Error loading " << rel.getName() << " data: " << e.what() << "\n";
                 }
+                if (isSymbolOrder) {
+                    getSymbolTable().invalidateOrder();
+                }
                 return true;
             } else if (op == "output" || op == "printsize") {
                 try {
-                    IOSystem::getInstance()
-                            .getWriter(directive, getSymbolTable(), getRecordTable())
-                            ->writeAll(rel);
+                    if (isAsyncOutput) {
+                        asyncWriters.writeAll(
+                                directive, getSymbolTable(), getRecordTable(), rel, rel.getArity());
+                    } else {
+                        IOSystem::getInstance()
+                                .getWriter(directive, getSymbolTable(), getRecordTable())
+                                ->writeAll(rel);
+                    }
                 } catch (std::exception& e) {
                     std::cerr << e.what();
                     exit(EXIT_FAILURE);
@@ -1248,6 +1332,11 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                 }
             }
 
+            // Copy the written relations shared with forks before their views are created
+            for (RelationHandle* handle : shadow.getWrittenRelations()) {
+                unshareRelation(*handle);
+            }
+
             if (viewContext->isParallel) {
                 // If Parallel is true, holds views creation unitl parallel instructions.
             } else {
@@ -1262,6 +1351,9 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Query)
 
         CASE(MergeExtend)
+            // both relations are extended by the other
+            unshareRelation(getRelationHandle(shadow.getSourceId()));
+            unshareRelation(getRelationHandle(shadow.getTargetId()));
             auto& src = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getSourceId()).get());
             auto& trg = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getTargetId()).get());
             src.extendAndInsert(trg);
@@ -1280,6 +1372,44 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #undef DEBUG
 }
 
+void Engine::logRelationStatistics(const RelationWrapper& rel) {
+    // relations are profiled once, before they are cleared or at the end of the evaluation
+    const std::string& name = rel.getName();
+    if (name[0] == '@' || !statisticsLogged.insert(name).second) {
+        return;
+    }
+
+    // the column sets bound by the searches of the indexes, and each single column
+    const std::size_t arity = rel.getArity() - rel.getAuxiliaryArity();
+    std::set<std::vector<std::size_t>> columnSets;
+    for (std::size_t i = 0; i < arity; ++i) {
+        columnSets.insert({i});
+    }
+    for (const auto& order : isa.getIndexSelection(name).getAllOrders()) {
+        std::vector<std::size_t> columns;
+        for (std::size_t i = 0; i + 1 < order.size() && order[i] < arity; ++i) {
+            columns.push_back(order[i]);
+            std::vector<std::size_t> columnSet(columns);
+            std::sort(columnSet.begin(), columnSet.end());
+            columnSets.insert(columnSet);
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> sets(columnSets.begin(), columnSets.end());
+    std::vector<profile::HyperLogLog> sketches(sets.size());
+    for (const RamDomain* tuple : rel) {
+        for (std::size_t i = 0; i < sets.size(); ++i) {
+            sketches[i].insert(tuple, sets[i]);
+        }
+    }
+    for (std::size_t i = 0; i < sets.size(); ++i) {
+        auto distinctValues = static_cast<std::size_t>(std::llround(sketches[i].estimate()));
+        ProfileEventSingleton::instance().makeQuantityEvent(
+                "@relation-statistics;" + name + ";" + toString(join(sets[i], ",")),
+                std::min(distinctValues, rel.size()), 0);
+    }
+}
+
 template <typename Rel>
 RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt) {
     constexpr std::size_t Arity = Rel::Arity;
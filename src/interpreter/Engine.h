@@ -27,12 +27,14 @@
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
+#include "souffle/io/AsyncWriterPool.h"
 #include "souffle/utility/ContainerUtil.h"
 #include <atomic>
 #include <cstddef>
 #include <deque>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #ifdef _OPENMP
@@ -42,21 +44,34 @@
 namespace souffle::interpreter {
 
 class ProgInterface;
+class RelInterface;
 
 /**
  * @class Engine
  * @brief This class translate the RAM Program into executable format and interpreter it.
  */
 class Engine {
-    using RelationHandle = Own<RelationWrapper>;
+    /** Relations are shared with the forks of an engine, and copied when first written */
+    using RelationHandle = std::shared_ptr<RelationWrapper>;
     friend ProgInterface;
+    friend RelInterface;
     friend NodeGenerator;
 
 public:
     Engine(ram::TranslationUnit& tUnit);
 
-    /** @brief Execute the main program */
-    void executeMain();
+    /**
+     * @brief Fork the engine
+     *
+     * The fork shares the relations, the symbol table and the record table of
+     * this engine.  A shared relation is copied when it is first written by
+     * either engine, so that only the relations touched by later runs are
+     * duplicated.
+     */
+    Own<Engine> fork() const;
+
+    /** @brief Execute the main program, loading and storing relations if performIOArg is set */
+    void executeMain(bool performIOArg = true);
     /** @brief Execute the subroutine program */
     void executeSubroutine(
             const std::string& name, const std::vector<RamDomain>& args, std::vector<RamDomain>& ret);
@@ -72,7 +87,7 @@ private:
     RelationHandle& getRelationHandle(const std::size_t idx);
     /** @brief Return the string symbol table */
     SymbolTable& getSymbolTable() {
-        return symbolTable;
+        return *symbolTable;
     }
     /** @brief Return the record table */
     RecordTable& getRecordTable();
@@ -96,6 +111,13 @@ private:
     VecOwn<RelationHandle>& getRelationMap();
     /** @brief Create and add relation into the runtime environment.  */
     void createRelation(const ram::Relation& id, const std::size_t idx);
+    /** @brief Create an empty relation */
+    RelationHandle makeRelation(const ram::Relation& id);
+    /**
+     * @brief Give a relation shared with forks its own copy, or an empty one if keepTuples is false
+     * @return whether the relation was shared
+     */
+    bool unshareRelation(RelationHandle& handle, bool keepTuples = true);
 
     // -- Defines template for specialized interpreter operation -- */
     template <typename Rel>
@@ -156,13 +178,26 @@ private:
     template <typename Rel>
     RamDomain evalErase(Rel& rel, const Erase& shadow, Context& ctxt);
 
+    /** Log estimates of the distinct values of the column sets of a relation that its indexes search */
+    void logRelationStatistics(const RelationWrapper& rel);
+
     /** If profile is enable in this program */
     const bool profileEnabled;
     const bool frequencyCounterEnabled;
+    /** If the distinct values of relations are profiled */
+    const bool statisticsEnabled;
     /** If running a provenance program */
     const bool isProvenance;
+    /** If symbols are ranked for order-preserving comparisons */
+    const bool isSymbolOrder;
+    /** If output relations are written in the background */
+    const bool isAsyncOutput;
+    /** If the I/O statements of the running main program are executed */
+    bool performIO = true;
     /** subroutines */
     VecOwn<Node> subroutine;
+    /** Index of each subroutine by name, resolved once with the subroutines */
+    std::map<std::string, std::size_t> subroutineIndex;
     /** main program */
     Own<Node> main;
     /** Number of threads enabled for this program */
@@ -175,18 +210,24 @@ private:
     std::map<std::string, std::deque<std::atomic<std::size_t>>> frequencies;
     /** Profile for relation reads */
     std::map<std::string, std::atomic<std::size_t>> reads;
+    /** Relations whose statistics have been profiled */
+    std::set<std::string> statisticsLogged;
     /** DLL */
     std::vector<void*> dll;
     /** Program */
     ram::TranslationUnit& tUnit;
     /** IndexAnalysis */
     ram::analysis::IndexAnalysis& isa;
-    /** Record Table Implementation*/
-    SpecializedRecordTable<0, 1, 2, 3, 4, 5, 6, 7, 8, 9> recordTable;
+    /** Record Table Implementation, shared with forks */
+    std::shared_ptr<SpecializedRecordTable<0, 1, 2, 3, 4, 5, 6, 7, 8, 9>> recordTable;
     /** Symbol table for relations */
     VecOwn<RelationHandle> relations;
-    /** Symbol table */
-    SymbolTable symbolTable;
+    /** RAM relations by name, for the copies of shared relations */
+    std::map<std::string, const ram::Relation*> relationDecls;
+    /** Symbol table, shared with forks */
+    std::shared_ptr<SymbolTable> symbolTable;
+    /** Background writers of output relations; declared last so that they finish before the tables go */
+    AsyncWriterPool asyncWriters;
 };
 
 }  // namespace souffle::interpreter
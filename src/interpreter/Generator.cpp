@@ -20,7 +20,7 @@ namespace souffle::interpreter {
 
 using NodePtr = Own<Node>;
 using NodePtrVec = std::vector<NodePtr>;
-using RelationHandle = Own<RelationWrapper>;
+using RelationHandle = std::shared_ptr<RelationWrapper>;
 
 NodeGenerator::NodeGenerator(Engine& engine) : engine(engine) {
     visit(engine.tUnit.getProgram(), [&](const ram::Relation& relation) {
@@ -481,7 +481,21 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query
     viewContext->isParallel =
             visitExists(*next, [&](const Node& n) { return as<ram::AbstractParallel, AllowCrossCast>(n); });
 
-    auto res = mk<Query>(I_Query, &query, dispatch(*next));
+    // the relations written by the query, which are copied if they are shared with forks
+    std::set<std::size_t> written;
+    visit(*next, [&](const ram::Node& node) {
+        if (const auto* insert = as<ram::Insert>(node)) {
+            written.insert(encodeRelation(insert->getRelation()));
+        } else if (const auto* erase = as<ram::Erase>(node)) {
+            written.insert(encodeRelation(erase->getRelation()));
+        }
+    });
+    std::vector<RelationHandle*> writtenHandles;
+    for (std::size_t relId : written) {
+        writtenHandles.push_back(getRelationHandle(relId));
+    }
+
+    auto res = mk<Query>(I_Query, &query, dispatch(*next), std::move(writtenHandles));
     res->setViewContext(parentQueryViewContext);
     return res;
 }
@@ -34,6 +34,7 @@
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
 #include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/Exit.h"
 #include "ram/Expression.h"
@@ -97,6 +98,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <set>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
@@ -113,7 +115,7 @@ class Engine;
 class NodeGenerator : public ram::Visitor<Own<Node>> {
     using NodePtr = Own<Node>;
     using NodePtrVec = std::vector<NodePtr>;
-    using RelationHandle = Own<RelationWrapper>;
+    using RelationHandle = std::shared_ptr<RelationWrapper>;
     using ram::Visitor<Own<Node>>::visit_;
 
 public:
@@ -398,7 +398,7 @@ protected:
  */
 class RelationalOperation {
 public:
-    using RelationHandle = Own<RelationWrapper>;
+    using RelationHandle = std::shared_ptr<RelationWrapper>;
     RelationalOperation(RelationHandle* relHandle) : relHandle(relHandle) {}
 
     /** @brief get relation from handle */
@@ -407,6 +407,12 @@ public:
         return (*relHandle).get();
     }
 
+    /** @brief get handle */
+    RelationHandle& getRelationHandle() const {
+        assert(relHandle && "No relation cached\n");
+        return *relHandle;
+    }
+
 private:
     RelationHandle* const relHandle;
 };
@@ -882,7 +888,18 @@ public:
  * @class Query
  */
 class Query : public UnaryNode, public AbstractParallel {
-    using UnaryNode::UnaryNode;
+public:
+    using RelationHandle = std::shared_ptr<RelationWrapper>;
+    Query(enum NodeType ty, const ram::Node* sdw, Own<Node> child, std::vector<RelationHandle*> written)
+            : UnaryNode(ty, sdw, std::move(child)), writtenRelations(std::move(written)) {}
+
+    /** @brief Return the relations written by the query */
+    const std::vector<RelationHandle*>& getWrittenRelations() const {
+        return writtenRelations;
+    }
+
+private:
+    std::vector<RelationHandle*> writtenRelations;
 };
 
 /**
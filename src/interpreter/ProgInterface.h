@@ -49,28 +49,41 @@ class RelInterface : public souffle::Relation {
 public:
     RelInterface(RelationWrapper& r, SymbolTable& s, std::string n, std::vector<std::string> t,
             std::vector<std::string> an, uint32_t i)
-            : relation(r), symTable(s), name(std::move(n)), types(std::move(t)), attrNames(std::move(an)),
+            : relation(&r), symTable(s), name(std::move(n)), types(std::move(t)), attrNames(std::move(an)),
               id(i) {}
+
+    /** Wrap a relation of an engine, following the copies made of relations shared with forks */
+    RelInterface(Engine& e, std::shared_ptr<RelationWrapper>& h, SymbolTable& s, std::string n,
+            std::vector<std::string> t, std::vector<std::string> an, uint32_t i)
+            : RelInterface(*h, s, std::move(n), std::move(t), std::move(an), i) {
+        engine = &e;
+        handle = &h;
+    }
     ~RelInterface() override = default;
 
     /** Insert tuple */
     void insert(const tuple& t) override {
-        relation.insert(t.data);
+        getWritableRelation().insert(t.data);
     }
 
     /** Check whether tuple exists */
     bool contains(const tuple& t) const override {
-        return relation.contains(t.data);
+        return getRelation().contains(t.data);
+    }
+
+    /** Erase tuple */
+    bool erase(const tuple& t) override {
+        return getWritableRelation().erase(t.data);
     }
 
     /** Iterator to first tuple */
     iterator begin() const override {
-        return RelInterface::iterator(mk<RelInterface::iterator_base>(id, this, relation.begin()));
+        return RelInterface::iterator(mk<RelInterface::iterator_base>(id, this, getRelation().begin()));
     }
 
     /** Iterator to last tuple */
     iterator end() const override {
-        return RelInterface::iterator(mk<RelInterface::iterator_base>(id, this, relation.end()));
+        return RelInterface::iterator(mk<RelInterface::iterator_base>(id, this, getRelation().end()));
     }
 
     /** Get name */
@@ -80,12 +93,12 @@ public:
 
     /** Get arity */
     arity_type getArity() const override {
-        return relation.getArity();
+        return getRelation().getArity();
     }
 
     /** Get arity */
     arity_type getAuxiliaryArity() const override {
-        return relation.getAuxiliaryArity();
+        return getRelation().getAuxiliaryArity();
     }
 
     /** Get symbol table */
@@ -107,12 +120,15 @@ public:
 
     /** Get number of tuples in relation */
     std::size_t size() const override {
-        return relation.size();
+        return getRelation().size();
     }
 
     /** Eliminate all the tuples in relation*/
     void purge() override {
-        relation.purge();
+        // a relation shared with forks is replaced by an empty one
+        if (engine == nullptr || !engine->unshareRelation(*handle, false)) {
+            getRelation().purge();
+        }
     }
 
 protected:
@@ -180,8 +196,25 @@ protected:
     };
 
 private:
+    /** Get the wrapped relation */
+    RelationWrapper& getRelation() const {
+        return handle != nullptr ? **handle : *relation;
+    }
+
+    /** Get the wrapped relation, copying it first if it is shared with forks */
+    RelationWrapper& getWritableRelation() {
+        if (engine != nullptr) {
+            engine->unshareRelation(*handle);
+        }
+        return getRelation();
+    }
+
     /** Wrapped interpreter relation */
-    RelationWrapper& relation;
+    RelationWrapper* relation;
+
+    /** Engine of the relation and its handle, if the relation is read through the engine */
+    Engine* engine = nullptr;
+    std::shared_ptr<RelationWrapper>* handle = nullptr;
 
     /** Symbol table */
     SymbolTable& symTable;
@@ -219,8 +252,8 @@ public:
                 // Skip droped relation.
                 continue;
             }
-            auto& interpreterRel = **relHandler;
-            auto& name = interpreterRel.getName();
+            auto& interpreterRel = *relHandler;
+            auto& name = interpreterRel->getName();
             assert(map[name]);
             const ram::Relation& rel = *map[name];
 
@@ -228,7 +261,8 @@ public:
             std::vector<std::string> types = rel.getAttributeTypes();
             std::vector<std::string> attrNames = rel.getAttributeNames();
 
-            auto* interface = new RelInterface(interpreterRel, symTable, rel.getName(), types, attrNames, id);
+            auto* interface =
+                    new RelInterface(exec, interpreterRel, symTable, rel.getName(), types, attrNames, id);
             interfaces.push_back(interface);
             bool input = false;
             bool output = false;
@@ -254,8 +288,13 @@ public:
         }
     }
 
-    /** Run program instance: not implemented */
-    void run() override {}
+    /**
+     * Run program instance without loading or storing relations, as the compiled run() does; in
+     * incremental mode, only the tuples inserted since the last run are used
+     */
+    void run() override {
+        exec.executeMain(false);
+    }
 
     /** Load data, run program instance, store data: not implemented */
     void runAll(std::string, std::string, bool, bool) override {}
@@ -287,8 +326,18 @@ public:
         return recordTable;
     }
 
+    /** Fork program instance, with an engine sharing the relations and tables of this one */
+    std::unique_ptr<SouffleProgram> fork() override {
+        Own<Engine> engine = exec.fork();
+        auto forked = mk<ProgInterface>(*engine);
+        forked->forkedEngine = std::move(engine);
+        return forked;
+    }
+
 private:
     const ram::Program& prog;
+    /** Engine created for a fork, owned by its interface */
+    Own<Engine> forkedEngine;
     Engine& exec;
     SymbolTable& symTable;
     RecordTable& recordTable;
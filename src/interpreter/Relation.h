@@ -109,6 +109,11 @@ public:
 
     virtual bool contains(const RamDomain*) const = 0;
 
+    /** Erase a tuple, if the relation supports erasure */
+    virtual bool erase(const RamDomain*) {
+        return false;
+    }
+
     virtual std::size_t size() const = 0;
 
     virtual void purge() = 0;
@@ -424,6 +429,10 @@ public:
         }
         return true;
     }
+
+    bool erase(const RamDomain* data) override {
+        return erase(this->constructTuple(data));
+    }
 };
 
 class EqrelRelation : public Relation<2, Eqrel> {
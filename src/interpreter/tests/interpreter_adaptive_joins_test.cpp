@@ -0,0 +1,149 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file interpreter_adaptive_joins_test.cpp
+ *
+ * Tests the plans of recursive clauses chosen at runtime with adaptive
+ * joins, from the sizes of the relations they scan first.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "Global.h"
+#include "ast/TranslationUnit.h"
+#include "ast/transform/IODefaults.h"
+#include "ast2ram/UnitTranslator.h"
+#include "ast2ram/seminaive/TranslationStrategy.h"
+#include "ast2ram/utility/TranslatorContext.h"
+#include "ast2ram/utility/Utils.h"
+#include "interpreter/Engine.h"
+#include "interpreter/ProgInterface.h"
+#include "parser/ParserDriver.h"
+#include "ram/RelationSize.h"
+#include "ram/TranslationUnit.h"
+#include "ram/utility/Visitor.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+namespace {
+
+using Tuples = std::set<std::vector<RamDomain>>;
+
+/** The recursive clause scans either the delta of reach or edge first */
+const std::string reachProgram = R"(
+    .decl edge(x:number, y:number)
+    .input edge
+
+    .decl start(x:number, y:number)
+    .input start
+
+    .decl reach(x:number, y:number)
+    .output reach
+    reach(x, y) :- start(x, y).
+    reach(x, z) :- reach(x, y), edge(y, z).
+)";
+
+Own<ram::TranslationUnit> translate(ErrorReport& errReport, DebugReport& debugReport) {
+    Global::config().set("jobs", "1");
+    Global::config().set("adaptive-joins");
+    auto astTranslationUnit = ParserDriver::parseTranslationUnit(reachProgram, errReport, debugReport);
+    mk<ast::transform::IODefaultsTransformer>()->apply(*astTranslationUnit);
+    auto translationStrategy = mk<ast2ram::seminaive::TranslationStrategy>();
+    auto unitTranslator = Own<ast2ram::UnitTranslator>(translationStrategy->createUnitTranslator());
+    auto translationUnit = unitTranslator->translateUnit(*astTranslationUnit);
+    Global::config().unset("adaptive-joins");
+    return translationUnit;
+}
+
+void insert(SouffleProgram& prog, const std::string& name, RamDomain x, RamDomain y) {
+    souffle::Relation* relation = prog.getRelation(name);
+    tuple t(relation);
+    t << x << y;
+    relation->insert(t);
+}
+
+Tuples getTuples(SouffleProgram& prog, const std::string& name) {
+    souffle::Relation* relation = prog.getRelation(name);
+    Tuples tuples;
+    for (auto& t : *relation) {
+        std::vector<RamDomain> values(relation->getArity());
+        for (auto& value : values) {
+            t >> value;
+        }
+        tuples.insert(values);
+    }
+    return tuples;
+}
+
+/** Evaluate reach from the given starts over a binary tree of 30 edges, whose leaves are 16 to 31 */
+Tuples evaluateReach(ram::TranslationUnit& translationUnit, const std::vector<RamDomain>& starts,
+        Tuples& lastSizes, Tuples& lastPlan) {
+    Engine engine(translationUnit);
+    engine.executeMain(false);
+    ProgInterface prog(engine);
+    for (RamDomain node = 1; node < 16; node++) {
+        insert(prog, "edge", node, 2 * node);
+        insert(prog, "edge", node, 2 * node + 1);
+    }
+    for (RamDomain x : starts) {
+        insert(prog, "start", x, 1);
+    }
+    prog.run();
+    lastSizes = getTuples(prog, ast2ram::getAdaptiveSizesRelationName());
+    lastPlan = getTuples(prog, ast2ram::getAdaptivePlanRelationName());
+    return getTuples(prog, "reach");
+}
+
+}  // namespace
+
+TEST(AdaptiveJoins, SizesComputedOnce) {
+    ErrorReport errReport;
+    DebugReport debugReport;
+    Own<ram::TranslationUnit> translationUnit = translate(errReport, debugReport);
+
+    // the sizes of the delta of reach and of edge are read once per iteration
+    std::size_t sizes = 0;
+    visit(translationUnit->getProgram(), [&](const ram::RelationSize&) { ++sizes; });
+    EXPECT_EQ(2, sizes);
+}
+
+TEST(AdaptiveJoins, PlanSwitches) {
+    ErrorReport errReport;
+    DebugReport debugReport;
+    Own<ram::TranslationUnit> translationUnit = translate(errReport, debugReport);
+    Tuples lastSizes;
+    Tuples lastPlan;
+
+    // From a single start, the delta of reach doubles in each of the 5 iterations, reaching 16 leaves,
+    // and stays smaller than edge: the delta is scanned first throughout
+    Tuples reach = evaluateReach(*translationUnit, {0}, lastSizes, lastPlan);
+    EXPECT_EQ(31, reach.size());
+    EXPECT_EQ(Tuples({{16, 30, 0}}), lastSizes);
+    EXPECT_EQ(Tuples({{0}}), lastPlan);
+
+    // From 4 starts, the delta of 4 tuples is scanned first in the first iteration, while in the last
+    // one the delta of 64 tuples is larger than edge, which is then scanned first
+    reach = evaluateReach(*translationUnit, {0, 1, 2, 3}, lastSizes, lastPlan);
+    EXPECT_EQ(4 * 31, reach.size());
+    EXPECT_EQ(Tuples({{64, 30, 0}}), lastSizes);
+    EXPECT_EQ(Tuples({{1}}), lastPlan);
+}
+
+}  // namespace souffle::interpreter::test
@@ -0,0 +1,161 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file interpreter_fork_test.cpp
+ *
+ * Tests the forks of interpreter engines, which share their relations
+ * copy-on-write.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "Global.h"
+#include "RelationTag.h"
+#include "ast/TranslationUnit.h"
+#include "ast/transform/IODefaults.h"
+#include "ast2ram/UnitTranslator.h"
+#include "ast2ram/seminaive/TranslationStrategy.h"
+#include "ast2ram/utility/TranslatorContext.h"
+#include "interpreter/Engine.h"
+#include "interpreter/ProgInterface.h"
+#include "parser/ParserDriver.h"
+#include "ram/Expression.h"
+#include "ram/Insert.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/Scan.h"
+#include "ram/Statement.h"
+#include "ram/TranslationUnit.h"
+#include "ram/TupleElement.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+/** A program copying the tuples of edge into path */
+Own<ram::TranslationUnit> makeCopyProgram(ErrorReport& errReport, DebugReport& debugReport) {
+    VecOwn<ram::Relation> rels;
+    for (const std::string name : {"edge", "path"}) {
+        rels.push_back(mk<ram::Relation>(name, 2, 0, std::vector<std::string>{"x", "y"},
+                std::vector<std::string>{"i", "i"}, RelationRepresentation::BTREE));
+    }
+    VecOwn<ram::Expression> values;
+    values.push_back(mk<ram::TupleElement>(0, 0));
+    values.push_back(mk<ram::TupleElement>(0, 1));
+    Own<ram::Statement> main =
+            mk<ram::Query>(mk<ram::Scan>("edge", 0, mk<ram::Insert>("path", std::move(values))));
+    std::map<std::string, Own<ram::Statement>> subs;
+    return mk<ram::TranslationUnit>(
+            mk<ram::Program>(std::move(rels), std::move(main), std::move(subs)), errReport, debugReport);
+}
+
+/** A program closing the edges under an equivalence relation, which is extended in a fixpoint */
+Own<ram::TranslationUnit> makeEqrelProgram(ErrorReport& errReport, DebugReport& debugReport) {
+    auto astTranslationUnit = ParserDriver::parseTranslationUnit(R"(
+        .decl edge(x:number, y:number)
+        .input edge
+
+        .decl same(x:number, y:number) eqrel
+        .output same
+        same(x, y) :- edge(x, y).
+        same(x, z) :- same(x, y), same(y, z).
+    )",
+            errReport, debugReport);
+    mk<ast::transform::IODefaultsTransformer>()->apply(*astTranslationUnit);
+    auto translationStrategy = mk<ast2ram::seminaive::TranslationStrategy>();
+    auto unitTranslator = Own<ast2ram::UnitTranslator>(translationStrategy->createUnitTranslator());
+    return unitTranslator->translateUnit(*astTranslationUnit);
+}
+
+std::size_t size(SouffleProgram& prog, const std::string& name) {
+    return prog.getRelation(name)->size();
+}
+
+void insertEdge(SouffleProgram& prog, RamDomain x, RamDomain y) {
+    souffle::Relation* edge = prog.getRelation("edge");
+    tuple t(edge);
+    t << x << y;
+    edge->insert(t);
+}
+
+TEST(Fork, CopyOnWrite) {
+    Global::config().set("jobs", "1");
+    ErrorReport errReport;
+    DebugReport debugReport;
+    Own<ram::TranslationUnit> translationUnit = makeCopyProgram(errReport, debugReport);
+
+    // the relations of the engine are created by its first run
+    Engine engine(*translationUnit);
+    engine.executeMain();
+    ProgInterface base(engine);
+    insertEdge(base, 1, 2);
+    base.run();
+    EXPECT_EQ(1, size(base, "path"));
+
+    Own<SouffleProgram> fork = base.fork();
+    EXPECT_EQ(1, size(*fork, "edge"));
+    EXPECT_EQ(1, size(*fork, "path"));
+
+    // writes of the fork are not seen by the base, and vice versa
+    insertEdge(*fork, 2, 3);
+    fork->run();
+    EXPECT_EQ(2, size(*fork, "path"));
+    EXPECT_EQ(1, size(base, "edge"));
+    EXPECT_EQ(1, size(base, "path"));
+
+    insertEdge(base, 4, 5);
+    base.run();
+    EXPECT_EQ(2, size(base, "path"));
+    EXPECT_EQ(2, size(*fork, "path"));
+    EXPECT_FALSE(fork->getRelation("path")->contains(tuple(fork->getRelation("path"), {4, 5})));
+
+    // a purge of a shared relation leaves the other engine alone
+    Own<SouffleProgram> other = fork->fork();
+    other->getRelation("path")->purge();
+    EXPECT_EQ(0, size(*other, "path"));
+    EXPECT_EQ(2, size(*fork, "path"));
+}
+
+TEST(Fork, RecursiveEqrel) {
+    Global::config().set("jobs", "1");
+    ErrorReport errReport;
+    DebugReport debugReport;
+    Own<ram::TranslationUnit> translationUnit = makeEqrelProgram(errReport, debugReport);
+
+    Engine engine(*translationUnit);
+    engine.executeMain(false);
+    ProgInterface base(engine);
+    insertEdge(base, 1, 2);
+    insertEdge(base, 2, 3);
+    base.run();
+    EXPECT_EQ(9, size(base, "same"));
+
+    // the fixpoint of the fork extends its own copy of the equivalence relation
+    Own<SouffleProgram> fork = base.fork();
+    insertEdge(*fork, 3, 4);
+    insertEdge(*fork, 5, 6);
+    fork->run();
+    EXPECT_EQ(20, size(*fork, "same"));
+    EXPECT_EQ(9, size(base, "same"));
+    EXPECT_FALSE(base.getRelation("same")->contains(tuple(base.getRelation("same"), {1, 4})));
+    EXPECT_FALSE(base.getRelation("same")->contains(tuple(base.getRelation("same"), {5, 6})));
+}
+
+}  // namespace souffle::interpreter::test
@@ -0,0 +1,206 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file interpreter_incremental_test.cpp
+ *
+ * Tests the incremental evaluation of interpreted programs, whose results
+ * after each run must match those of a new instance on the same inputs.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "Global.h"
+#include "ast/TranslationUnit.h"
+#include "ast/transform/IODefaults.h"
+#include "ast/transform/SemanticChecker.h"
+#include "ast2ram/UnitTranslator.h"
+#include "ast2ram/seminaive/TranslationStrategy.h"
+#include "ast2ram/utility/TranslatorContext.h"
+#include "interpreter/Engine.h"
+#include "interpreter/ProgInterface.h"
+#include "parser/ParserDriver.h"
+#include "ram/TranslationUnit.h"
+#include "reports/DebugReport.h"
+#include "reports/ErrorReport.h"
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+#include "souffle/utility/FileUtil.h"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+namespace {
+
+using Edge = std::array<RamDomain, 2>;
+using Tuples = std::set<std::vector<RamDomain>>;
+
+const std::string pathProgram = R"(
+    .decl edge(x:number, y:number)
+    .input edge
+
+    .decl path(x:number, y:number)
+    .output path
+    path(x, y) :- edge(x, y).
+    path(x, z) :- path(x, y), edge(y, z).
+
+    .decl start(x:number)
+    start(1).
+
+    .decl reach(x:number)
+    .output reach
+    reach(x) :- start(x).
+    reach(y) :- reach(x), edge(x, y).
+)";
+
+const std::string retractProgram = pathProgram + R"(
+    .decl looped()
+    .output looped
+    looped() :- path(x, x).
+
+    .decl triangle(x:number, y:number, z:number)
+    .output triangle
+    triangle(x, y, z) :- edge(x, y), edge(y, z), edge(z, x).
+)";
+
+/** Translate a program for incremental evaluation */
+Own<ram::TranslationUnit> translate(
+        const std::string& program, ErrorReport& errReport, DebugReport& debugReport) {
+    Global::config().set("jobs", "1");
+    Global::config().set("incremental");
+    auto astTranslationUnit = ParserDriver::parseTranslationUnit(program, errReport, debugReport);
+    mk<ast::transform::IODefaultsTransformer>()->apply(*astTranslationUnit);
+    mk<ast::transform::SemanticChecker>()->apply(*astTranslationUnit);
+    auto translationStrategy = mk<ast2ram::seminaive::TranslationStrategy>();
+    auto unitTranslator = Own<ast2ram::UnitTranslator>(translationStrategy->createUnitTranslator());
+    return unitTranslator->translateUnit(*astTranslationUnit);
+}
+
+/** An instance of the program, whose relations are created by a first run on empty inputs */
+struct Instance {
+    Engine engine;
+    ProgInterface prog;
+
+    Instance(ram::TranslationUnit& translationUnit) : engine(translationUnit), prog(initialise(engine)) {}
+
+    static Engine& initialise(Engine& engine) {
+        engine.executeMain(false);
+        return engine;
+    }
+};
+
+tuple makeEdge(souffle::Relation* edge, const Edge& values) {
+    tuple t(edge);
+    t << values[0] << values[1];
+    return t;
+}
+
+void insertEdges(SouffleProgram& prog, const std::vector<Edge>& edges) {
+    souffle::Relation* edge = prog.getRelation("edge");
+    for (const auto& values : edges) {
+        edge->insert(makeEdge(edge, values));
+    }
+}
+
+Tuples getTuples(SouffleProgram& prog, const std::string& name) {
+    souffle::Relation* relation = prog.getRelation(name);
+    Tuples tuples;
+    for (auto& t : *relation) {
+        std::vector<RamDomain> values(relation->getArity());
+        for (auto& value : values) {
+            t >> value;
+        }
+        tuples.insert(values);
+    }
+    return tuples;
+}
+
+}  // namespace
+
+TEST(Incremental, Insert) {
+    ErrorReport errReport;
+    DebugReport debugReport;
+    Own<ram::TranslationUnit> translationUnit = translate(pathProgram, errReport, debugReport);
+    EXPECT_EQ(0, errReport.getNumErrors());
+
+    Instance incremental(*translationUnit);
+    const std::vector<std::vector<Edge>> rounds = {{{1, 2}, {2, 3}}, {{3, 4}}, {{4, 1}, {5, 6}}};
+    const std::vector<std::size_t> pathSizes = {3, 6, 17};
+    std::vector<Edge> edges;
+    for (std::size_t round = 0; round < rounds.size(); ++round) {
+        insertEdges(incremental.prog, rounds[round]);
+        incremental.prog.run();
+        edges.insert(edges.end(), rounds[round].begin(), rounds[round].end());
+
+        // a new instance evaluates all edges at once
+        Instance full(*translationUnit);
+        insertEdges(full.prog, edges);
+        full.prog.run();
+
+        EXPECT_EQ(edges.size(), getTuples(incremental.prog, "edge").size());
+        EXPECT_EQ(pathSizes[round], getTuples(incremental.prog, "path").size());
+        for (const std::string name : {"edge", "path", "reach"}) {
+            EXPECT_EQ(getTuples(full.prog, name), getTuples(incremental.prog, name));
+        }
+    }
+
+    // runs of the interface neither load nor store relations
+    EXPECT_FALSE(existFile("path.csv"));
+    EXPECT_FALSE(existFile("reach.csv"));
+}
+
+TEST(Incremental, Retract) {
+    ErrorReport errReport;
+    DebugReport debugReport;
+    Own<ram::TranslationUnit> translationUnit = translate(retractProgram, errReport, debugReport);
+    EXPECT_EQ(0, errReport.getNumErrors());
+
+    // the edges inserted and erased before each run, and the sizes of the relations after it
+    const std::vector<std::pair<std::vector<Edge>, std::vector<Edge>>> rounds = {
+            {{{1, 2}, {2, 3}, {3, 1}, {3, 4}, {4, 5}, {5, 6}}, {}}, {{{6, 7}}, {{3, 1}}},
+            {{{4, 1}}, {{4, 5}, {24, 25}}}, {{{2, 1}}, {{1, 2}, {2, 3}}},
+            {{}, {{3, 4}, {4, 1}, {5, 6}, {6, 7}, {2, 1}}}, {{{1, 2}, {2, 1}}, {}}};
+    const std::vector<std::vector<std::size_t>> sizes = {{6, 21, 6, 1, 3}, {6, 21, 7, 0, 0},
+            {6, 19, 4, 1, 0}, {5, 7, 1, 0, 0}, {0, 0, 1, 0, 0}, {2, 4, 2, 1, 0}};
+    const std::vector<std::string> names = {"edge", "path", "reach", "looped", "triangle"};
+
+    Instance incremental(*translationUnit);
+    souffle::Relation* edge = incremental.prog.getRelation("edge");
+    std::set<Edge> edges;
+    for (std::size_t round = 0; round < rounds.size(); ++round) {
+        const auto& [insertions, erasures] = rounds[round];
+        insertEdges(incremental.prog, insertions);
+        edges.insert(insertions.begin(), insertions.end());
+        for (const auto& values : erasures) {
+            edge->erase(makeEdge(edge, values));
+            edges.erase(values);
+        }
+        incremental.prog.run();
+
+        // a new instance evaluates the remaining edges at once
+        Instance full(*translationUnit);
+        insertEdges(full.prog, std::vector<Edge>(edges.begin(), edges.end()));
+        full.prog.run();
+
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            const Tuples tuples = getTuples(incremental.prog, names[i]);
+            EXPECT_EQ(sizes[round][i], tuples.size());
+            EXPECT_EQ(getTuples(full.prog, names[i]), tuples);
+        }
+    }
+}
+
+}  // namespace souffle::interpreter::test
@@ -26,6 +26,8 @@
 #include "ast/transform/ComponentInstantiation.h"
 #include "ast/transform/Conditional.h"
 #include "ast/transform/ExecutionPlanChecker.h"
+#include "ast/transform/ExecutionPlanFile.h"
+#include "ast/transform/ExecutionPlanSearch.h"
 #include "ast/transform/ExpandEqrels.h"
 #include "ast/transform/Fixpoint.h"
 #include "ast/transform/FoldAnonymousRecords.h"
@@ -49,6 +51,7 @@
 #include "ast/transform/RemoveRedundantRelations.h"
 #include "ast/transform/RemoveRedundantSums.h"
 #include "ast/transform/RemoveRelationCopies.h"
+#include "ast/transform/RemoveUnusedColumns.h"
 #include "ast/transform/ReorderLiterals.h"
 #include "ast/transform/ReplaceSingletonVariables.h"
 #include "ast/transform/ResolveAliases.h"
@@ -89,12 +92,14 @@
 #include "ram/transform/TupleId.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
+#include "reports/TransformerProfile.h"
 #include "souffle/RamTypes.h"
 #include "souffle/profile/Tui.h"
 #include "souffle/provenance/Explain.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/SubProcess.h"
@@ -104,6 +109,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -121,7 +127,8 @@ namespace souffle {
 /**
  * Executes a binary file.
  */
-[[noreturn]] void executeBinaryAndExit(const std::string& binaryFilename) {
+[[noreturn]] void executeBinaryAndExit(
+        const std::string& binaryFilename, const std::vector<std::string>& unitFilenames) {
     assert(!binaryFilename.empty() && "binary filename cannot be blank");
 
     std::map<char const*, std::string> env;
@@ -141,15 +148,28 @@ namespace souffle {
     if (!Global::config().has("dl-program")) {
         remove(binaryFilename.c_str());
         remove((binaryFilename + ".cpp").c_str());
+        // the header and the units of a split program, with the objects cached by souffle-compile
+        if (Global::config().has("split-units")) {
+            remove((binaryFilename + ".h").c_str());
+            remove((binaryFilename + ".o").c_str());
+            remove((binaryFilename + ".o.sum").c_str());
+            for (auto&& unit : unitFilenames) {
+                const std::string object = unit.substr(0, unit.size() - 4) + ".o";
+                remove(unit.c_str());
+                remove(object.c_str());
+                remove((object + ".sum").c_str());
+            }
+        }
     }
 
     std::exit(exit ? *exit : EXIT_FAILURE);
 }
 
 /**
- * Compiles the given source file to a binary file.
+ * Compiles the given source file, and the further units of a split program, to a binary file.
  */
-void compileToBinary(const std::string& command, std::string_view sourceFilename) {
+void compileToBinary(const std::string& command, std::string_view sourceFilename,
+        const std::vector<std::string>& unitFilenames) {
     std::vector<std::string> argv;
     if (Global::config().has("swig")) {
         argv.push_back("-s");
@@ -171,7 +191,15 @@ void compileToBinary(const std::string& command, std::string_view sourceFilename
         argv.push_back(tfm::format("-l%s", library));
     }
 
+    if (Global::config().has("pgo")) {
+        // train on the fact directory if no other directory is given
+        const std::string& trainingDir = Global::config().get("pgo");
+        argv.push_back("-P");
+        argv.push_back(trainingDir.empty() ? Global::config().get("fact-dir") : trainingDir);
+    }
+
     argv.push_back(std::string(sourceFilename));
+    argv.insert(argv.end(), unitFilenames.begin(), unitFilenames.end());
 
     auto exit = execute(command, argv);
     if (!exit) throw std::invalid_argument(tfm::format("unable to execute tool <%s>", command));
@@ -179,10 +207,29 @@ void compileToBinary(const std::string& command, std::string_view sourceFilename
         throw std::invalid_argument(tfm::format("failed to compile C++ source <%s>", sourceFilename));
 }
 
+/**
+ * Checks that incremental evaluation is not combined with the options it does not support, which may be set
+ * on the command line or by pragmas.
+ */
+void checkIncrementalOptions() {
+    if (!Global::config().has("incremental")) {
+        return;
+    }
+    if (Global::config().has("provenance")) {
+        throw std::runtime_error("--incremental cannot be combined with provenance.");
+    }
+    if (Global::config().has("magic-transform") || Global::config().has("magic-transform-auto")) {
+        throw std::runtime_error("--incremental cannot be combined with the magic set transformation.");
+    }
+}
+
 int main(int argc, char** argv) {
     /* Time taking for overall runtime */
     auto souffle_start = std::chrono::high_resolution_clock::now();
 
+    /* the arguments of the evaluations timing candidate plans, if searching execution plans */
+    std::vector<std::string> planSearchArguments;
+
     /* have all to do with command line arguments in its own scope, as these are accessible through the global
      * configuration only */
     try {
@@ -221,6 +268,15 @@ int main(int argc, char** argv) {
                         "<FILE>. If <FILE> is `-` then stdout is used."},
                 {"inline-exclude", '\x7', "RELATIONS", "", false,
                         "Prevent the given relations from being inlined. Overrides any `inline` qualifiers."},
+                {"adaptive-joins", '\x15', "", "", false,
+                        "Translate the versions of recursive clauses into alternative plans, of which "
+                        "the plan scanning the smallest relation first is chosen in each iteration."},
+                {"inline-auto", '\x12', "", "", false,
+                        "Inline cheap intermediate relations used by a single clause, guided by the profile "
+                        "given with `profile-use`."},
+                {"inline-limit", '\x13', "N", "", false,
+                        "Materialise inlined relations that would produce more than <N> clauses from a "
+                        "single clause (default 10000 with `inline-auto`)."},
                 {"swig", 's', "LANG", "", false,
                         "Generate SWIG interface for given language. The values <LANG> accepts is java and "
                         "python. "},
@@ -233,9 +289,32 @@ int main(int argc, char** argv) {
                 {"magic-transform-exclude", '\x8', "RELATIONS", "", false,
                         "Disable magic set transformation changes on the given relations. Overrides "
                         "`magic-transform`. Implies `inline-exclude` for the given relations."},
+                {"magic-transform-auto", '\x14', "", "", false,
+                        "Enable the magic set transformation on the relations where it is expected to pay "
+                        "off: relations bound by constants, or by much smaller relations according to the "
+                        "profile given with `profile-use`, and the relations they depend on. The atoms of "
+                        "adorned clauses are ordered by the `SIPS` pragma, all-bound by default."},
                 {"macro", 'M', "MACROS", "", false, "Set macro definitions for the pre-processor"},
                 {"disable-transformers", 'z', "TRANSFORMERS", "", false,
                         "Disable the given AST transformers."},
+                {"order-symbols", '\x9', "", "", false,
+                        "Rank symbols after loading inputs so that lexicographic comparisons compare "
+                        "integers."},
+                {"async-output", '\xb', "", "", false,
+                        "Write output relations in the background while the evaluation continues."},
+                {"split-units", '\xc', "N", "", false,
+                        "Split the generated C++ code into translation units of N strata each, which are "
+                        "compiled in parallel and reused while unchanged."},
+                {"pgo", '\xe', "DIR", "", false,
+                        "Build the compiled program with profile-guided optimisation, trained on the facts "
+                        "in <DIR>. If <DIR> is empty, the fact directory is used."},
+                {"prefetch-joins", '\xf', "", "", false,
+                        "Look up the ranges of nested index scans in batches and prefetch them in the "
+                        "generated C++ code."},
+                {"incremental", '\x10', "", "", false,
+                        "Evaluate incrementally: each run of a program instance only derives the "
+                        "consequences of the tuples added to or erased from its input relations since "
+                        "the previous run."},
                 {"dl-program", 'o', "FILE", "", false,
                         "Generate C++ source code, written to <FILE>, and compile this to a "
                         "binary executable (without executing it)."},
@@ -244,10 +323,25 @@ int main(int argc, char** argv) {
                 {"profile-use", 'u', "FILE", "", false,
                         "Use profile log-file <FILE> for profile-guided optimization."},
                 {"profile-frequency", '\2', "", "", false, "Enable the frequency counter in the profiler."},
+                {"plan-file", '\x17', "FILE", "", false,
+                        "Apply the execution plans of the clauses in <FILE>, as written by `plan-search`, to "
+                        "the clauses without a plan of their own."},
+                {"plan-search", '\x18', "N", "", false,
+                        "Time alternative join orders of the <N> most expensive clauses of the profile given "
+                        "with `profile-use` on the facts in the fact directory, and write those clearly "
+                        "faster than the current orders to the plan file given with `plan-file`, keeping "
+                        "its plans of the other clauses."},
+                {"profile-statistics", '\x16', "", "", false,
+                        "Estimate the distinct values of the columns searched by the indexes of each "
+                        "relation in the profiler, for the join orders chosen with `profile-use`."},
                 {"debug-report", 'r', "FILE", "", false, "Write HTML debug report to <FILE>."},
                 {"pragma", 'P', "OPTIONS", "", true, "Set pragma options."},
                 {"provenance", 't', "[ none | explain | explore ]", "", false,
                         "Enable provenance instrumentation and interaction."},
+                {"provenance-relations", '\x11', "RELATIONS", "", false,
+                        "Only keep the provenance of the given comma-separated relations and of the "
+                        "relations they depend on; the other relations are cleared when they are no longer "
+                        "needed."},
                 {"verbose", 'v', "", "", false, "Verbose output."},
                 {"version", '\3', "", "", false, "Version."},
                 {"show", '\4', "[ <see-list> ]", "", true,
@@ -262,12 +356,32 @@ int main(int argc, char** argv) {
                         "\tscc-graph-text\n"
                         "\ttransformed-ast\n"
                         "\ttransformed-ram\n"
+                        "\ttransformer-profile\n"
                         "\ttype-analysis"},
                 {"parse-errors", '\5', "", "", false, "Show parsing errors, if any, then exit."},
                 {"help", 'h', "", "", false, "Display this help message."},
                 {"legacy", '\6', "", "", false, "Enable legacy support."}};
         Global::config().processArgs(argc, argv, header.str(), footer.str(), options);
 
+        // the evaluations timing candidate plans are invoked with the given arguments, except those
+        // selecting the kind of evaluation, its outputs, its profile and its plans
+        if (Global::config().has("plan-search")) {
+            const std::set<std::string> replaced = {"compile", "debug-report", "dl-program", "generate",
+                    "live-profile", "output-dir", "plan-file", "plan-search", "profile", "profile-frequency",
+                    "profile-statistics", "show", "swig"};
+            for (const MainOption& opt : options) {
+                if (opt.longName.empty() || contains(replaced, opt.longName) ||
+                        Global::config().state(opt.longName) != MainConfig::State::set) {
+                    continue;
+                }
+                for (const auto& value : Global::config().getMany(opt.longName)) {
+                    planSearchArguments.push_back(
+                            "--" + opt.longName + (opt.argument.empty() ? "" : "=" + value));
+                }
+            }
+            planSearchArguments.push_back(Global::config().get(""));
+        }
+
         // ------ command line arguments -------------
 
         // Take in pragma options from the command line
@@ -327,6 +441,10 @@ int main(int argc, char** argv) {
             // set jobs to zero to indicate the synthesiser and interpreter to use the system default.
             Global::config().set("jobs", "0");
         }
+        // the front end checks and analyses clauses with as many threads as the evaluation
+        if (!Global::config().has("jobs", "0")) {
+            omp_set_num_threads(std::stoi(Global::config().get("jobs")));
+        }
 #else
         // Check that -j option has not been changed from the default
         if (Global::config().get("jobs") != "1" && !Global::config().has("no-warn")) {
@@ -368,6 +486,21 @@ int main(int argc, char** argv) {
         if (Global::config().has("live-profile") && !Global::config().has("profile")) {
             Global::config().set("profile");
         }
+
+        if (Global::config().has("plan-search")) {
+            if (!Global::config().has("profile-use") || !Global::config().has("plan-file")) {
+                throw std::runtime_error("--plan-search requires --profile-use and --plan-file.");
+            }
+            if (!isNumber(Global::config().get("plan-search").c_str()) ||
+                    std::stoi(Global::config().get("plan-search")) < 1) {
+                throw std::runtime_error("--plan-search may only be set to an integer greater than 0.");
+            }
+            if (Global::config().has("provenance")) {
+                throw std::runtime_error("--plan-search cannot be combined with provenance.");
+            }
+        }
+
+        checkIncrementalOptions();
     } catch (std::exception& e) {
         std::cerr << e.what() << std::endl;
         exit(EXIT_FAILURE);
@@ -447,10 +580,22 @@ int main(int argc, char** argv) {
     // ------- check for parse errors -------------
     astTranslationUnit->getErrorReport().exitIfErrors();
 
+    // Profile the transformers, which stops after the RAM transformations
+    TransformerProfile transformerProfile;
+    if (hasShowOpt("transformer-profile")) {
+        astTranslationUnit->setTransformerProfile(&transformerProfile);
+    }
+
     // ------- rewriting / optimizations -------------
 
     /* set up additional global options based on pragma declaratives */
     (mk<ast::transform::PragmaChecker>())->apply(*astTranslationUnit);
+    try {
+        checkIncrementalOptions();
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        exit(EXIT_FAILURE);
+    }
 
     if (hasShowOpt("initial-ast", "initial-datalog")) {
         std::cout << astTranslationUnit->getProgram() << std::endl;
@@ -516,9 +661,11 @@ int main(int argc, char** argv) {
             mk<ast::transform::FixpointTransformer>(mk<ast::transform::PipelineTransformer>(
                     mk<ast::transform::ReduceExistentialsTransformer>(),
                     mk<ast::transform::RemoveRedundantRelationsTransformer>())),
+            mk<ast::transform::RemoveUnusedColumnsTransformer>(),
             mk<ast::transform::RemoveRelationCopiesTransformer>(), std::move(partitionPipeline),
             std::move(equivalencePipeline), mk<ast::transform::RemoveRelationCopiesTransformer>(),
-            std::move(magicPipeline), mk<ast::transform::ReorderLiteralsTransformer>(),
+            std::move(magicPipeline), mk<ast::transform::ExecutionPlanFileTransformer>(),
+            mk<ast::transform::ReorderLiteralsTransformer>(),
             mk<ast::transform::RemoveEmptyRelationsTransformer>(),
             mk<ast::transform::AddNullariesToAtomlessAggregatesTransformer>(),
             mk<ast::transform::ReorderLiteralsTransformer>(), mk<ast::transform::ExecutionPlanChecker>(),
@@ -532,6 +679,11 @@ int main(int argc, char** argv) {
                 std::set<std::string>(givenTransformers.begin(), givenTransformers.end()));
     }
 
+    // The plans of a plan file are given for clauses whose literals have not been reordered yet
+    if (Global::config().has("plan-search")) {
+        pipeline->disableTransformers({"ReorderLiteralsTransformer"});
+    }
+
     // Set up the debug report if necessary
     if (Global::config().has("debug-report")) {
         auto parser_end = std::chrono::high_resolution_clock::now();
@@ -601,7 +753,16 @@ int main(int argc, char** argv) {
     }
 
     // bail if we've nothing else left to show
-    if (Global::config().has("show") && !hasShowOpt("initial-ram", "transformed-ram")) return 0;
+    if (Global::config().has("show") &&
+            !hasShowOpt("initial-ram", "transformed-ram", "transformer-profile")) {
+        return 0;
+    }
+
+    // Search the plans of the most expensive clauses instead of evaluating the program
+    if (Global::config().has("plan-search")) {
+        ast::transform::searchExecutionPlans(*astTranslationUnit, souffleExecutable, planSearchArguments);
+        return 0;
+    }
 
     // ------- execution -------------
     /* translate AST to RAM */
@@ -613,11 +774,14 @@ int main(int argc, char** argv) {
     auto unitTranslator = Own<ast2ram::UnitTranslator>(translationStrategy->createUnitTranslator());
     auto ramTranslationUnit = unitTranslator->translateUnit(*astTranslationUnit);
     debugReport.endSection("ast-to-ram", "Translate AST to RAM");
+    if (hasShowOpt("transformer-profile")) {
+        ramTranslationUnit->setTransformerProfile(&transformerProfile);
+    }
 
     if (hasShowOpt("initial-ram")) {
         std::cout << ramTranslationUnit->getProgram();
         // bail if we've nothing else left to show
-        if (!hasShowOpt("transformed-ram")) return 0;
+        if (!hasShowOpt("transformed-ram", "transformer-profile")) return 0;
     }
 
     // Apply RAM transforms
@@ -649,6 +813,20 @@ int main(int argc, char** argv) {
     // Output the transformed RAM program and return
     if (hasShowOpt("transformed-ram")) {
         std::cout << ramTranslationUnit->getProgram();
+    }
+
+    // Output the profile of the transformers, with the analyses of both stages, and return
+    if (hasShowOpt("transformer-profile")) {
+        for (const auto& [name, computations] : astTranslationUnit->getAnalysisStatistics().byAnalysis) {
+            transformerProfile.addAnalysis("AST", name, computations.count, computations.time);
+        }
+        for (const auto& [name, computations] : ramTranslationUnit->getAnalysisStatistics().byAnalysis) {
+            transformerProfile.addAnalysis("RAM", name, computations.count, computations.time);
+        }
+        transformerProfile.print(std::cout);
+    }
+
+    if (hasShowOpt("transformed-ram", "transformer-profile")) {
         return 0;
     }
 
@@ -717,11 +895,31 @@ int main(int argc, char** argv) {
             std::string sourceFilename = baseFilename + ".cpp";
 
             bool withSharedLibrary;
+            // further translation units of a split program, besides the source file
+            std::vector<std::string> unitFilenames;
             auto synthesisStart = std::chrono::high_resolution_clock::now();
             const bool emitToStdOut = Global::config().has("generate", "-");
             if (emitToStdOut)
                 synthesiser->generateCode(std::cout, baseIdentifier, withSharedLibrary);
-            else {
+            else if (Global::config().has("split-units") && !Global::config().has("swig")) {
+                const std::string& strataPerUnit = Global::config().get("split-units");
+                if (!isNumber(strataPerUnit.c_str()) || std::stoi(strataPerUnit) < 1) {
+                    throw std::runtime_error("--split-units may only be set to an integer greater than 0.");
+                }
+                synthesiser::SplitUnits split;
+                split.headerName = baseName(baseFilename) + ".h";
+                split.strataPerUnit = std::stoul(strataPerUnit);
+                synthesiser->generateCode(split, baseIdentifier, withSharedLibrary);
+                std::ofstream(baseFilename + ".h") << split.header;
+                for (std::size_t i = 0; i < split.units.size(); ++i) {
+                    std::string unitFilename = sourceFilename;
+                    if (i > 0) {
+                        unitFilename = tfm::format("%s_%d.cpp", baseFilename, i);
+                        unitFilenames.push_back(unitFilename);
+                    }
+                    std::ofstream(unitFilename) << split.units[i];
+                }
+            } else {
                 std::ofstream os{sourceFilename};
                 synthesiser->generateCode(os, baseIdentifier, withSharedLibrary);
             }
@@ -747,7 +945,7 @@ int main(int argc, char** argv) {
                     throw std::runtime_error("failed to locate souffle-compile");
 
                 auto t_bgn = std::chrono::high_resolution_clock::now();
-                compileToBinary(souffle_compile, sourceFilename);
+                compileToBinary(souffle_compile, sourceFilename, unitFilenames);
                 auto t_end = std::chrono::high_resolution_clock::now();
 
                 if (Global::config().has("verbose")) {
@@ -758,7 +956,7 @@ int main(int argc, char** argv) {
 
             // run compiled C++ program if requested.
             if (must_execute) {
-                executeBinaryAndExit(baseFilename);
+                executeBinaryAndExit(baseFilename, unitFilenames);
             }
         }
     } catch (std::exception& e) {
@@ -42,6 +42,9 @@ public:
         while (loop->apply(tU)) {
             ctr++;
         }
+        if (auto* profile = tU.getTransformerProfile()) {
+            profile->setIterations(ctr + 1);
+        }
         return ctr > 0;
     }
 
@@ -20,21 +20,38 @@
 #include "ram/Program.h"
 #include "ram/TranslationUnit.h"
 #include "ram/transform/Meta.h"
+#include "ram/utility/Visitor.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
 #include "souffle/utility/StringUtil.h"
 #include <chrono>
+#include <cstddef>
 #include <cstdlib>
 #include <iostream>
 #include <type_traits>
 
 namespace souffle::ram::transform {
 
+namespace {
+
+std::size_t countNodes(const TranslationUnit& translationUnit) {
+    std::size_t nodes = 0;
+    visit(translationUnit.getProgram(), [&](const Node&) { ++nodes; });
+    return nodes;
+}
+
+}  // namespace
+
 bool Transformer::apply(TranslationUnit& translationUnit) {
     const bool debug = Global::config().has("debug-report");
     const bool verbose = Global::config().has("verbose");
     std::string ramProgStrOld = debug ? toString(translationUnit.getProgram()) : "";
 
+    TransformerProfile* profile = translationUnit.getTransformerProfile();
+    if (profile != nullptr) {
+        profile->beginTransformer("RAM", getName(), isA<MetaTransformer>(this), countNodes(translationUnit));
+    }
+
     // invoke the transformation
     auto start = std::chrono::high_resolution_clock::now();
     bool changed = transform(translationUnit);
@@ -45,6 +62,10 @@ bool Transformer::apply(TranslationUnit& translationUnit) {
         translationUnit.invalidateAnalyses();
     }
 
+    if (profile != nullptr) {
+        profile->endTransformer(changed, end - start, countNodes(translationUnit));
+    }
+
     // print runtime & change info for transformer in verbose mode
     if (verbose && (!isA<MetaTransformer>(this))) {
         std::string changedString = changed ? "changed" : "unchanged";
@@ -181,6 +181,15 @@ public:
         diagnostics.insert(diagnostic);
     }
 
+    /** Adds the diagnostics of another report, such as one collected by a parallel check */
+    void addDiagnostics(const ErrorReport& other) {
+        for (const Diagnostic& diagnostic : other.diagnostics) {
+            if (!nowarn || diagnostic.getType() == Diagnostic::Type::ERROR) {
+                diagnostics.insert(diagnostic);
+            }
+        }
+    }
+
     void exitIfErrors() {
         if (getNumErrors() == 0) {
             return;
@@ -0,0 +1,169 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file reports/TransformerProfile.h
+ *
+ * Defines a class recording the compile-time cost of transformers and
+ * analyses.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Profile of the transformers applied to a program and of the analyses they
+ * request, reported by `--show=transformer-profile`.
+ *
+ * Each application of a transformer is recorded in pipeline order, nested in
+ * the application of its enclosing meta-transformer, together with the size of
+ * the program before and after.  The analyses are taken from the statistics of
+ * the translation units of each stage once all transformers were applied.
+ */
+class TransformerProfile {
+public:
+    using duration = std::chrono::duration<double>;
+
+    struct Application {
+        std::string stage;
+        std::string name;
+        std::size_t depth;
+        /** Whether the transformer only applies other transformers */
+        bool meta;
+        bool changed = false;
+        /** Number of iterations of the sub-transformer, if the transformer computes a fixpoint */
+        std::size_t iterations = 0;
+        duration time{0};
+        std::size_t nodesBefore;
+        std::size_t nodesAfter = 0;
+    };
+
+    struct AnalysisStatistics {
+        std::size_t computations = 0;
+        duration time{0};
+    };
+
+    /** Start the application of a transformer to a program of the given number of nodes */
+    void beginTransformer(std::string stage, std::string name, bool meta, std::size_t nodes) {
+        open.push_back(applications.size());
+        applications.push_back({std::move(stage), std::move(name), open.size() - 1, meta, false, 0,
+                duration{0}, nodes, 0});
+    }
+
+    /** Finish the application of the innermost transformer */
+    void endTransformer(bool changed, duration time, std::size_t nodes) {
+        assert(!open.empty() && "no transformer is being applied");
+        auto& application = applications[open.back()];
+        application.changed = changed;
+        application.time = time;
+        application.nodesAfter = nodes;
+        open.pop_back();
+    }
+
+    /** Record the iterations of the innermost transformer computing a fixpoint */
+    void setIterations(std::size_t iterations) {
+        if (!open.empty()) {
+            applications[open.back()].iterations = iterations;
+        }
+    }
+
+    /** Record the computations of an analysis, as counted by the statistics of the translation unit */
+    void addAnalysis(
+            const std::string& stage, const std::string& name, std::size_t computations, duration time) {
+        analyses[{stage, name}] = {computations, time};
+    }
+
+    const std::vector<Application>& getApplications() const {
+        return applications;
+    }
+
+    const std::map<std::pair<std::string, std::string>, AnalysisStatistics>& getAnalyses() const {
+        return analyses;
+    }
+
+    void print(std::ostream& os) const {
+        const auto flags = os.flags();
+        const auto precision = os.precision();
+
+        // total time of each transformer, excluding meta-transformers whose time is that of their children
+        std::map<std::pair<std::string, std::string>, std::pair<std::size_t, duration>> totals;
+        for (const auto& application : applications) {
+            if (!application.meta) {
+                auto& [count, time] = totals[{application.stage, application.name}];
+                ++count;
+                time += application.time;
+            }
+        }
+        std::vector<std::pair<std::pair<std::string, std::string>, std::pair<std::size_t, duration>>>
+                byTime(totals.begin(), totals.end());
+        std::stable_sort(byTime.begin(), byTime.end(),
+                [](const auto& a, const auto& b) { return a.second.second > b.second.second; });
+
+        os << "Transformers by total time:\n";
+        os << std::setw(12) << "time (s)" << std::setw(14) << "applications"
+           << "  stage  transformer\n";
+        for (const auto& [key, total] : byTime) {
+            os << std::setw(12) << std::fixed << std::setprecision(6) << total.second.count()
+               << std::setw(14) << total.first << "  " << std::left << std::setw(5) << key.first
+               << std::right << "  " << key.second << "\n";
+        }
+
+        os << "\nTransformer applications:\n";
+        os << std::setw(12) << "time (s)" << std::setw(10) << "changed" << std::setw(14) << "nodes before"
+           << std::setw(13) << "nodes after"
+           << "  stage  transformer\n";
+        for (const auto& application : applications) {
+            os << std::setw(12) << std::fixed << std::setprecision(6) << application.time.count()
+               << std::setw(10) << (application.changed ? "yes" : "no") << std::setw(14)
+               << application.nodesBefore << std::setw(13) << application.nodesAfter << "  " << std::left
+               << std::setw(5) << application.stage << std::right << "  "
+               << std::string(2 * application.depth, ' ') << application.name;
+            if (application.iterations != 0) {
+                os << " (" << application.iterations << " iterations)";
+            }
+            os << "\n";
+        }
+
+        os << "\nAnalyses:\n";
+        os << std::setw(12) << "time (s)" << std::setw(14) << "computations"
+           << "  stage  analysis\n";
+        for (const auto& [key, statistics] : analyses) {
+            os << std::setw(12) << std::fixed << std::setprecision(6) << statistics.time.count()
+               << std::setw(14) << statistics.computations << "  " << std::left << std::setw(5) << key.first
+               << std::right << "  " << key.second << "\n";
+        }
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+private:
+    /** Applications in the order they were started */
+    std::vector<Application> applications;
+
+    /** Indices of the applications that have not finished yet, innermost last */
+    std::vector<std::size_t> open;
+
+    /** Analyses by stage and name */
+    std::map<std::pair<std::string, std::string>, AnalysisStatistics> analyses;
+};
+
+}  // namespace souffle
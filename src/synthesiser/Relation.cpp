@@ -7,6 +7,7 @@
  */
 
 #include "synthesiser/Relation.h"
+#include "Global.h"
 #include "RelationTag.h"
 #include "ram/analysis/Index.h"
 #include "souffle/SouffleInterface.h"
@@ -294,7 +295,14 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
         };
 
         std::string comparator = "t_comparator_" + std::to_string(i);
-        genstruct(comparator, ind.size());
+        // orders on signed columns share their type with other programs, see souffle/PrebuiltRelations.h
+        const bool isSignedOrder = std::all_of(ind.begin(), ind.end(),
+                [&](std::size_t attrib) { return typecasts[attrib] == "ramBitCast<RamSigned>"; });
+        if (!isProvenance && isSignedOrder) {
+            out << "using " << comparator << " = SignedLexOrder<" << join(ind, ",") << ">;\n";
+        } else {
+            genstruct(comparator, ind.size());
+        }
 
         // for provenance, all indices must be full so we use btree_set
         // also strong/weak comparators and updater methods
@@ -483,6 +491,20 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
         out << "context h;\n";
         out << "return lowerUpperRange_" << search << "(lower,upper,h);\n";
         out << "}\n";
+
+        // batched lookup of several ranges, for the loops prefetching their nested index scans
+        if (Global::config().has("prefetch-joins") && !isProvenance && !hasErase) {
+            out << "void lowerUpperRanges_" << search;
+            out << "(const t_tuple* lower, const t_tuple* upper, std::size_t n, t_ind_" << indNum
+                << "::iterator* begin, t_ind_" << indNum << "::iterator* end) const {\n";
+            out << "ind_" << indNum << ".lower_bounds(lower, n, begin);\n";
+            out << "ind_" << indNum << ".upper_bounds(upper, n, end);\n";
+            out << "t_comparator_" << indNum << " comparator;\n";
+            out << "for (std::size_t i = 0; i < n; ++i) {\n";
+            out << "if (comparator(lower[i], upper[i]) > 0) end[i] = begin[i];\n";
+            out << "}\n";
+            out << "}\n";
+        }
     }
 
     // empty method
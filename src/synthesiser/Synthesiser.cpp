@@ -91,6 +91,7 @@
 #include "souffle/TypeAttribute.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
+#include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
@@ -105,6 +106,8 @@
 #include <iterator>
 #include <limits>
 #include <map>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <tuple>
 #include <type_traits>
@@ -119,6 +122,21 @@ using ram::analysis::IndexAnalysis;
 using namespace ram;
 using namespace stream_write_qualified_char_as_number;
 
+namespace {
+
+/** Return the index of the stratum evaluated by the given subroutine, if it is one (`stratum_<i>`) */
+std::optional<std::size_t> getStratumIndex(const std::string& subroutine) {
+    const std::string prefix = "stratum_";
+    const std::string suffix = subroutine.substr(std::min(prefix.size(), subroutine.size()));
+    if (subroutine.compare(0, prefix.size(), prefix) != 0 || suffix.empty() ||
+            !std::all_of(suffix.begin(), suffix.end(), [](char c) { return std::isdigit(c) != 0; })) {
+        return std::nullopt;
+    }
+    return std::stoul(suffix);
+}
+
+}  // namespace
+
 /** Lookup frequency counter */
 unsigned Synthesiser::lookupFreqIdx(const std::string& txt) {
     static unsigned ctr;
@@ -221,6 +239,19 @@ std::set<const ram::Relation*> Synthesiser::getReferencedRelations(const Operati
     return res;
 }
 
+/** Get written relations */
+std::set<const ram::Relation*> Synthesiser::getWrittenRelations(const Operation& op) {
+    std::set<const ram::Relation*> res;
+    visit(op, [&](const Node& node) {
+        if (auto insert = as<Insert>(node)) {
+            res.insert(lookup(insert->getRelation()));
+        } else if (auto erase = as<Erase>(node)) {
+            res.insert(lookup(erase->getRelation()));
+        }
+    });
+    return res;
+}
+
 void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
     class CodeEmitter : public ram::Visitor<void, Node const, std::ostream&> {
         using ram::Visitor<void, Node const, std::ostream&>::visit_;
@@ -249,6 +280,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         std::ostringstream preamble;
         bool preambleIssued = false;
 
+        // the ranges of the index scans looked up in a batch by an enclosing loop
+        std::map<const IndexScan*, std::string> batchedRanges;
+
     public:
         CodeEmitter(Synthesiser& syn) : synthesiser(syn) {
             rec = [&](auto& out, const auto* value) {
@@ -324,6 +358,115 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             return std::make_pair(std::move(low), std::move(high));
         }
 
+        /**
+         * Returns the index scan nested in the given loop, possibly below filters, whose
+         * range lookups can be batched over the tuples of the loop, or null if there is none.
+         *
+         * The lookups of a batch are made before the loop body runs for any of its tuples,
+         * hence the bounds of the range must not have side effects or depend on variables
+         * bound inside the loop body.
+         */
+        const IndexScan* getBatchedLookup(const TupleOperation& outer) const {
+            if (!Global::config().has("prefetch-joins") || Global::config().has("provenance")) {
+                return nullptr;
+            }
+
+            const Operation* nested = &outer.getOperation();
+            while (const auto* filter = as<Filter>(nested)) {
+                nested = &filter->getOperation();
+            }
+            const auto* iscan = as<IndexScan>(nested);
+            if (iscan == nullptr || isA<ParallelIndexScan>(iscan)) {
+                return nullptr;
+            }
+
+            // only btree relations support batched lookups
+            const auto* rel = synthesiser.lookup(iscan->getRelation());
+            const auto representation = rel->getRepresentation();
+            if (rel->isNullary() || !(representation == RelationRepresentation::BTREE ||
+                                             (representation == RelationRepresentation::DEFAULT &&
+                                                     rel->getArity() <= 6))) {
+                return nullptr;
+            }
+
+            auto isPureBound = [&](const Expression* bound) {
+                if (const auto* element = as<TupleElement>(bound)) {
+                    return element->getTupleId() <= outer.getTupleId();
+                }
+                return isUndefValue(bound) || isA<NumericConstant>(bound);
+            };
+            const auto& [lower, upper] = iscan->getRangePattern();
+            if (!all_of(lower, isPureBound) || !all_of(upper, isPureBound)) {
+                return nullptr;
+            }
+            return iscan;
+        }
+
+        /**
+         * Emits the loop binding the tuples of the given source to the tuple of the given
+         * operation.  If the range lookups of a nested index scan can be batched, the loop
+         * collects batches of tuples, looks up the ranges of a batch together, which lets
+         * their cache misses overlap, and then runs the loop body for each tuple of the batch.
+         */
+        void emitTupleLoop(const TupleOperation& op, const std::string& source, std::ostream& out) {
+            const auto id = std::to_string(op.getTupleId());
+            const auto* iscan = getBatchedLookup(op);
+            if (iscan == nullptr) {
+                out << "for(const auto& env" << id << " : " << source << ") {\n";
+                visit_(type_identity<TupleOperation>(), op, out);
+                out << "}\n";
+                return;
+            }
+
+            const auto* rel = synthesiser.lookup(iscan->getRelation());
+            const auto relName = synthesiser.getRelationName(rel);
+            const auto keys = isa->getSearchSignature(iscan);
+            const auto& [rangePatternLower, rangePatternUpper] = iscan->getRangePattern();
+            const auto rangeBounds = getPaddedRangeBounds(*rel, rangePatternLower, rangePatternUpper);
+            const auto tupleType = "Tuple<RamDomain," + std::to_string(rel->getArity()) + ">";
+            const std::size_t batchSize = 16;
+
+            out << "{\n";
+            out << "auto&& batch_source" << id << " = " << source << ";\n";
+            out << "using t_batch_env" << id << " = std::decay_t<decltype(*batch_source" << id
+                << ".begin())>;\n";
+            out << "t_batch_env" << id << " batch_env" << id << "[" << batchSize << "];\n";
+            out << tupleType << " batch_lower" << id << "[" << batchSize << "];\n";
+            out << tupleType << " batch_upper" << id << "[" << batchSize << "];\n";
+            out << "using t_batch_iter" << id << " = std::decay_t<decltype(" << relName
+                << "->lowerUpperRange_" << keys << "(batch_lower" << id << "[0], batch_upper" << id
+                << "[0]).begin())>;\n";
+            out << "t_batch_iter" << id << " batch_begin" << id << "[" << batchSize << "];\n";
+            out << "t_batch_iter" << id << " batch_end" << id << "[" << batchSize << "];\n";
+            out << "for(auto batch_it" << id << " = batch_source" << id << ".begin(), batch_fin" << id
+                << " = batch_source" << id << ".end(); batch_it" << id << " != batch_fin" << id << ";) {\n";
+
+            // collect a batch of tuples and the bounds of their ranges
+            out << "std::size_t batch_size" << id << " = 0;\n";
+            out << "for(; batch_it" << id << " != batch_fin" << id << " && batch_size" << id << " < "
+                << batchSize << "; ++batch_it" << id << ", ++batch_size" << id << ") {\n";
+            out << "const auto& env" << id << " = *batch_it" << id << ";\n";
+            out << "batch_env" << id << "[batch_size" << id << "] = env" << id << ";\n";
+            out << "batch_lower" << id << "[batch_size" << id << "] = " << rangeBounds.first.str() << ";\n";
+            out << "batch_upper" << id << "[batch_size" << id << "] = " << rangeBounds.second.str() << ";\n";
+            out << "}\n";
+
+            out << relName << "->lowerUpperRanges_" << keys << "(batch_lower" << id << ", batch_upper" << id
+                << ", batch_size" << id << ", batch_begin" << id << ", batch_end" << id << ");\n";
+
+            // run the loop body for each tuple of the batch
+            out << "for(std::size_t batch_i" << id << " = 0; batch_i" << id << " < batch_size" << id
+                << "; ++batch_i" << id << ") {\n";
+            out << "const auto& env" << id << " = batch_env" << id << "[batch_i" << id << "];\n";
+            batchedRanges[iscan] = "make_range(batch_begin" + id + "[batch_i" + id + "], batch_end" + id +
+                                   "[batch_i" + id + "])";
+            visit_(type_identity<TupleOperation>(), op, out);
+            batchedRanges.erase(iscan);
+            out << "}\n";
+            out << "}\n";
+            out << "}\n";
+        }
+
         // -- relation statements --
 
         void visit_(type_identity<IO>, const IO& io, std::ostream& out) override {
@@ -356,6 +499,8 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 out << R"_(if (!inputDirectory.empty()) {)_";
                 out << R"_(directiveMap["fact-dir"] = inputDirectory;)_";
                 out << "}\n";
+                out << "unshareRelation("
+                    << synthesiser.getRelationName(synthesiser.lookup(io.getRelation())) << ");\n";
                 out << "IOSystem::getInstance().getReader(";
                 out << "directiveMap, symTable, recordTable";
                 out << ")->readAll(*" << synthesiser.getRelationName(synthesiser.lookup(io.getRelation()));
@@ -364,6 +509,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     << " data: \" << e.what() "
                        "<< "
                        "'\\n';}\n";
+                if (Global::config().has("order-symbols")) {
+                    out << "symTable.invalidateOrder();\n";
+                }
             } else if (op == "output" || op == "printsize") {
                 out << "try {";
                 out << "std::map<std::string, std::string> directiveMap(";
@@ -372,10 +520,15 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 out << R"_(if (!outputDirectory.empty()) {)_";
                 out << R"_(directiveMap["output-dir"] = outputDirectory;)_";
                 out << "}\n";
-                out << "IOSystem::getInstance().getWriter(";
-                out << "directiveMap, symTable, recordTable";
-                out << ")->writeAll(*" << synthesiser.getRelationName(synthesiser.lookup(io.getRelation()))
-                    << ");\n";
+                const auto* rel = synthesiser.lookup(io.getRelation());
+                if (Global::config().has("async-output")) {
+                    out << "asyncWriters.writeAll(directiveMap, symTable, recordTable, *"
+                        << synthesiser.getRelationName(rel) << ", " << rel->getArity() << ");\n";
+                } else {
+                    out << "IOSystem::getInstance().getWriter(";
+                    out << "directiveMap, symTable, recordTable";
+                    out << ")->writeAll(*" << synthesiser.getRelationName(rel) << ");\n";
+                }
                 out << "} catch (std::exception& e) {std::cerr << e.what();exit(1);}\n";
             } else {
                 assert("Wrong i/o operation");
@@ -421,6 +574,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             // enclose operation in its own scope
             out << "{\n";
 
+            // copy the written relations shared with forks before their contexts are created
+            for (const ram::Relation* rel : synthesiser.getWrittenRelations(query.getOperation())) {
+                out << "unshareRelation(" << synthesiser.getRelationName(*rel) << ");\n";
+            }
+
             // check whether loop nest can be parallelized
             bool isParallel = visitExists(
                     *next, [&](const Node& n) { return as<AbstractParallel, AllowCrossCast>(n); });
@@ -481,8 +639,8 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             if (!synthesiser.lookup(clear.getRelation())->isTemp()) {
                 out << "if (pruneImdtRels) ";
             }
-            out << synthesiser.getRelationName(synthesiser.lookup(clear.getRelation())) << "->"
-                << "purge();\n";
+            out << "purgeRelation(" << synthesiser.getRelationName(synthesiser.lookup(clear.getRelation()))
+                << ");\n";
 
             PRINT_END_COMMENT(out);
         }
@@ -545,6 +703,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << "for(;;) {\n";
             dispatch(loop.getBody(), out);
             out << "iter++;\n";
+            out << "progress.nextIteration();\n";
             out << "}\n";
             out << "iter = 0;\n";
             PRINT_END_COMMENT(out);
@@ -563,6 +722,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
         void visit_(type_identity<MergeExtend>, const MergeExtend& extend, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
+            // both relations are extended by the other
+            out << "unshareRelation("
+                << synthesiser.getRelationName(synthesiser.lookup(extend.getSourceRelation())) << ");\n";
+            out << "unshareRelation("
+                << synthesiser.getRelationName(synthesiser.lookup(extend.getTargetRelation())) << ");\n";
             out << synthesiser.getRelationName(synthesiser.lookup(extend.getSourceRelation())) << "->"
                 << "extendAndInsert("
                 << "*" << synthesiser.getRelationName(synthesiser.lookup(extend.getTargetRelation()))
@@ -582,10 +746,39 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_BEGIN_COMMENT(out);
             const Program& prog = synthesiser.getTranslationUnit().getProgram();
             const auto& subs = prog.getSubroutines();
+            const auto stratum = getStratumIndex(call.getName());
+            if (stratum) {
+                out << "progress.beginStratum(" << *stratum << ");\n";
+            }
             out << "{\n";
             out << " std::vector<RamDomain> args, ret;\n";
             out << "subroutine_" << distance(subs.begin(), subs.find(call.getName())) << "(args, ret);\n";
             out << "}\n";
+            if (stratum) {
+                // take a snapshot of the sizes of the relations the stratum inserted into
+                const Statement& body = *subs.at(call.getName());
+                std::set<std::string> inserted;
+                visit(body, [&](const Insert& insert) { inserted.insert(insert.getRelation()); });
+                visit(body, [&](const MergeExtend& extend) { inserted.insert(extend.getTargetRelation()); });
+                visit(body, [&](const IO& io) {
+                    if (io.get("operation") == "input") {
+                        inserted.insert(io.getRelation());
+                    }
+                });
+                // relations are registered in the order of the program, see generateProgram
+                std::size_t relationId = 0;
+                for (const auto* rel : prog.getRelations()) {
+                    if (rel->isTemp()) {
+                        continue;
+                    }
+                    if (contains(inserted, rel->getName())) {
+                        out << "progress.setRelationSize(" << relationId << ", "
+                            << synthesiser.getRelationName(rel) << "->size());\n";
+                    }
+                    ++relationId;
+                }
+                out << "progress.endStratum();\n";
+            }
             PRINT_END_COMMENT(out);
         }
 
@@ -673,11 +866,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << preamble.str();
             out << "pfor(auto it = part.begin(); it<part.end();++it){\n";
             out << "try{\n";
-            out << "for(const auto& env0 : *it) {\n";
-
-            visit_(type_identity<TupleOperation>(), pscan, out);
-
-            out << "}\n";
+            emitTupleLoop(pscan, "*it", out);
             out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
             out << "}\n";
 
@@ -687,18 +876,12 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         void visit_(type_identity<Scan>, const Scan& scan, std::ostream& out) override {
             const auto* rel = synthesiser.lookup(scan.getRelation());
             auto relName = synthesiser.getRelationName(rel);
-            auto id = scan.getTupleId();
 
             PRINT_BEGIN_COMMENT(out);
 
             assert(rel->getArity() > 0 && "AstToRamTranslator failed/no scans for nullaries");
 
-            out << "for(const auto& env" << id << " : "
-                << "*" << relName << ") {\n";
-
-            visit_(type_identity<TupleOperation>(), scan, out);
-
-            out << "}\n";
+            emitTupleLoop(scan, "*" + relName, out);
 
             PRINT_END_COMMENT(out);
         }
@@ -769,7 +952,6 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         void visit_(type_identity<IndexScan>, const IndexScan& iscan, std::ostream& out) override {
             const auto* rel = synthesiser.lookup(iscan.getRelation());
             auto relName = synthesiser.getRelationName(rel);
-            auto identifier = iscan.getTupleId();
             auto keys = isa->getSearchSignature(&iscan);
 
             const auto& rangePatternLower = iscan.getRangePattern().first;
@@ -781,14 +963,15 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(*rel) + ")";
             auto rangeBounds = getPaddedRangeBounds(*rel, rangePatternLower, rangePatternUpper);
 
-            out << "auto range = " << relName << "->"
-                << "lowerUpperRange_" << keys << "(" << rangeBounds.first.str() << ","
-                << rangeBounds.second.str() << "," << ctxName << ");\n";
-            out << "for(const auto& env" << identifier << " : range) {\n";
-
-            visit_(type_identity<TupleOperation>(), iscan, out);
-
-            out << "}\n";
+            auto batched = batchedRanges.find(&iscan);
+            if (batched != batchedRanges.end()) {
+                out << "auto range = " << batched->second << ";\n";
+            } else {
+                out << "auto range = " << relName << "->"
+                    << "lowerUpperRange_" << keys << "(" << rangeBounds.first.str() << ","
+                    << rangeBounds.second.str() << "," << ctxName << ");\n";
+            }
+            emitTupleLoop(iscan, "range", out);
             PRINT_END_COMMENT(out);
         }
 
@@ -820,11 +1003,7 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << preamble.str();
             out << "pfor(auto it = part.begin(); it<part.end(); ++it) { \n";
             out << "try{\n";
-            out << "for(const auto& env0 : *it) {\n";
-
-            visit_(type_identity<TupleOperation>(), piscan, out);
-
-            out << "}\n";
+            emitTupleLoop(piscan, "*it", out);
             out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
             out << "}\n";
 
@@ -1736,12 +1915,20 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
     EVAL_CHILD(ty, getRHS);     \
     out << ")";                 \
     break
-#define COMPARE_STRING(op)                \
-    out << "(symTable.decode(";           \
-    EVAL_CHILD(RamDomain, getLHS);        \
-    out << ") " #op " symTable.decode(";  \
-    EVAL_CHILD(RamDomain, getRHS);        \
-    out << "))";                          \
+#define COMPARE_STRING(op)                       \
+    if (Global::config().has("order-symbols")) { \
+        out << "(symTable.compare(";             \
+        EVAL_CHILD(RamDomain, getLHS);           \
+        out << ", ";                             \
+        EVAL_CHILD(RamDomain, getRHS);           \
+        out << ") " #op " 0)";                   \
+        break;                                   \
+    }                                            \
+    out << "(symTable.decode(";                  \
+    EVAL_CHILD(RamDomain, getLHS);               \
+    out << ") " #op " symTable.decode(";         \
+    EVAL_CHILD(RamDomain, getRHS);               \
+    out << "))";                                 \
     break
 #define COMPARE_EQ_NE(opCode, op)                                         \
     case BinaryConstraintOp::   opCode: COMPARE_NUMERIC(RamDomain  , op); \
@@ -1960,16 +2147,25 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
         void visit_(
                 type_identity<IntrinsicOperator>, const IntrinsicOperator& op, std::ostream& out) override {
-#define MINMAX_SYMBOL(op)                   \
-    {                                       \
-        out << "symTable.encode(" #op "({"; \
-        for (auto& cur : args) {            \
-            out << "symTable.decode(";      \
-            dispatch(*cur, out);            \
-            out << "), ";                   \
-        }                                   \
-        out << "}))";                       \
-        break;                              \
+#define MINMAX_SYMBOL(op, ordered)                   \
+    {                                                \
+        if (Global::config().has("order-symbols")) { \
+            out << "symTable." #ordered "({";        \
+            for (auto& cur : args) {                 \
+                dispatch(*cur, out);                 \
+                out << ", ";                         \
+            }                                        \
+            out << "})";                             \
+            break;                                   \
+        }                                            \
+        out << "symTable.encode(" #op "({";          \
+        for (auto& cur : args) {                     \
+            out << "symTable.decode(";               \
+            dispatch(*cur, out);                     \
+            out << "), ";                            \
+        }                                            \
+        out << "}))";                                \
+        break;                                       \
     }
 
             PRINT_BEGIN_COMMENT(out);
@@ -2148,9 +2344,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 NARY_OP_ORDERED(MIN, std::min)
                     // clang-format on
 
-                case FunctorOp::SMAX: MINMAX_SYMBOL(std::max)
+                case FunctorOp::SMAX: MINMAX_SYMBOL(std::max, maximum)
 
-                case FunctorOp::SMIN: MINMAX_SYMBOL(std::min)
+                case FunctorOp::SMIN: MINMAX_SYMBOL(std::min, minimum)
 
                 // strings
                 case FunctorOp::CAT: {
@@ -2385,7 +2581,33 @@ private:
     std::shared_ptr<std::ostream> current_stream;
 };
 
-void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& withSharedLibrary) {
+namespace {
+
+/** Return the unit that defines the given subroutine when a program is split, see SplitUnits */
+std::size_t getSplitUnit(const std::string& subroutine, const SplitUnits& split) {
+    // all subroutines other than strata share the last unit
+    const auto stratum = getStratumIndex(subroutine);
+    if (!stratum) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    return *stratum / std::max<std::size_t>(split.strataPerUnit, 1);
+}
+
+}  // namespace
+
+void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& withSharedLibrary) {
+    generateProgram(os, id, withSharedLibrary, nullptr);
+}
+
+void Synthesiser::generateCode(SplitUnits& split, const std::string& id, bool& withSharedLibrary) {
+    std::stringstream header;
+    split.units.clear();
+    generateProgram(header, id, withSharedLibrary, &split);
+    split.header = header.str();
+}
+
+void Synthesiser::generateProgram(
+        std::ostream& sos, const std::string& id, bool& withSharedLibrary, SplitUnits* split) {
     // ---------------------------------------------------------------
     //                      Auto-Index Generation
     // ---------------------------------------------------------------
@@ -2403,6 +2625,9 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
 
     // generate C++ program
 
+    if (split != nullptr) {
+        os << "#pragma once\n";
+    }
     if (Global::config().has("verbose")) {
         os << "#define _SOUFFLE_STATS\n";
         os << "#include \"souffle/profile/ProfileEvent.h\"";
@@ -2413,6 +2638,10 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
         os << "#include \"souffle/provenance/Explain.h\"\n";
     }
 
+    if (Global::config().has("async-output")) {
+        os << "#include \"souffle/io/AsyncWriterPool.h\"\n";
+    }
+
     if (Global::config().has("live-profile")) {
         os << "#include <thread>\n";
         os << "#include \"souffle/profile/Tui.h\"\n";
@@ -2526,21 +2755,25 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
     os << "// -- initialize symbol table --\n";
 
     // issue symbol table with string constants
+    // the tables are held through shared pointers, as forks of the program share them
     visit(prog, [&](const StringConstant& sc) { convertSymbol2Idx(sc.getConstant()); });
-    os << "SymbolTable symTable";
+    os << "std::shared_ptr<SymbolTable> symTableStorage = std::make_shared<SymbolTable>(";
     if (!symbolMap.empty()) {
-        os << "{\n";
+        os << "std::initializer_list<std::string>{\n";
         for (const auto& x : symbolIndex) {
             os << "\tR\"_(" << x << ")_\",\n";
         }
         os << "}";
     }
-    os << ";";
+    os << ");\n";
+    os << "SymbolTable& symTable = *symTableStorage;\n";
 
-    // declare record table
+    // declare record table, whose type is only known once all code has been emitted
     os << "// -- initialize record table --\n";
 
     auto recordTable_os = os.delayed();
+    os << "std::shared_ptr<t_recordTable> recordTableStorage = std::make_shared<t_recordTable>();\n";
+    os << "t_recordTable& recordTable = *recordTableStorage;\n";
 
     if (Global::config().has("profile")) {
         os << "private:\n";
@@ -2565,10 +2798,22 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
         return initCons;
     };
 
+    // the constructor of forks shares the tables and relations of the forked instance; its initializers
+    // follow the order in which the members are declared above and below
+    std::stringstream forkCons;
+    auto forkConsSep = [&, empty = true]() mutable -> std::stringstream& {
+        forkCons << (empty ? "\n: " : "\n, ");
+        empty = false;
+        return forkCons;
+    };
+
     // `pf` must be a ctor param (see below)
     if (Global::config().has("profile")) {
         initConsSep() << "profiling_fname(std::move(pf))";
+        forkConsSep() << "profiling_fname(base->profiling_fname)";
     }
+    forkConsSep() << "symTableStorage(base->symTableStorage)";
+    forkConsSep() << "recordTableStorage(base->recordTableStorage)";
 
     int relCtr = 0;
     std::set<std::string> storeRelations;
@@ -2603,7 +2848,8 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
         // defining table
         os << "// -- Table: " << datalogName << "\n";
 
-        os << "Own<" << type << "> " << cppName << " = mk<" << type << ">();\n";
+        os << "std::shared_ptr<" << type << "> " << cppName << " = std::make_shared<" << type << ">();\n";
+        forkConsSep() << cppName << "(base->" << cppName << ")";
         if (!rel->isTemp()) {
             tfm::format(os, "souffle::RelationWrapper<%s> wrapper_%s;\n", type, cppName);
 
@@ -2616,9 +2862,11 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
 
             auto foundIn = [&](auto&& set) { return contains(set, rel->getName()) ? "true" : "false"; };
 
-            tfm::format(initConsSep(), "wrapper_%s(%s, *%s, *this, \"%s\", %s, %s, %s)", cppName, relCtr++,
+            auto wrapperCons = tfm::format("wrapper_%s(%s, %s, *this, \"%s\", %s, %s, %s)", cppName, relCtr++,
                     cppName, datalogName, strLitAry(rel->getAttributeTypes()),
                     strLitAry(rel->getAttributeNames()), rel->getAuxiliaryArity());
+            initConsSep() << wrapperCons;
+            forkConsSep() << wrapperCons;
             tfm::format(registerRel, "addRelation(\"%s\", wrapper_%s, %s, %s);\n", datalogName, cppName,
                     foundIn(loadRelations), foundIn(storeRelations));
         }
@@ -2636,6 +2884,19 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
     }
     os << registerRel.str();
     os << "}\n";
+
+    // -- constructor of forks --
+
+    os << "private:\n";
+    os << "explicit " << classname << "(const " << classname << "* base)";
+    os << forkCons.str() << '\n';
+    os << "{\n";
+    os << "numThreads = base->numThreads;\n";
+    os << "ctr = base->ctr.load();\n";
+    os << registerRel.str();
+    os << "}\n";
+    os << "public:\n";
+
     // -- destructor --
 
     os << "~" << classname << "() {\n";
@@ -2651,6 +2912,10 @@ private:
 std::string             inputDirectory;
 std::string             outputDirectory;
 SignalHandler*          signalHandler {SignalHandler::instance()};
+)_";
+    const auto numStrata = std::count_if(prog.getSubroutines().begin(), prog.getSubroutines().end(),
+            [](const auto& sub) { return getStratumIndex(sub.first).has_value(); });
+    os << R"_(
 std::atomic<RamDomain>  ctr {};
 std::atomic<std::size_t>     iter {};
 
@@ -2669,6 +2934,9 @@ void runFunction(std::string  inputDirectoryArg,
     if (0 < getNumThreads()) { omp_set_num_threads(getNumThreads()); }
 #endif
 
+    progress.beginEvaluation()_"
+       << numStrata << R"_();
+    signalHandler->setProgress(&progress);
     signalHandler->set();
 )_";
     if (Global::config().has("verbose")) {
@@ -2715,7 +2983,14 @@ void runFunction(std::string  inputDirectoryArg,
         }
     }
 
+    if (Global::config().has("async-output")) {
+        // report errors of the background writers before the program ends
+        os << "try {asyncWriters.wait();} catch (std::exception& e) {std::cerr << e.what();exit(1);}\n";
+    }
+
+    os << "progress.endEvaluation();\n";
     os << "signalHandler->reset();\n";
+    os << "signalHandler->setProgress(nullptr);\n";
 
     os << "}\n";  // end of runFunction() method
 
@@ -2839,60 +3114,80 @@ void runFunction(std::string  inputDirectoryArg,
     os << "return recordTable;\n";
     os << "}\n";  // end of getRecordTable() method
 
+    os << "Own<SouffleProgram> fork() override {\n";
+    os << "return Own<SouffleProgram>(new " << classname << "(this));\n";
+    os << "}\n";  // end of fork() method
+
     os << "void setNumThreads(std::size_t numThreadsValue) override {\n";
     os << "SouffleProgram::setNumThreads(numThreadsValue);\n";
     os << "symTable.setNumLanes(getNumThreads());\n";
     os << "recordTable.setNumLanes(getNumThreads());\n";
     os << "}\n";  // end of setNumThreads
 
+    // the definitions of subroutines when split, by unit
+    std::map<std::size_t, std::stringstream> splitUnits;
+
     if (!prog.getSubroutines().empty()) {
         // generate subroutine adapter
         os << "void executeSubroutine(std::string name, const std::vector<RamDomain>& args, "
               "std::vector<RamDomain>& ret) override {\n";
+        // resolve the name with a single lookup, as provenance programs have two subroutines per rule
+        os << "using Subroutine = void (" << classname
+           << "::*)(const std::vector<RamDomain>&, std::vector<RamDomain>&);\n";
+        os << "static const std::map<std::string, Subroutine> subroutines = {\n";
         // subroutine number
         std::size_t subroutineNum = 0;
         for (auto& sub : prog.getSubroutines()) {
-            os << "if (name == \"" << sub.first << "\") {\n"
-               << "subroutine_" << subroutineNum
-               << "(args, ret);\n"  // subroutine_<i> to deal with special characters in relation names
-               << "return;"
-               << "}\n";
+            // subroutine_<i> to deal with special characters in relation names
+            os << "{\"" << sub.first << "\", &" << classname << "::subroutine_" << subroutineNum << "},\n";
             subroutineNum++;
         }
+        os << "};\n";
+        os << "auto subroutine = subroutines.find(name);\n";
+        os << "if (subroutine == subroutines.end()) {\n";
         os << "fatal(\"unknown subroutine\");\n";
+        os << "}\n";
+        os << "(this->*subroutine->second)(args, ret);\n";
         os << "}\n";  // end of executeSubroutine
 
         // generate method for each subroutine
         subroutineNum = 0;
         for (auto& sub : prog.getSubroutines()) {
+            // when split, only declare the method here and define it in the unit of its stratum
+            std::ostream& out = (split == nullptr) ? static_cast<std::ostream&>(os)
+                                                   : splitUnits[getSplitUnit(sub.first, *split)];
+            if (split != nullptr) {
+                os << "void subroutine_" << subroutineNum
+                   << "(const std::vector<RamDomain>& args, std::vector<RamDomain>& ret);\n";
+            }
+
             // silence unused argument warnings on MSVC
-            os << "#ifdef _MSC_VER\n";
-            os << "#pragma warning(disable: 4100)\n";
-            os << "#endif // _MSC_VER\n";
+            out << "#ifdef _MSC_VER\n";
+            out << "#pragma warning(disable: 4100)\n";
+            out << "#endif // _MSC_VER\n";
 
             // issue method header
-            os << "void "
-               << "subroutine_" << subroutineNum
-               << "(const std::vector<RamDomain>& args, "
-                  "std::vector<RamDomain>& ret) {\n";
+            out << "void " << (split == nullptr ? "" : classname + "::") << "subroutine_" << subroutineNum
+                << "(const std::vector<RamDomain>& args, "
+                   "std::vector<RamDomain>& ret) {\n";
 
             // issue lock variable for return statements
             bool needLock = false;
             visit(*sub.second, [&](const SubroutineReturn&) { needLock = true; });
             if (needLock) {
-                os << "std::mutex lock;\n";
+                out << "std::mutex lock;\n";
             }
 
             // emit code for subroutine
-            emitCode(os, *sub.second);
+            emitCode(out, *sub.second);
 
             // issue end of subroutine
-            os << "}\n";
+            out << "}\n";
 
             // restore unused argument warning
-            os << "#ifdef _MSC_VER\n";
-            os << "#pragma warning(default: 4100)\n";
-            os << "#endif // _MSC_VER\n";
+            out << "#ifdef _MSC_VER\n";
+            out << "#pragma warning(default: 4100)\n";
+            out << "#endif // _MSC_VER\n";
             subroutineNum++;
         }
     }
@@ -2912,8 +3207,33 @@ void runFunction(std::string  inputDirectoryArg,
         }
         os << "}\n";  // end of dumpFreqs() method
     }
+    // all code has been emitted, hence the arities of records are known
+    *recordTable_os << "using t_recordTable = SpecializedRecordTable<0";
+    for (std::size_t arity : arities) {
+        if (arity > 0) {
+            *recordTable_os << "," << arity;
+        }
+    }
+    *recordTable_os << ">;\n";
+
+    // the background writers read the symbol and record tables, hence the pool is declared after them and
+    // destroyed, waiting for pending writes, before them
+    if (Global::config().has("async-output")) {
+        os << "private:\n";
+        os << "AsyncWriterPool asyncWriters;\n";
+    }
+
     os << "};\n";  // end of class declaration
 
+    // when split, the declarations so far form the header, and the rest forms the first unit
+    std::stringstream mainUnit;
+    if (split != nullptr) {
+        os << "}\n";  // end of namespace souffle
+        os.flushAll(sos);
+        os << "#include \"" << split->headerName << "\"\n";
+        os << "namespace souffle {\n";
+    }
+
     // hidden hooks
     os << "SouffleProgram *newInstance_" << id << "(){return new " << classname << ";}\n";
     os << "SymbolTable *getST_" << id << "(SouffleProgram *p){return &reinterpret_cast<" << classname
@@ -2988,15 +3308,21 @@ void runFunction(std::string  inputDirectoryArg,
     os << "}\n";
     os << "\n#endif\n";
 
-    *recordTable_os << "SpecializedRecordTable<0";
-    for (std::size_t arity : arities) {
-        if (arity > 0) {
-            *recordTable_os << "," << arity;
-        }
+    if (split == nullptr) {
+        os.flushAll(sos);
+        return;
     }
-    *recordTable_os << "> recordTable{};\n";
 
-    os.flushAll(sos);
+    os.flushAll(mainUnit);
+    split->units.push_back(mainUnit.str());
+    for (const auto& [index, body] : splitUnits) {
+        std::stringstream unit;
+        unit << "#include \"" << split->headerName << "\"\n";
+        unit << "namespace souffle {\n";
+        unit << body.str();
+        unit << "}\n";  // end of namespace souffle
+        split->units.push_back(unit.str());
+    }
 }
 
 }  // namespace souffle::synthesiser
@@ -30,9 +30,32 @@
 #include <ostream>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace souffle::synthesiser {
 
+/**
+ * The sources of a program synthesised as several translation units.
+ *
+ * The header declares the relation types and the program class; the first
+ * unit defines the entry points of the program, and every further unit
+ * defines the subroutines of a group of strata.  All units include the
+ * header under the given name.
+ */
+struct SplitUnits {
+    /** Name under which the units include the header */
+    std::string headerName;
+
+    /** Number of strata whose subroutines are placed into the same unit */
+    std::size_t strataPerUnit = 1;
+
+    /** Generated header */
+    std::string header;
+
+    /** Generated translation units */
+    std::vector<std::string> units;
+};
+
 /**
  * A RAM synthesiser: synthesises a C++ program from a RAM program.
  */
@@ -87,6 +110,12 @@ protected:
     /** Get referenced relations */
     std::set<const ram::Relation*> getReferencedRelations(const ram::Operation& op);
 
+    /** Get relations written by an operation */
+    std::set<const ram::Relation*> getWrittenRelations(const ram::Operation& op);
+
+    /** Generate the program; into the units of split if it is not null, and into os otherwise */
+    void generateProgram(std::ostream& os, const std::string& id, bool& withSharedLibrary, SplitUnits* split);
+
     /** Generate code */
     void emitCode(std::ostream& out, const ram::Statement& stmt);
 
@@ -132,5 +161,8 @@ public:
 
     /** Generate code */
     void generateCode(std::ostream& os, const std::string& id, bool& withSharedLibrary);
+
+    /** Generate code split into several translation units */
+    void generateCode(SplitUnits& split, const std::string& id, bool& withSharedLibrary);
 };
 }  // namespace souffle::synthesiser
@@ -0,0 +1,225 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file binary_io_test.cpp
+ *
+ * Tests the binary fact format and compares its load time with CSV.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/IOSystem.h"
+#include "souffle/utility/FileUtil.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace souffle::test {
+
+namespace {
+
+/** A relation of arity four which tolerates concurrent insertion */
+struct Relation {
+    std::mutex lock;
+    std::set<std::vector<RamDomain>> tuples;
+
+    void insert(const RamDomain* tuple) {
+        std::lock_guard<std::mutex> guard(lock);
+        tuples.insert({tuple, tuple + 4});
+    }
+
+    auto begin() const {
+        return tuples.begin();
+    }
+
+    auto end() const {
+        return tuples.end();
+    }
+
+    std::size_t size() const {
+        return tuples.size();
+    }
+};
+
+const std::string types = R"({
+    "relation": {"arity": 4, "types": ["s:symbol", "i:number", "r:List", "+:Tree"]},
+    "records": {"r:List": {"arity": 2, "types": ["i:number", "r:List"]}},
+    "ADTs": {"+:Tree": {"arity": 3, "enum": false, "branches": [
+        {"name": "Leaf", "types": []},
+        {"name": "Node", "types": ["+:Tree", "s:symbol", "+:Tree"]},
+        {"name": "Wrap", "types": ["r:List"]}]}}})";
+
+std::map<std::string, std::string> operation(const std::string& io, const std::string& fileName) {
+    return {{"IO", io}, {"filename", fileName}, {"name", "r"}, {"types", types}};
+}
+
+void load(Relation& relation, const std::string& io, const std::string& fileName, SymbolTable& symbolTable,
+        RecordTable& recordTable) {
+    IOSystem::getInstance().getReader(operation(io, fileName), symbolTable, recordTable)->readAll(relation);
+}
+
+void store(const Relation& relation, const std::string& io, const std::string& fileName,
+        const SymbolTable& symbolTable, const RecordTable& recordTable) {
+    IOSystem::getInstance().getWriter(operation(io, fileName), symbolTable, recordTable)->writeAll(relation);
+}
+
+/** Return the lines of a file in sorted order */
+std::vector<std::string> readLines(const std::string& fileName) {
+    std::ifstream file(fileName);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+}
+
+}  // namespace
+
+TEST(BinaryIO, RoundTrip) {
+    const std::string csv = tempFile();
+    const std::string bin = tempFile();
+    const std::string result = tempFile();
+
+    {
+        std::ofstream facts(csv);
+        facts << "a\t1\tnil\t$Leaf\n"
+              << "b c\t2\t[1, [2, nil]]\t$Node($Leaf, \"x y\", $Wrap([3, nil]))\n"
+              << "a\t-3\t[1, [2, nil]]\t$Wrap(nil)\n";
+    }
+
+    SymbolTable symbolTable;
+    SpecializedRecordTable<0, 2, 3> recordTable;
+    Relation relation;
+    load(relation, "file", csv, symbolTable, recordTable);
+    store(relation, "binary", bin, symbolTable, recordTable);
+
+    // load into tables whose contents differ, so that all references must be translated
+    SymbolTable otherSymbolTable;
+    otherSymbolTable.encode("b c");
+    SpecializedRecordTable<0, 2, 3> otherRecordTable;
+    otherRecordTable.pack({7, 7});
+    Relation other;
+    load(other, "binary", bin, otherSymbolTable, otherRecordTable);
+    EXPECT_EQ(relation.size(), other.size());
+
+    store(other, "file", result, otherSymbolTable, otherRecordTable);
+    const std::vector<std::string> expected = {"a\t-3\t[1, [2, nil]]\t$Wrap(nil)", "a\t1\tnil\t$Leaf",
+            "b c\t2\t[1, [2, nil]]\t$Node($Leaf, x y, $Wrap([3, nil]))"};
+    EXPECT_EQ(expected, readLines(result));
+
+    std::remove(csv.c_str());
+    std::remove(bin.c_str());
+    std::remove(result.c_str());
+}
+
+TEST(BinaryIO, Mismatch) {
+    const std::string bin = tempFile();
+    {
+        std::ofstream file(bin);
+        file << "a\t1\n";
+    }
+
+    SymbolTable symbolTable;
+    SpecializedRecordTable<0, 2, 3> recordTable;
+    Relation relation;
+    bool failed = false;
+    try {
+        load(relation, "binary", bin, symbolTable, recordTable);
+    } catch (std::exception&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    std::remove(bin.c_str());
+}
+
+TEST(BinaryIO, WriteFailure) {
+    SymbolTable symbolTable;
+    SpecializedRecordTable<0, 2, 3> recordTable;
+    Relation relation;
+    const RamDomain tuple[] = {symbolTable.encode("a"), 1, 0, 0};
+    relation.insert(tuple);
+
+    // the device accepts the file but no data
+    bool failed = false;
+    try {
+        store(relation, "binary", "/dev/full", symbolTable, recordTable);
+    } catch (std::exception&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
+
+TEST(Performance, BinaryLoad) {
+    const int N = 1 << 18;
+    const std::string csv = tempFile();
+    const std::string bin = tempFile();
+
+    SymbolTable symbolTable;
+    SpecializedRecordTable<0, 2, 3> recordTable;
+    Relation relation;
+    for (int i = 0; i < N; ++i) {
+        const RamDomain list[] = {i, 0};
+        const RamDomain leaf[] = {0, recordTable.pack(nullptr, 0)};
+        const RamDomain tuple[] = {symbolTable.encode("symbol" + std::to_string(i % 1000)), i,
+                recordTable.pack(list, 2), recordTable.pack(leaf, 2)};
+        relation.insert(tuple);
+    }
+    store(relation, "file", csv, symbolTable, recordTable);
+    store(relation, "binary", bin, symbolTable, recordTable);
+#ifdef USE_LIBZ
+    const std::string gzip = tempFile();
+    {
+        auto op = operation("file", gzip);
+        op["compress"] = "true";
+        IOSystem::getInstance().getWriter(op, symbolTable, recordTable)->writeAll(relation);
+    }
+#endif
+
+    const auto time = [&](const std::string& name, const std::string& io, const std::string& fileName) {
+        SymbolTable loadSymbolTable;
+        SpecializedRecordTable<0, 2, 3> loadRecordTable;
+        Relation loaded;
+        auto start = std::chrono::high_resolution_clock::now();
+        load(loaded, io, fileName, loadSymbolTable, loadRecordTable);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "\t" << std::setw(10) << std::setiosflags(std::ios::left) << name
+                  << std::resetiosflags(std::ios::left) << " load ... done [" << std::setw(5)
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << "ms]\n";
+        EXPECT_EQ(relation.size(), loaded.size());
+    };
+
+    time("csv", "file", csv);
+#ifdef USE_LIBZ
+    time("gzip-csv", "file", gzip);
+    std::remove(gzip.c_str());
+#endif
+    time("binary", "binary", bin);
+
+    std::remove(csv.c_str());
+    std::remove(bin.c_str());
+}
+
+}  // namespace souffle::test
@@ -458,6 +458,40 @@ TEST(BTreeSet, BoundaryEmpty) {
     EXPECT_NE(t.lower_bound(5), t.upper_bound(5));
 }
 
+TEST(BTreeSet, BatchedBounds) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    test_set t;
+    std::vector<int> keys(100);
+    std::vector<test_set::iterator> lower(keys.size());
+    std::vector<test_set::iterator> upper(keys.size());
+
+    for (int i = 0; i < 100; ++i) {
+        keys[i] = i - 10;
+    }
+
+    // all boundaries of an empty tree are the end
+    t.lower_bounds(keys.data(), keys.size(), lower.data());
+    t.upper_bounds(keys.data(), keys.size(), upper.data());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(t.end(), lower[i]);
+        EXPECT_EQ(t.end(), upper[i]);
+    }
+
+    // even numbers, some of them repeatedly, spanning several levels
+    for (int i = 0; i < 80; i += 2) {
+        t.insert(i);
+        t.insert(i % 6 == 0 ? i : 0);
+    }
+
+    t.lower_bounds(keys.data(), keys.size(), lower.data());
+    t.upper_bounds(keys.data(), keys.size(), upper.data());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(t.lower_bound(keys[i]), lower[i]);
+        EXPECT_EQ(t.upper_bound(keys[i]), upper[i]);
+    }
+}
+
 TEST(BTreeSet, Load) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
 
@@ -0,0 +1,122 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file csv_io_test.cpp
+ *
+ * Tests the parallel load of CSV facts with blocks small enough that every
+ * load is split into many blocks and chunks.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/ReadStreamCSV.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::test {
+
+namespace {
+
+/** A relation of arity two which tolerates concurrent insertion */
+struct Relation {
+    std::mutex lock;
+    std::set<std::pair<RamDomain, RamDomain>> tuples;
+
+    void insert(const RamDomain* tuple) {
+        std::lock_guard<std::mutex> guard(lock);
+        tuples.insert({tuple[0], tuple[1]});
+    }
+};
+
+/** A CSV reader whose blocks hold only a few lines, so that chunk boundaries fall between most lines */
+class SmallBlockCSV : public ReadStreamCSV {
+public:
+    SmallBlockCSV(std::istream& file, const std::map<std::string, std::string>& rwOperation,
+            SymbolTable& symbolTable, RecordTable& recordTable)
+            : ReadStreamCSV(file, rwOperation, symbolTable, recordTable) {
+        initialBlockSize = 7;
+        maxBlockSizePerThread = 8;
+    }
+};
+
+const std::map<std::string, std::string> rfc4180 = {{"IO", "file"}, {"name", "r"}, {"rfc4180", "true"},
+        {"types", R"({"relation": {"arity": 2, "types": ["s:symbol", "i:number"]}})"}};
+
+/** The facts of the line with the given number, whose quoted symbol contains escaped quotes and delimiters */
+std::string line(int number) {
+    return "\"s \"\"" + std::to_string(number) + "\"\", t\"," + std::to_string(number) +
+           (number % 3 == 0 ? "\r\n" : "\n");
+}
+
+/** Load the given input, and return the error if the load fails */
+std::string load(Relation& relation, const std::string& input, SymbolTable& symbolTable) {
+#ifdef _OPENMP
+    omp_set_num_threads(4);
+#endif
+    SpecializedRecordTable<0> recordTable;
+    std::istringstream file(input);
+    try {
+        SmallBlockCSV(file, rfc4180, symbolTable, recordTable).readAll(relation);
+    } catch (std::exception& e) {
+        return e.what();
+    }
+    return "";
+}
+
+}  // namespace
+
+TEST(CSVIO, ChunkedQuotedFields) {
+    std::string input;
+    for (int number = 1; number <= 200; ++number) {
+        input += line(number);
+    }
+
+    SymbolTable symbolTable;
+    Relation relation;
+    EXPECT_STREQ("", load(relation, input, symbolTable));
+    EXPECT_EQ(200u, relation.tuples.size());
+    for (const auto& [symbol, number] : relation.tuples) {
+        EXPECT_STREQ("s \"" + std::to_string(number) + "\", t", symbolTable.decode(symbol));
+    }
+}
+
+TEST(CSVIO, ChunkedErrors) {
+    // move the failing line across the block and chunk boundaries
+    for (int failing = 1; failing <= 40; ++failing) {
+        std::string input;
+        for (int number = 1; number <= 40; ++number) {
+            input += number == failing ? "\"s\",x\n" : line(number);
+        }
+
+        SymbolTable symbolTable;
+        Relation relation;
+        const std::string error = load(relation, input, symbolTable);
+        EXPECT_STREQ("Error converting <x> in column 2 in line " + std::to_string(failing) + "; ", error);
+
+        // only the lines before the failing line are loaded
+        EXPECT_EQ(static_cast<std::size_t>(failing - 1), relation.tuples.size());
+        for (const auto& tuple : relation.tuples) {
+            EXPECT_TRUE(tuple.second < failing);
+        }
+    }
+}
+
+}  // namespace souffle::test
@@ -0,0 +1,80 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file hyperloglog_test.cpp
+ *
+ * Tests the distinct-value sketches of the profiler.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/profile/HyperLogLog.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace souffle::profile::test {
+
+TEST(HyperLogLog, Empty) {
+    HyperLogLog sketch;
+    EXPECT_EQ(0, std::llround(sketch.estimate()));
+}
+
+TEST(HyperLogLog, Duplicates) {
+    HyperLogLog sketch;
+    for (int i = 0; i < 1000; ++i) {
+        sketch.insert(HyperLogLog::mix(i % 10));
+    }
+    EXPECT_EQ(10, std::llround(sketch.estimate()));
+}
+
+TEST(HyperLogLog, Accuracy) {
+    for (std::size_t n : {100, 10000, 1000000}) {
+        HyperLogLog sketch;
+        for (std::size_t i = 0; i < n; ++i) {
+            sketch.insert(HyperLogLog::mix(i));
+        }
+        // about five standard errors
+        EXPECT_LT(std::abs(sketch.estimate() - n), 0.08 * n);
+    }
+}
+
+TEST(HyperLogLog, Columns) {
+    // tuples (i, i % 100, 7) for 10000 values of i
+    HyperLogLog first;
+    HyperLogLog second;
+    HyperLogLog third;
+    HyperLogLog secondThird;
+    for (RamDomain i = 0; i < 10000; ++i) {
+        const RamDomain tuple[] = {i, i % 100, 7};
+        first.insert(tuple, {0});
+        second.insert(tuple, {1});
+        third.insert(tuple, {2});
+        secondThird.insert(tuple, {1, 2});
+    }
+    EXPECT_LT(std::abs(first.estimate() - 10000), 800);
+    EXPECT_LT(std::abs(second.estimate() - 100), 5);
+    EXPECT_EQ(1, std::llround(third.estimate()));
+    EXPECT_LT(std::abs(secondThird.estimate() - 100), 5);
+}
+
+TEST(HyperLogLog, Merge) {
+    HyperLogLog evens;
+    HyperLogLog odds;
+    for (std::size_t i = 0; i < 20000; ++i) {
+        (i % 2 == 0 ? evens : odds).insert(HyperLogLog::mix(i));
+    }
+    evens.merge(odds);
+    EXPECT_LT(std::abs(evens.estimate() - 20000), 1600);
+}
+
+}  // namespace souffle::profile::test
@@ -0,0 +1,83 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file prebuilt_relations_test.cpp
+ *
+ * Tests the index orders and instantiations shared by compiled programs.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/PrebuiltRelations.h"
+#include "souffle/RamTypes.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace souffle {
+
+// the instantiations of the souffle-relations library must be well-formed
+#define SOUFFLE_DEFINE_INDEX(kind, arity, ...) SOUFFLE_PREBUILT_INDEX(, kind, arity, __VA_ARGS__)
+SOUFFLE_FOR_EACH_PREBUILT_INDEX(SOUFFLE_DEFINE_INDEX)
+SOUFFLE_PREBUILT_STRUCTURES()
+#undef SOUFFLE_DEFINE_INDEX
+
+namespace test {
+
+using t_tuple = Tuple<RamDomain, 3>;
+
+TEST(SignedLexOrder, Compare) {
+    SignedLexOrder<2, 0> order;
+    const t_tuple a = {{1, 5, 3}};
+    const t_tuple b = {{2, 0, 3}};
+    const t_tuple c = {{1, 9, 3}};
+    const t_tuple d = {{7, 7, -4}};
+
+    EXPECT_EQ(-1, order(a, b));
+    EXPECT_EQ(1, order(b, a));
+    EXPECT_EQ(0, order(a, c));
+    EXPECT_EQ(1, order(a, d));
+
+    EXPECT_TRUE(order.less(a, b));
+    EXPECT_FALSE(order.less(a, c));
+    EXPECT_TRUE(order.less(d, a));
+
+    EXPECT_TRUE(order.equal(a, c));
+    EXPECT_FALSE(order.equal(a, b));
+}
+
+TEST(SignedLexOrder, Index) {
+    btree_multiset<t_tuple, SignedLexOrder<1>> index;
+    for (RamDomain i = -5; i < 5; ++i) {
+        index.insert({{i, i % 3, 0}});
+    }
+    EXPECT_EQ(10, index.size());
+
+    // tuples are ordered by the second column only
+    std::vector<RamDomain> seconds;
+    for (const auto& tuple : index) {
+        seconds.push_back(tuple[1]);
+    }
+    EXPECT_TRUE(std::is_sorted(seconds.begin(), seconds.end()));
+    EXPECT_EQ(-2, seconds.front());
+    EXPECT_EQ(2, seconds.back());
+
+    const t_tuple key = {{0, 1, 0}};
+    std::size_t matches = 0;
+    for (auto it = index.lower_bound(key); it != index.upper_bound(key); ++it) {
+        EXPECT_EQ(1, (*it)[1]);
+        ++matches;
+    }
+    EXPECT_EQ(2, matches);
+}
+
+}  // namespace test
+}  // namespace souffle
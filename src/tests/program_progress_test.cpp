@@ -0,0 +1,94 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file program_progress_test.cpp
+ *
+ * Tests the progress counters of running programs.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/ProgramProgress.h"
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace souffle::test {
+
+TEST(ProgramProgress, Counters) {
+    ProgramProgress progress;
+    progress.addRelation("edge");
+    progress.addRelation("path");
+    EXPECT_FALSE(progress.isRunning());
+
+    progress.beginEvaluation(2);
+    EXPECT_TRUE(progress.isRunning());
+    EXPECT_FALSE(progress.inStratum());
+    EXPECT_EQ(2, progress.getNumStrata());
+
+    progress.beginStratum(0);
+    progress.setRelationSize(0, 3);
+    progress.endStratum();
+
+    progress.beginStratum(1);
+    EXPECT_TRUE(progress.inStratum());
+    EXPECT_EQ(1, progress.getStratum());
+    for (int i = 0; i < 4; ++i) {
+        progress.nextIteration();
+    }
+    EXPECT_EQ(4, progress.getIteration());
+    EXPECT_EQ(1, progress.getCompletedStrata());
+    progress.setRelationSize(1, 6);
+    progress.endStratum();
+
+    EXPECT_EQ(0, progress.getIteration());
+    EXPECT_EQ(4, progress.getTotalIterations());
+    EXPECT_EQ(2, progress.getCompletedStrata());
+    EXPECT_TRUE(progress.getStratumTime() <= progress.getElapsedTime());
+
+    progress.endEvaluation();
+    EXPECT_FALSE(progress.isRunning());
+
+    const auto sizes = progress.getRelationSizes();
+    EXPECT_EQ(2, sizes.size());
+    EXPECT_EQ("edge", sizes[0].first);
+    EXPECT_EQ(3, sizes[0].second);
+    EXPECT_EQ("path", sizes[1].first);
+    EXPECT_EQ(6, sizes[1].second);
+}
+
+TEST(ProgramProgress, Dump) {
+    ProgramProgress progress;
+    progress.addRelation("edge");
+    progress.beginEvaluation(3);
+    progress.beginStratum(2);
+    progress.nextIteration();
+    progress.setRelationSize(0, 1024);
+
+    int fds[2];
+    ASSERT_TRUE(pipe(fds) == 0);
+    progress.dump(fds[1]);
+    close(fds[1]);
+
+    std::string report;
+    char buffer[256];
+    ssize_t n;
+    while ((n = read(fds[0], buffer, sizeof(buffer))) > 0) {
+        report.append(buffer, n);
+    }
+    close(fds[0]);
+
+    EXPECT_EQ(0, report.find("Progress: stratum 2, iteration 1, "));
+    EXPECT_NE(std::string::npos, report.find("0 of 3 strata completed, 1 iterations, "));
+    EXPECT_NE(std::string::npos, report.find("  edge: 1024\n"));
+}
+
+}  // namespace souffle::test
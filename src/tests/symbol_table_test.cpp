@@ -110,4 +110,49 @@ TEST(SymbolTable, Inserts) {
     }
 }
 
+TEST(SymbolTable, Order) {
+    for (int i = 0; i < RANDOM_TESTS; ++i) {
+        SymbolTable X;
+        std::vector<RamDomain> indices;
+        for (int j = 0; j < RANDOM_TEST_SIZE; ++j) {
+            indices.push_back(X.encode(random_string()));
+        }
+        X.computeOrder();
+        // symbols inserted after ranking are compared by value
+        for (int j = 0; j < RANDOM_TEST_SIZE; ++j) {
+            indices.push_back(X.encode(random_string()));
+        }
+        for (RamDomain a : indices) {
+            for (RamDomain b : indices) {
+                const int expected = X.decode(a).compare(X.decode(b));
+                EXPECT_EQ(expected < 0, X.compare(a, b) < 0);
+                EXPECT_EQ(expected == 0, X.compare(a, b) == 0);
+                EXPECT_EQ(expected > 0, X.compare(a, b) > 0);
+            }
+            EXPECT_STREQ(std::min(X.decode(a), X.decode(indices[0])),
+                    X.decode(X.minimum({a, indices[0]})));
+            EXPECT_STREQ(std::max(X.decode(a), X.decode(indices[0])),
+                    X.decode(X.maximum({a, indices[0]})));
+        }
+    }
+}
+
+TEST(SymbolTable, LazyOrder) {
+    SymbolTable X;
+    std::vector<RamDomain> indices;
+    // every load invalidates the order, which the next comparison recomputes
+    for (int load = 0; load < RANDOM_TESTS; ++load) {
+        for (int j = 0; j < RANDOM_TEST_SIZE; ++j) {
+            indices.push_back(X.encode(random_string()));
+        }
+        X.invalidateOrder();
+        for (RamDomain a : indices) {
+            const int expected = X.decode(a).compare(X.decode(indices[0]));
+            EXPECT_EQ(expected < 0, X.compare(a, indices[0]) < 0);
+            EXPECT_EQ(expected == 0, X.compare(a, indices[0]) == 0);
+            EXPECT_EQ(expected > 0, X.compare(a, indices[0]) > 0);
+        }
+    }
+}
+
 }  // namespace souffle::test
@@ -257,3 +257,10 @@ TEST(Util, Range) {
         EXPECT_EQ(last, 8);
     }
 }
+
+TEST(Util, Trim) {
+    EXPECT_EQ("a", trim("a"));
+    EXPECT_EQ("a b", trim(" \ta b\n "));
+    EXPECT_EQ("", trim(" \t"));
+    EXPECT_EQ("", trim(""));
+}
@@ -0,0 +1,135 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file driver.cpp
+ *
+ * Driver program forking an evaluated program, adding edges to the forks,
+ * and comparing their results with those of a full evaluation
+ *
+ ***********************************************************************/
+
+#include "souffle/SouffleInterface.h"
+#include <array>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace souffle;
+
+using Edge = std::array<std::string, 2>;
+using Tuples = std::set<std::vector<std::string>>;
+
+const std::vector<std::string> relations = {"edge", "path", "reach", "looped", "same"};
+
+/**
+ * Error handler
+ */
+void error(std::string txt) {
+    std::cerr << "error: " << txt << "\n";
+    exit(1);
+}
+
+Relation* getRelation(SouffleProgram& prog, const std::string& name) {
+    Relation* relation = prog.getRelation(name);
+    if (relation == nullptr) {
+        error("cannot find relation " + name);
+    }
+    return relation;
+}
+
+/** The tuples of a relation of symbols */
+Tuples getTuples(SouffleProgram& prog, const std::string& name) {
+    Relation* relation = getRelation(prog, name);
+    Tuples tuples;
+    for (auto& t : *relation) {
+        std::vector<std::string> values(relation->getArity());
+        for (auto& value : values) {
+            t >> value;
+        }
+        tuples.insert(values);
+    }
+    return tuples;
+}
+
+void insertEdges(SouffleProgram& prog, const std::set<Edge>& edges) {
+    Relation* edge = getRelation(prog, "edge");
+    for (const auto& values : edges) {
+        tuple t(edge);
+        t << values[0] << values[1];
+        edge->insert(t);
+    }
+}
+
+/** Check the relations of the program against those of a full evaluation on the given edges */
+void check(const std::string& label, SouffleProgram& prog, const std::set<Edge>& edges) {
+    Own<SouffleProgram> full(ProgramFactory::newInstance("fork_program"));
+    insertEdges(*full, edges);
+    full->run();
+
+    std::cout << label;
+    for (const std::string& name : relations) {
+        const Tuples tuples = getTuples(prog, name);
+        if (tuples != getTuples(*full, name)) {
+            error("relation " + name + " of " + label + " differs from a full evaluation");
+        }
+        std::cout << ", " << tuples.size() << " " << name;
+    }
+    std::cout << "\n";
+}
+
+/**
+ * Main program
+ */
+int main(int /* argc */, char** /* argv */) {
+    Own<SouffleProgram> base(ProgramFactory::newInstance("fork_program"));
+    if (base == nullptr) {
+        error("failed to create souffle program");
+    }
+    const std::set<Edge> baseEdges = {{"A", "B"}, {"B", "C"}, {"C", "D"}, {"E", "F"}};
+    insertEdges(*base, baseEdges);
+    base->run();
+    check("base", *base, baseEdges);
+
+    // a fork closing a cycle, with new symbols
+    Own<SouffleProgram> cycle = base->fork();
+    if (cycle == nullptr) {
+        error("failed to fork souffle program");
+    }
+    std::set<Edge> cycleEdges = baseEdges;
+    cycleEdges.insert({{"D", "A"}, {"X", "Y"}});
+    insertEdges(*cycle, {{"D", "A"}, {"X", "Y"}});
+    cycle->run();
+    check("cycle", *cycle, cycleEdges);
+    // the run of the fork leaves the relations of the base alone
+    check("base", *base, baseEdges);
+
+    // a fork connecting the components, forked before the first one is gone
+    Own<SouffleProgram> bridge = base->fork();
+    std::set<Edge> bridgeEdges = baseEdges;
+    bridgeEdges.insert({"D", "E"});
+    insertEdges(*bridge, {{"D", "E"}});
+    cycle.reset();
+    bridge->run();
+    check("bridge", *bridge, bridgeEdges);
+
+    // a fork of a fork, and the base run again on its own edges
+    Own<SouffleProgram> both = bridge->fork();
+    std::set<Edge> bothEdges = bridgeEdges;
+    bothEdges.insert({"F", "A"});
+    insertEdges(*both, {{"F", "A"}});
+    both->run();
+    check("both", *both, bothEdges);
+    check("bridge", *bridge, bridgeEdges);
+
+    base->run();
+    check("base", *base, baseEdges);
+}
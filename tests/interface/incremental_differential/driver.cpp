@@ -0,0 +1,186 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file driver.cpp
+ *
+ * Driver program retracting and re-inserting the input tuples of any
+ * incrementally evaluated program, and comparing its results after each run
+ * with those of a new instance evaluating the remaining tuples at once
+ *
+ ***********************************************************************/
+
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace souffle;
+
+/** A tuple whose symbols are given by their text and all other values by their bits */
+using Values = std::vector<std::string>;
+using Tuples = std::set<Values>;
+
+/**
+ * Error handler
+ */
+void error(std::string txt) {
+    std::cerr << "error: " << txt << "\n";
+    exit(1);
+}
+
+Own<SouffleProgram> newInstance(const std::string& name) {
+    Own<SouffleProgram> prog(ProgramFactory::newInstance(name));
+    if (prog == nullptr) {
+        error("failed to create souffle program " + name);
+    }
+    return prog;
+}
+
+/** Records and ADTs are references into the record table of an instance, and cannot be compared */
+void checkTypes(const Relation& relation) {
+    for (std::size_t i = 0; i < relation.getArity(); ++i) {
+        const char kind = *relation.getAttrType(i);
+        if (kind != 's' && kind != 'i' && kind != 'u' && kind != 'f') {
+            error("relation " + relation.getName() + " has a column of type " + relation.getAttrType(i) +
+                    ", which is not supported");
+        }
+    }
+}
+
+Tuples getTuples(Relation& relation) {
+    checkTypes(relation);
+    Tuples tuples;
+    for (auto& t : relation) {
+        Values values(relation.getArity());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            switch (*relation.getAttrType(i)) {
+                case 's': t >> values[i]; break;
+                case 'i': {
+                    RamSigned value;
+                    t >> value;
+                    values[i] = std::to_string(value);
+                    break;
+                }
+                case 'u': {
+                    RamUnsigned value;
+                    t >> value;
+                    values[i] = std::to_string(ramBitCast<RamSigned>(value));
+                    break;
+                }
+                case 'f': {
+                    RamFloat value;
+                    t >> value;
+                    values[i] = std::to_string(ramBitCast<RamSigned>(value));
+                    break;
+                }
+            }
+        }
+        tuples.insert(values);
+    }
+    return tuples;
+}
+
+tuple makeTuple(Relation* relation, const Values& values) {
+    tuple t(relation);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const char kind = *relation->getAttrType(i);
+        if (kind == 's') {
+            t << values[i];
+            continue;
+        }
+        const auto bits = static_cast<RamSigned>(std::stoll(values[i]));
+        switch (kind) {
+            case 'i': t << bits; break;
+            case 'u': t << ramBitCast<RamUnsigned>(bits); break;
+            case 'f': t << ramBitCast<RamFloat>(bits); break;
+        }
+    }
+    return t;
+}
+
+/**
+ * Main program
+ */
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        error("usage: " + std::string(argv[0]) + " <program> <fact directory>");
+    }
+    const std::string name = argv[1];
+
+    // the input tuples of the fact directory
+    Own<SouffleProgram> prog = newInstance(name);
+    prog->loadAll(argv[2]);
+    std::map<std::string, Tuples> inputs;
+    for (Relation* relation : prog->getInputRelations()) {
+        inputs[relation->getName()] = getTuples(*relation);
+    }
+
+    // the input tuples erased before each run, selected by relation and position; the last run inserts
+    // all tuples again
+    using Selection = std::function<bool(std::size_t, std::size_t)>;
+    const std::vector<std::pair<std::string, Selection>> rounds = {
+            {"load", [](std::size_t, std::size_t) { return false; }},
+            {"erase every second tuple", [](std::size_t, std::size_t i) { return i % 2 == 0; }},
+            {"insert every second tuple", [](std::size_t, std::size_t) { return false; }},
+            {"erase every third tuple", [](std::size_t, std::size_t i) { return i % 3 == 1; }},
+            {"erase the first relation", [](std::size_t r, std::size_t i) { return r == 0 || i % 3 == 1; }},
+            {"insert all tuples", [](std::size_t, std::size_t) { return false; }}};
+
+    for (std::size_t round = 0; round < rounds.size(); ++round) {
+        const auto& [description, isErased] = rounds[round];
+        std::map<std::string, Tuples> remaining;
+        std::size_t r = 0;
+        for (const auto& [relationName, tuples] : inputs) {
+            Relation* relation = prog->getRelation(relationName);
+            std::size_t i = 0;
+            for (const auto& values : tuples) {
+                if (isErased(r, i++)) {
+                    relation->erase(makeTuple(relation, values));
+                } else {
+                    relation->insert(makeTuple(relation, values));
+                    remaining[relationName].insert(values);
+                }
+            }
+            ++r;
+        }
+        prog->run();
+
+        // evaluate a new instance of the program on the remaining tuples
+        Own<SouffleProgram> full = newInstance(name);
+        for (const auto& [relationName, tuples] : remaining) {
+            Relation* relation = full->getRelation(relationName);
+            for (const auto& values : tuples) {
+                relation->insert(makeTuple(relation, values));
+            }
+        }
+        full->run();
+
+        std::cout << "round " << round + 1 << ": " << description;
+        for (Relation* relation : prog->getOutputRelations()) {
+            const Tuples tuples = getTuples(*relation);
+            if (tuples != getTuples(*full->getRelation(relation->getName()))) {
+                error("relation " + relation->getName() + " differs from a full evaluation in round " +
+                        std::to_string(round + 1));
+            }
+            std::cout << ", " << tuples.size() << " " << relation->getName();
+        }
+        std::cout << "\n";
+    }
+
+    // the results after inserting all tuples again, for comparing them with those of the program's test
+    prog->printAll(".");
+}
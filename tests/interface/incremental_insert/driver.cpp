@@ -0,0 +1,107 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file driver.cpp
+ *
+ * Driver program inserting the edges of an incrementally evaluated program
+ * between its runs, and comparing its results after each run with those of
+ * a new instance
+ *
+ ***********************************************************************/
+
+#include "souffle/SouffleInterface.h"
+#include <array>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace souffle;
+
+using Edge = std::array<RamDomain, 2>;
+using Tuples = std::set<std::vector<RamDomain>>;
+
+/**
+ * Error handler
+ */
+void error(std::string txt) {
+    std::cerr << "error: " << txt << "\n";
+    exit(1);
+}
+
+Relation* getRelation(SouffleProgram& prog, const std::string& name) {
+    Relation* relation = prog.getRelation(name);
+    if (relation == nullptr) {
+        error("cannot find relation " + name);
+    }
+    return relation;
+}
+
+/** The tuples of a relation of numbers */
+Tuples getTuples(SouffleProgram& prog, const std::string& name) {
+    Relation* relation = getRelation(prog, name);
+    Tuples tuples;
+    for (auto& t : *relation) {
+        std::vector<RamDomain> values(relation->getArity());
+        for (auto& value : values) {
+            t >> value;
+        }
+        tuples.insert(values);
+    }
+    return tuples;
+}
+
+void insertEdges(SouffleProgram& prog, const std::vector<Edge>& edges) {
+    Relation* edge = getRelation(prog, "edge");
+    for (const auto& values : edges) {
+        tuple t(edge);
+        t << values[0] << values[1];
+        edge->insert(t);
+    }
+}
+
+/**
+ * Main program
+ */
+int main(int /* argc */, char** /* argv */) {
+    Own<SouffleProgram> prog(ProgramFactory::newInstance("incremental_insert"));
+    if (prog == nullptr) {
+        error("failed to create souffle program");
+    }
+
+    // the edges inserted before each run; the edges of the fact file must not be loaded by a run
+    const std::vector<std::vector<Edge>> rounds = {{{1, 2}, {2, 3}}, {{3, 4}}, {{4, 1}, {5, 6}}};
+
+    std::vector<Edge> edges;
+    for (std::size_t round = 0; round < rounds.size(); ++round) {
+        insertEdges(*prog, rounds[round]);
+        prog->run();
+        edges.insert(edges.end(), rounds[round].begin(), rounds[round].end());
+
+        // evaluate a new instance of the program on the same edges
+        Own<SouffleProgram> full(ProgramFactory::newInstance("incremental_insert"));
+        insertEdges(*full, edges);
+        full->run();
+
+        std::cout << "round " << round + 1 << ":";
+        const char* separator = " ";
+        for (const std::string name : {"edge", "path", "reach"}) {
+            const Tuples tuples = getTuples(*prog, name);
+            if (tuples != getTuples(*full, name)) {
+                error("relation " + name + " differs from a new instance in round " +
+                        std::to_string(round + 1));
+            }
+            std::cout << separator << tuples.size() << " " << name;
+            separator = ", ";
+        }
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file driver.cpp
+ *
+ * Driver program inserting and erasing the edges of an incrementally
+ * evaluated program, and comparing its results after each run with those
+ * of a full evaluation
+ *
+ ***********************************************************************/
+
+#include "souffle/SouffleInterface.h"
+#include <array>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace souffle;
+
+using Edge = std::array<std::string, 2>;
+using Tuples = std::set<std::vector<std::string>>;
+
+/**
+ * Error handler
+ */
+void error(std::string txt) {
+    std::cerr << "error: " << txt << "\n";
+    exit(1);
+}
+
+Relation* getRelation(SouffleProgram& prog, const std::string& name) {
+    Relation* relation = prog.getRelation(name);
+    if (relation == nullptr) {
+        error("cannot find relation " + name);
+    }
+    return relation;
+}
+
+/** The tuples of a relation of symbols */
+Tuples getTuples(SouffleProgram& prog, const std::string& name) {
+    Relation* relation = getRelation(prog, name);
+    Tuples tuples;
+    for (auto& t : *relation) {
+        std::vector<std::string> values(relation->getArity());
+        for (auto& value : values) {
+            t >> value;
+        }
+        tuples.insert(values);
+    }
+    return tuples;
+}
+
+tuple makeEdge(Relation* edge, const Edge& values) {
+    tuple t(edge);
+    t << values[0] << values[1];
+    return t;
+}
+
+/**
+ * Main program
+ */
+int main(int /* argc */, char** /* argv */) {
+    Own<SouffleProgram> prog(ProgramFactory::newInstance("incremental_retract"));
+    if (prog == nullptr) {
+        error("failed to create souffle program");
+    }
+    Relation* edge = getRelation(*prog, "edge");
+
+    // the edges inserted and erased before each run
+    const std::vector<std::pair<std::vector<Edge>, std::vector<Edge>>> rounds = {
+            {{{"A", "B"}, {"B", "C"}, {"C", "A"}, {"C", "D"}, {"D", "E"}, {"E", "F"}}, {}},
+            {{{"F", "G"}}, {{"C", "A"}}},
+            {{{"D", "A"}}, {{"D", "E"}, {"X", "Y"}}},
+            {{{"B", "A"}}, {{"A", "B"}, {"B", "C"}}},
+            {{}, {{"C", "D"}, {"D", "A"}, {"E", "F"}, {"F", "G"}, {"B", "A"}}},
+            {{{"A", "B"}, {"B", "A"}}, {}}};
+
+    std::set<Edge> edges;
+    for (std::size_t round = 0; round < rounds.size(); ++round) {
+        const auto& [insertions, erasures] = rounds[round];
+        for (const auto& values : insertions) {
+            edge->insert(makeEdge(edge, values));
+            edges.insert(values);
+        }
+        std::size_t erased = 0;
+        for (const auto& values : erasures) {
+            erased += edge->erase(makeEdge(edge, values)) ? 1 : 0;
+            edges.erase(values);
+        }
+        prog->run();
+
+        // evaluate a new instance of the program on the same edges
+        Own<SouffleProgram> full(ProgramFactory::newInstance("incremental_retract"));
+        Relation* fullEdge = getRelation(*full, "edge");
+        for (const auto& values : edges) {
+            fullEdge->insert(makeEdge(fullEdge, values));
+        }
+        full->run();
+
+        std::cout << "round " << round + 1 << ": erased " << erased << " of " << erasures.size() << " edges";
+        for (const std::string name : {"edge", "path", "reach", "looped", "triangle"}) {
+            const Tuples tuples = getTuples(*prog, name);
+            if (tuples != getTuples(*full, name)) {
+                error("relation " + name + " differs from a full evaluation in round " +
+                        std::to_string(round + 1));
+            }
+            std::cout << ", " << tuples.size() << " " << name;
+        }
+        std::cout << "\n";
+    }
+}